@@ -0,0 +1,47 @@
+-- events
+events = {
+    handlers = {}
+}
+
+-- Handlers list of an event is never replaced once created: the engine
+-- keeps references to block and item events lists to call the only
+-- handler directly
+local function clear_handlers(handlers)
+    for i = #handlers, 1, -1 do
+        handlers[i] = nil
+    end
+end
+
+function events.on(event, func)
+    -- why an array? length is always = 1
+    -- FIXME: temporary fixed
+    local handlers = events.handlers[event]
+    if handlers == nil then
+        handlers = {}
+        events.handlers[event] = handlers
+    end
+    clear_handlers(handlers) -- previous handler is replaced
+    table.insert(handlers, func)
+end
+
+function events.remove_by_prefix(prefix)
+    for name, handlers in pairs(events.handlers) do
+        if name:sub(1, #prefix) == prefix then
+            clear_handlers(handlers)
+        end
+    end
+end
+
+function pack.unload(prefix)
+    events.remove_by_prefix(prefix)
+end
+
+function events.emit(event, ...)
+    result = nil
+    if events.handlers[event] then
+        for _, func in ipairs(events.handlers[event]) do
+            result = result or func(...)
+        end
+    end
+    return result
+end
@@ -149,3 +149,101 @@ console.add_command(
         end
     end
 )
+
+console.add_command(
+    "profiler.start trace:int=0",
+    "Start scripts profiling (trace=1 to record timeline for export)",
+    function(args, kwargs)
+        profiler.start(args[1] ~= 0)
+        return "profiler started"
+    end
+)
+
+console.add_command(
+    "profiler.stop",
+    "Stop scripts profiling",
+    function()
+        profiler.stop()
+        return "profiler stopped"
+    end
+)
+
+console.add_command(
+    "profiler.reset",
+    "Clear scripts profiling results",
+    function()
+        profiler.reset()
+        return "profiler results cleared"
+    end
+)
+
+console.add_command(
+    "profiler.show count:int=10",
+    "Show packs and callbacks taking the most time",
+    function(args, kwargs)
+        local entries = profiler.get_entries()
+        local packs = {}
+        local packnames = {}
+        for _, entry in ipairs(entries) do
+            local pack = packs[entry.pack]
+            if pack == nil then
+                pack = {name=entry.pack, calls=0, time=0, allocated=0}
+                packs[entry.pack] = pack
+                table.insert(packnames, entry.pack)
+            end
+            pack.calls = pack.calls + entry.calls
+            pack.time = pack.time + entry.time
+            pack.allocated = pack.allocated + entry.allocated
+        end
+        table.sort(packnames, function(a, b)
+            return packs[a].time > packs[b].time
+        end)
+
+        local format = "%-40s %8s %12s %10s %10s"
+        local str = string.format(
+            format, "name", "calls", "total ms", "max ms", "alloc KB"
+        )
+        for _, name in ipairs(packnames) do
+            local pack = packs[name]
+            str = str .. "\n" .. string.format(
+                format, name, pack.calls, string.format("%.3f", pack.time*1e3),
+                "", string.format("%.1f", pack.allocated/1024)
+            )
+        end
+        str = str .. "\n" .. SEPARATOR
+        for i = 1, math.min(args[1], #entries) do
+            local entry = entries[i]
+            str = str .. "\n" .. string.format(
+                format, entry.name, entry.calls,
+                string.format("%.3f", entry.time*1e3),
+                string.format("%.3f", entry.max_time*1e3),
+                string.format("%.1f", entry.allocated/1024)
+            )
+        end
+        return str
+    end
+)
+
+console.add_command(
+    "profiler.export path:str='user:profile.json'",
+    "Export recorded timeline as Chrome trace",
+    function(args, kwargs)
+        local count = profiler.export(args[1])
+        return tostring(count) .. " events written to " .. args[1]
+    end
+)
+
+console.add_command(
+    "profiler.gc",
+    "Show Lua garbage collector statistics",
+    function()
+        local stats = profiler.get_gc_stats()
+        return string.format(
+            "heap: %.1f KB (peak %.1f KB)\n"..
+            "cycles: %d\n"..
+            "step pause: %.3f ms (max %.3f ms, total %.3f s)",
+            stats.heap_size/1024, stats.peak_heap_size/1024, stats.cycles,
+            stats.last_pause*1e3, stats.max_pause*1e3, stats.total_time
+        )
+    end
+)
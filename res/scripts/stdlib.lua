@@ -101,40 +101,6 @@ function pack.data_file(packid, name)
     return "world:data/"..packid.."/"..name
 end
 
--- events
-events = {
-    handlers = {}
-}
-
-function events.on(event, func)
-    -- why an array? length is always = 1
-    -- FIXME: temporary fixed
-    events.handlers[event] = {} -- events.handlers[event] or {}
-    table.insert(events.handlers[event], func)
-end
-
-function events.remove_by_prefix(prefix)
-    for name, handlers in pairs(events.handlers) do
-        if name:sub(1, #prefix) == prefix then
-            events.handlers[name] = nil
-        end
-    end
-end
-
-function pack.unload(prefix)
-    events.remove_by_prefix(prefix)
-end
-
-function events.emit(event, ...)
-    result = nil
-    if events.handlers[event] then
-        for _, func in ipairs(events.handlers[event]) do
-            result = result or func(...)
-        end
-    end
-    return result
-end
-
 -- class designed for simple UI-nodes access via properties syntax
 local Element = {}
 function Element.new(docname, name)
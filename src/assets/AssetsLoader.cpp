@@ -269,6 +269,14 @@ const ResPaths* AssetsLoader::getPaths() const {
     return paths;
 }
 
+void AssetsLoader::setCacheFolder(std::filesystem::path folder) {
+    cacheFolder = std::move(folder);
+}
+
+const std::filesystem::path& AssetsLoader::getCacheFolder() const {
+    return cacheFolder;
+}
+
 class LoaderWorker : public util::Worker<aloader_entry, assetload::postfunc> {
     AssetsLoader* loader;
 public:
@@ -57,6 +57,7 @@ class AssetsLoader {
     std::map<AssetType, aloader_func> loaders;
     std::queue<aloader_entry> entries;
     const ResPaths* paths;
+    std::filesystem::path cacheFolder;
 
     void tryAddSound(const std::string& name);
 
@@ -90,6 +91,11 @@ public:
     std::shared_ptr<Task> startTask(runnable onDone);
 
     const ResPaths* getPaths() const;
+
+    /// @brief Set folder used by loaders to store baked assets
+    /// (caching is disabled if empty)
+    void setCacheFolder(std::filesystem::path folder);
+    const std::filesystem::path& getCacheFolder() const;
     aloader_func getLoader(AssetType tag);
 
     /// @brief Enqueue core and content assets
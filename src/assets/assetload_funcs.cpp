@@ -1,5 +1,6 @@
 #include "assetload_funcs.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 #include <stdexcept>
@@ -24,8 +25,10 @@
 #include "graphics/core/Texture.hpp"
 #include "graphics/core/TextureAnimation.hpp"
 #include "objects/rigging.hpp"
+#include "util/ParallelWorkers.hpp"
 #include "Assets.hpp"
 #include "AssetsLoader.hpp"
+#include "atlas_cache.hpp"
 
 static debug::Logger logger("assetload-funcs");
 
@@ -87,15 +90,71 @@ static bool append_atlas(AtlasBuilder& atlas, const fs::path& file) {
     return true;
 }
 
-assetload::postfunc assetload::
-    atlas(AssetsLoader*, const ResPaths* paths, const std::string& directory, const std::string& name, const std::shared_ptr<AssetCfg>&) {
+static std::unique_ptr<Atlas> build_atlas(
+    const std::vector<fs::path>& files,
+    uint extrusion,
+    uint maxResolution,
+    AtlasPacker packer
+) {
+    util::ParallelWorkers workers;
+    std::vector<std::unique_ptr<ImageData>> images(files.size());
+    workers.run(files.size(), [&](size_t begin, size_t end, uint) {
+        for (size_t i = begin; i < end; i++) {
+            images[i] = imageio::read(files[i].string());
+            images[i]->fixAlphaColor();
+        }
+    });
+    // images are added in the files order, so the result is the same
+    // as of sequential decoding
     AtlasBuilder builder;
+    builder.setPacker(packer);
+    for (size_t i = 0; i < files.size(); i++) {
+        builder.add(files[i].stem().string(), std::move(images[i]));
+    }
+    return builder.build(extrusion, false, maxResolution, &workers);
+}
+
+assetload::postfunc assetload::
+    atlas(AssetsLoader* loader, const ResPaths* paths, const std::string& directory, const std::string& name, const std::shared_ptr<AssetCfg>&) {
+    const uint extrusion = 2;
+    // depends on the GL context, so cache baked with another limit is not used
+    const uint maxResolution = Texture::MAX_RESOLUTION;
+    const auto packer = AtlasPacker::skyline;
+    std::set<std::string> names;
+    std::vector<fs::path> files;
     for (const auto& file : paths->listdir(directory)) {
         if (!imageio::is_read_supported(file.extension().u8string())) continue;
-        if (!append_atlas(builder, file)) continue;
+        // skip duplicates
+        if (!names.insert(file.stem().string()).second) continue;
+        files.push_back(file);
+    }
+    std::unique_ptr<Atlas> baked;
+    const auto& cacheFolder = loader->getCacheFolder();
+    if (cacheFolder.empty()) {
+        baked = build_atlas(files, extrusion, maxResolution, packer);
+    } else {
+        std::string filename = name;
+        std::replace_if(filename.begin(), filename.end(), [](char c) {
+            return c == ':' || c == '/' || c == '\\';
+        }, '_');
+        auto cacheFile = cacheFolder / fs::u8path(filename + ".atlas");
+        auto key = atlas_cache::compute_key(
+            files, extrusion, maxResolution, packer
+        );
+        baked = atlas_cache::read(cacheFile, key);
+        if (baked == nullptr) {
+            baked = build_atlas(files, extrusion, maxResolution, packer);
+            if (!atlas_cache::write(cacheFile, key, *baked)) {
+                logger.warning() << "could not write atlas cache "
+                                 << cacheFile.u8string();
+            }
+        } else {
+            logger.info() << "atlas '" << name << "' loaded from cache";
+        }
     }
-    std::set<std::string> names = builder.getNames();
-    Atlas* atlas = builder.build(2, false).release();
+    // mip level is prepared here to not compute it on the GL thread
+    baked->setMipmap(baked->getImage()->downsample());
+    Atlas* atlas = baked.release();
     return [=](auto assets) {
         atlas->prepare();
         assets->store(std::unique_ptr<Atlas>(atlas), name);
@@ -0,0 +1,206 @@
+#include "atlas_cache.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "coders/byte_utils.hpp"
+#include "coders/gzip.hpp"
+#include "debug/Logger.hpp"
+#include "files/files.hpp"
+#include "graphics/core/Atlas.hpp"
+#include "graphics/core/ImageData.hpp"
+#include "graphics/core/Texture.hpp"
+
+namespace fs = std::filesystem;
+
+static debug::Logger logger("atlas-cache");
+
+static const char MAGIC[] = ".VEATLAS";
+static constexpr size_t MAGIC_SIZE = sizeof(MAGIC) - 1;
+/// @brief Must be increased on any change of the format or of the atlas
+/// baking pipeline (images preprocessing, packing, extrusion)
+static constexpr int32_t FORMAT_VERSION = 2;
+/// @brief Deflate does not compress data more than 1032 times
+static constexpr size_t MAX_DEFLATE_RATIO = 1032;
+
+static constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+static constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+static void hash_bytes(uint64_t& hash, const void* data, size_t size) {
+    auto bytes = reinterpret_cast<const ubyte*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+}
+
+template <typename T>
+static void hash_value(uint64_t& hash, T value) {
+    hash_bytes(hash, &value, sizeof(T));
+}
+
+uint64_t atlas_cache::compute_key(
+    const std::vector<fs::path>& files,
+    uint extrusion,
+    uint maxResolution,
+    AtlasPacker packer
+) {
+    uint64_t hash = FNV_OFFSET;
+    hash_value(hash, FORMAT_VERSION);
+    hash_value(hash, extrusion);
+    hash_value(hash, maxResolution);
+    hash_value(hash, static_cast<int>(packer));
+    hash_value(hash, files.size());
+    for (const auto& file : files) {
+        std::string name = file.u8string();
+        hash_bytes(hash, name.data(), name.length() + 1);
+
+        std::error_code ec;
+        auto size = fs::file_size(file, ec);
+        hash_value(hash, ec ? static_cast<uintmax_t>(-1) : size);
+        auto time = fs::last_write_time(file, ec);
+        hash_value(hash, ec ? 0 : time.time_since_epoch().count());
+    }
+    return hash;
+}
+
+static std::unique_ptr<Atlas> read_atlas(const ubyte* src, size_t size) {
+    ByteReader reader(src, size);
+    reader.checkMagic(MAGIC, MAGIC_SIZE);
+    reader.skip(sizeof(int32_t) + sizeof(int64_t));  // version, key
+
+    auto format = static_cast<ImageFormat>(reader.getInt32());
+    uint width = reader.getInt32();
+    uint height = reader.getInt32();
+    if (format != ImageFormat::rgba8888 && format != ImageFormat::rgb888) {
+        throw std::runtime_error("invalid image format");
+    }
+    if (width == 0 || height == 0 || width > Texture::MAX_RESOLUTION ||
+        height > Texture::MAX_RESOLUTION) {
+        throw std::runtime_error("invalid image size");
+    }
+    std::unordered_map<std::string, UVRegion> regions;
+    uint count = reader.getInt32();
+    for (uint i = 0; i < count; i++) {
+        std::string name = reader.getString();
+        float u1 = reader.getFloat32();
+        float v1 = reader.getFloat32();
+        float u2 = reader.getFloat32();
+        float v2 = reader.getFloat32();
+        regions[name] = UVRegion(u1, v1, u2, v2);
+    }
+
+    uint channels = format == ImageFormat::rgba8888 ? 4 : 3;
+    size_t length = static_cast<size_t>(width) * height * channels;
+    size_t compressedSize = size - (reader.pointer() - src);
+    if (length > compressedSize * MAX_DEFLATE_RATIO) {
+        throw std::runtime_error("incomplete image data");
+    }
+    auto image = std::make_unique<ImageData>(format, width, height);
+    ubyte* dst = image->getData();
+    size_t written = 0;
+    gzip::Decoder decoder([&](const ubyte* data, size_t size) {
+        if (written + size > length) {
+            throw std::runtime_error("image data overflow");
+        }
+        std::memcpy(dst + written, data, size);
+        written += size;
+    });
+    decoder.write(reader.pointer(), compressedSize);
+    decoder.finish();
+    if (written != length) {
+        throw std::runtime_error("incomplete image data");
+    }
+    return std::make_unique<Atlas>(std::move(image), std::move(regions), false);
+}
+
+std::unique_ptr<Atlas> atlas_cache::read(const fs::path& file, uint64_t key) {
+    if (!fs::is_regular_file(file)) {
+        return nullptr;
+    }
+    try {
+        auto bytes = files::read_bytes(file);
+        ByteReader reader(bytes.data(), bytes.size());
+        reader.checkMagic(MAGIC, MAGIC_SIZE);
+        if (reader.getInt32() != FORMAT_VERSION ||
+            static_cast<uint64_t>(reader.getInt64()) != key) {
+            return nullptr;
+        }
+        return read_atlas(bytes.data(), bytes.size());
+    } catch (const std::exception& err) {
+        logger.warning() << "damaged atlas cache " << file.u8string() << ": "
+                         << err.what();
+        return nullptr;
+    }
+}
+
+bool atlas_cache::write(
+    const fs::path& file, uint64_t key, const Atlas& atlas
+) {
+    const auto& image = *atlas.getImage();
+    const auto& regions = atlas.getRegions();
+
+    ByteBuilder builder;
+    builder.put(reinterpret_cast<const ubyte*>(MAGIC), MAGIC_SIZE);
+    builder.putInt32(FORMAT_VERSION);
+    builder.putInt64(static_cast<int64_t>(key));
+    builder.putInt32(static_cast<int32_t>(image.getFormat()));
+    builder.putInt32(image.getWidth());
+    builder.putInt32(image.getHeight());
+
+    // sorted to make output independent of the map iteration order
+    std::vector<const std::string*> names;
+    names.reserve(regions.size());
+    for (const auto& [name, _] : regions) {
+        names.push_back(&name);
+    }
+    std::sort(names.begin(), names.end(), [](auto a, auto b) {
+        return *a < *b;
+    });
+    builder.putInt32(names.size());
+    for (const auto name : names) {
+        const auto& region = regions.at(*name);
+        builder.put(*name);
+        builder.putFloat32(region.u1);
+        builder.putFloat32(region.v1);
+        builder.putFloat32(region.u2);
+        builder.putFloat32(region.v2);
+    }
+
+    // written to temporary file first to never leave partial cache file
+    fs::path tmpfile = file;
+    tmpfile += ".tmp";
+    {
+        std::ofstream output(tmpfile, std::ios::binary);
+        if (!output.is_open()) {
+            return false;
+        }
+        output.write(
+            reinterpret_cast<const char*>(builder.data()), builder.size()
+        );
+        gzip::Encoder encoder(
+            [&output](const ubyte* data, size_t size) {
+                output.write(reinterpret_cast<const char*>(data), size);
+            },
+            gzip::BEST_SPEED
+        );
+        uint channels = image.getFormat() == ImageFormat::rgba8888 ? 4 : 3;
+        encoder.write(
+            image.getData(),
+            static_cast<size_t>(image.getWidth()) * image.getHeight() *
+                channels
+        );
+        encoder.finish();
+        if (!output.good()) {
+            output.close();
+            fs::remove(tmpfile);
+            return false;
+        }
+    }
+    std::error_code ec;
+    fs::rename(tmpfile, file, ec);
+    return !ec;
+}
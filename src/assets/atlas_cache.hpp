@@ -0,0 +1,45 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "typedefs.hpp"
+
+class Atlas;
+enum class AtlasPacker;
+
+/// @brief Baked atlases storage. Packed atlas image and its regions are
+/// stored on disk to skip decoding and packing of unchanged textures
+namespace atlas_cache {
+    /// @brief Compute cache key of an atlas
+    /// @param files source images in order of adding to the builder
+    /// @param extrusion textures extrusion pixels
+    /// @param maxResolution max atlas resolution
+    /// @param packer packing algorithm
+    /// @return hash of the files list, sizes, modification times and
+    /// packer parameters
+    uint64_t compute_key(
+        const std::vector<std::filesystem::path>& files,
+        uint extrusion,
+        uint maxResolution,
+        AtlasPacker packer
+    );
+
+    /// @brief Read baked atlas (texture is not prepared)
+    /// @param file cache file
+    /// @param key expected cache key
+    /// @return nullptr if file does not exist, is outdated or damaged
+    std::unique_ptr<Atlas> read(
+        const std::filesystem::path& file, uint64_t key
+    );
+
+    /// @brief Write baked atlas
+    /// @param file cache file
+    /// @param key cache key
+    /// @param atlas baked atlas with image available
+    /// @return false if writing failed
+    bool write(
+        const std::filesystem::path& file, uint64_t key, const Atlas& atlas
+    );
+}
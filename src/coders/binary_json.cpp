@@ -1,5 +1,6 @@
 #include "binary_json.hpp"
 
+#include <cstring>
 #include <stdexcept>
 
 #include "data/dynamic.hpp"
@@ -9,19 +10,74 @@
 using namespace json;
 using namespace dynamic;
 
-static void to_binary(ByteBuilder& builder, const Value& value) {
+/// @brief Buffered bytes are passed to the stream consumer when exceeding
+/// this size
+inline constexpr size_t STREAM_CHUNK_SIZE = 64 * 1024;
+
+/// @brief Streaming output. Documents sizes are computed before writing,
+/// so the output buffer may be flushed before a document end
+struct BinaryStream {
+    /// @brief documents sizes in the order of writing
+    const uint32_t* sizes;
+    const std::function<void(const ubyte* data, size_t size)>& consumer;
+
+    void flush(ByteBuilder& builder) {
+        if (builder.size()) {
+            consumer(builder.data(), builder.size());
+            builder.clear();
+        }
+    }
+};
+
+static void to_binary(
+    ByteBuilder& builder, const Value& value, BinaryStream* stream
+);
+
+/// @brief Write document into the output buffer. Size field is reserved
+/// and patched when document end is written, so nested documents are not
+/// copied. Precomputed size is written instead when streaming
+static void object_to_binary(
+    ByteBuilder& builder, const Map* obj, BinaryStream* stream = nullptr
+) {
+    size_t start = builder.size();
+    // type byte
+    builder.put(BJSON_TYPE_DOCUMENT);
+    // document size
+    builder.putInt32(stream ? *stream->sizes++ : 0);
+
+    // writing entries
+    for (auto& entry : obj->values) {
+        builder.putCStr(entry.first.c_str());
+        to_binary(builder, entry.second, stream);
+        if (stream && builder.size() >= STREAM_CHUNK_SIZE) {
+            stream->flush(builder);
+        }
+    }
+    // terminating byte
+    builder.put(BJSON_END);
+
+    if (stream == nullptr) {
+        // updating document size
+        builder.setInt32(start + 1, builder.size() - start);
+    }
+}
+
+static void to_binary(
+    ByteBuilder& builder, const Value& value, BinaryStream* stream
+) {
     switch (static_cast<Type>(value.index())) {
         case Type::none:
             throw std::runtime_error("none value is not implemented");
-        case Type::map: {
-            auto bytes = to_binary(std::get<Map_sptr>(value).get());
-            builder.put(bytes.data(), bytes.size());
+        case Type::map:
+            object_to_binary(builder, std::get<Map_sptr>(value).get(), stream);
             break;
-        }
         case Type::list:
             builder.put(BJSON_TYPE_LIST);
             for (auto& element : std::get<List_sptr>(value)->values) {
-                to_binary(builder, element);
+                to_binary(builder, element, stream);
+                if (stream && builder.size() >= STREAM_CHUNK_SIZE) {
+                    stream->flush(builder);
+                }
             }
             builder.put(BJSON_END);
             break;
@@ -56,31 +112,95 @@ static void to_binary(ByteBuilder& builder, const Value& value) {
     }
 }
 
+static size_t binary_size(const Value& value, std::vector<uint32_t>& sizes);
+
+/// @brief Calculate encoded document size. Sizes of the document and
+/// nested documents are appended in the order of writing
+static size_t object_binary_size(
+    const Map* obj, std::vector<uint32_t>& sizes
+) {
+    size_t index = sizes.size();
+    sizes.push_back(0);
+    // type byte, size and terminating byte
+    size_t size = 1 + 4 + 1;
+    for (auto& entry : obj->values) {
+        size += std::strlen(entry.first.c_str()) + 1;
+        size += binary_size(entry.second, sizes);
+    }
+    sizes[index] = size;
+    return size;
+}
+
+static size_t binary_size(const Value& value, std::vector<uint32_t>& sizes) {
+    switch (static_cast<Type>(value.index())) {
+        case Type::none:
+            throw std::runtime_error("none value is not implemented");
+        case Type::map:
+            return object_binary_size(std::get<Map_sptr>(value).get(), sizes);
+        case Type::list: {
+            size_t size = 1 + 1;
+            for (auto& element : std::get<List_sptr>(value)->values) {
+                size += binary_size(element, sizes);
+            }
+            return size;
+        }
+        case Type::integer: {
+            auto val = std::get<integer_t>(value);
+            if (val >= 0 && val <= 255) {
+                return 1 + 1;
+            } else if (val >= INT16_MIN && val <= INT16_MAX) {
+                return 1 + 2;
+            } else if (val >= INT32_MIN && val <= INT32_MAX) {
+                return 1 + 4;
+            }
+            return 1 + 8;
+        }
+        case Type::number:
+            return 1 + 8;
+        case Type::boolean:
+            return 1;
+        case Type::string:
+            return 1 + 4 + std::get<std::string>(value).length();
+    }
+    return 0;
+}
+
 static std::unique_ptr<List> array_from_binary(ByteReader& reader);
 static std::unique_ptr<Map> object_from_binary(ByteReader& reader);
 
 std::vector<ubyte> json::to_binary(const Map* obj, bool compress) {
     if (compress) {
-        auto bytes = to_binary(obj, false);
-        return gzip::compress(bytes.data(), bytes.size());
+        // uncompressed document is not buffered whole
+        std::vector<ubyte> bytes;
+        gzip::Encoder encoder([&bytes](const ubyte* data, size_t size) {
+            bytes.insert(bytes.end(), data, data + size);
+        });
+        write_binary(obj, [&encoder](const ubyte* data, size_t size) {
+            encoder.write(data, size);
+        });
+        encoder.finish();
+        return bytes;
     }
     ByteBuilder builder;
-    // type byte
-    builder.put(BJSON_TYPE_DOCUMENT);
-    // document size
-    builder.putInt32(0);
+    object_to_binary(builder, obj);
+    return builder.build();
+}
 
-    // writing entries
-    for (auto& entry : obj->values) {
-        builder.putCStr(entry.first.c_str());
-        to_binary(builder, entry.second);
-    }
-    // terminating byte
-    builder.put(BJSON_END);
+void json::write_binary(ByteBuilder& builder, const Map* obj) {
+    object_to_binary(builder, obj);
+}
 
-    // updating document size
-    builder.setInt32(1, builder.size());
-    return builder.build();
+void json::write_binary(
+    const Map* obj,
+    const std::function<void(const ubyte* data, size_t size)>& consumer
+) {
+    std::vector<uint32_t> sizes;
+    object_binary_size(obj, sizes);
+
+    ByteBuilder builder;
+    BinaryStream stream {sizes.data(), consumer};
+    object_to_binary(builder, obj, &stream);
+    stream.flush(builder);
 }
 
 std::vector<ubyte> json::to_binary(const Value& value, bool compress) {
@@ -158,3 +278,287 @@ std::shared_ptr<Map> json::from_binary(const ubyte* src, size_t size) {
         }
     }
 }
+
+BinaryView::BinaryView(const ubyte* ptr, const ubyte* end)
+    : ptr(ptr), end(end) {
+    if (ptr >= end) {
+        throw std::runtime_error("buffer underflow");
+    }
+}
+
+const ubyte* BinaryView::next() const {
+    size_t available = end - ptr;
+    size_t size;
+    switch (*ptr) {
+        case BJSON_TYPE_DOCUMENT: {
+            // document size includes the type byte
+            size = ByteReader(ptr + 1, available - 1).getInt32();
+            if (size < 6) {
+                throw std::runtime_error("invalid document size");
+            }
+            break;
+        }
+        case BJSON_TYPE_LIST: {
+            const ubyte* pos = ptr + 1;
+            while (pos < end && *pos != BJSON_END) {
+                pos = BinaryView(pos, end).next();
+            }
+            if (pos >= end) {
+                throw std::runtime_error("buffer underflow");
+            }
+            return pos + 1;
+        }
+        case BJSON_TYPE_BYTE:
+            size = 2;
+            break;
+        case BJSON_TYPE_INT16:
+            size = 3;
+            break;
+        case BJSON_TYPE_INT32:
+            size = 5;
+            break;
+        case BJSON_TYPE_INT64:
+        case BJSON_TYPE_NUMBER:
+            size = 9;
+            break;
+        case BJSON_TYPE_STRING:
+        case BJSON_TYPE_BYTES:
+            size = 5 + static_cast<uint32_t>(
+                           ByteReader(ptr + 1, available - 1).getInt32()
+                       );
+            break;
+        case BJSON_TYPE_FALSE:
+        case BJSON_TYPE_TRUE:
+        case BJSON_TYPE_NULL:
+            size = 1;
+            break;
+        default:
+            throw std::runtime_error(
+                "type " + std::to_string(*ptr) + " is not supported"
+            );
+    }
+    if (size > available) {
+        throw std::runtime_error("buffer underflow");
+    }
+    return ptr + size;
+}
+
+integer_t BinaryView::asInteger() const {
+    ByteReader reader(ptr + 1, end - ptr - 1);
+    switch (*ptr) {
+        case BJSON_TYPE_BYTE:
+            return reader.get();
+        case BJSON_TYPE_INT16:
+            return reader.getInt16();
+        case BJSON_TYPE_INT32:
+            return reader.getInt32();
+        case BJSON_TYPE_INT64:
+            return reader.getInt64();
+        case BJSON_TYPE_NUMBER:
+            return reader.getFloat64();
+        case BJSON_TYPE_FALSE:
+        case BJSON_TYPE_TRUE:
+            return *ptr - BJSON_TYPE_FALSE;
+        default:
+            throw std::runtime_error("type error");
+    }
+}
+
+number_t BinaryView::asNumber() const {
+    if (*ptr == BJSON_TYPE_NUMBER) {
+        return ByteReader(ptr + 1, end - ptr - 1).getFloat64();
+    }
+    return asInteger();
+}
+
+bool BinaryView::asBoolean() const {
+    switch (*ptr) {
+        case BJSON_TYPE_FALSE:
+        case BJSON_TYPE_TRUE:
+            return *ptr - BJSON_TYPE_FALSE;
+        case BJSON_TYPE_NUMBER:
+            throw std::runtime_error("type error");
+        default:
+            return asInteger();
+    }
+}
+
+std::string_view BinaryView::asString() const {
+    if (*ptr != BJSON_TYPE_STRING) {
+        throw std::runtime_error("type error");
+    }
+    return ByteReader(ptr + 1, end - ptr - 1).getStringView();
+}
+
+BinaryMapView BinaryView::asMap() const {
+    return BinaryMapView(*this);
+}
+
+BinaryListView BinaryView::asList() const {
+    return BinaryListView(*this);
+}
+
+Value BinaryView::toValue() const {
+    ByteReader reader(ptr, next() - ptr);
+    return value_from_binary(reader);
+}
+
+BinaryMapView::BinaryMapView(BinaryView view) {
+    if (view && view.getType() == BJSON_TYPE_DOCUMENT) {
+        // view is limited by the document size
+        this->view = BinaryView(view.ptr, view.next());
+    }
+}
+
+const ubyte* BinaryMapView::entries() const {
+    // type byte and document size
+    return view ? view.ptr + 5 : nullptr;
+}
+
+bool BinaryMapView::nextEntry(
+    const ubyte*& pos, std::string_view& key, BinaryView& value
+) const {
+    if (pos == nullptr || pos >= view.end || *pos == BJSON_END) {
+        return false;
+    }
+    auto keyEnd = static_cast<const ubyte*>(
+        std::memchr(pos, 0, view.end - pos)
+    );
+    if (keyEnd == nullptr) {
+        throw std::runtime_error("buffer underflow");
+    }
+    key = std::string_view(
+        reinterpret_cast<const char*>(pos), keyEnd - pos
+    );
+    value = BinaryView(keyEnd + 1, view.end);
+    pos = value.next();
+    return true;
+}
+
+BinaryView BinaryMapView::find(std::string_view key) const {
+    const ubyte* pos = entries();
+    std::string_view entryKey;
+    BinaryView value;
+    while (nextEntry(pos, entryKey, value)) {
+        if (entryKey == key) {
+            return value;
+        }
+    }
+    return BinaryView();
+}
+
+std::string BinaryMapView::get(
+    std::string_view key, const std::string& def
+) const {
+    auto found = find(key);
+    if (!found) {
+        return def;
+    }
+    switch (found.getType()) {
+        case BJSON_TYPE_STRING:
+            return std::string(found.asString());
+        case BJSON_TYPE_FALSE:
+        case BJSON_TYPE_TRUE:
+            return found.asBoolean() ? "true" : "false";
+        case BJSON_TYPE_NUMBER:
+            return std::to_string(found.asNumber());
+        default:
+            return std::to_string(found.asInteger());
+    }
+}
+
+number_t BinaryMapView::get(std::string_view key, double def) const {
+    auto found = find(key);
+    return found ? found.asNumber() : def;
+}
+
+integer_t BinaryMapView::get(std::string_view key, integer_t def) const {
+    auto found = find(key);
+    return found ? found.asInteger() : def;
+}
+
+bool BinaryMapView::get(std::string_view key, bool def) const {
+    auto found = find(key);
+    return found ? found.asBoolean() : def;
+}
+
+BinaryMapView BinaryMapView::map(std::string_view key) const {
+    return BinaryMapView(find(key));
+}
+
+BinaryListView BinaryMapView::list(std::string_view key) const {
+    return BinaryListView(find(key));
+}
+
+size_t BinaryMapView::size() const {
+    size_t count = 0;
+    forEach([&count](auto, auto) { count++; });
+    return count;
+}
+
+Map_sptr BinaryMapView::toMap() const {
+    if (!view) {
+        return nullptr;
+    }
+    auto value = view.toValue();
+    return std::get<Map_sptr>(value);
+}
+
+BinaryListView::BinaryListView(BinaryView view) {
+    if (view && view.getType() == BJSON_TYPE_LIST) {
+        this->view = view;
+    }
+}
+
+const ubyte* BinaryListView::elements() const {
+    return view ? view.ptr + 1 : nullptr;
+}
+
+bool BinaryListView::nextElement(const ubyte*& pos, BinaryView& value) const {
+    if (pos == nullptr || pos >= view.end || *pos == BJSON_END) {
+        return false;
+    }
+    value = BinaryView(pos, view.end);
+    pos = value.next();
+    return true;
+}
+
+size_t BinaryListView::size() const {
+    size_t count = 0;
+    forEach([&count](auto) { count++; });
+    return count;
+}
+
+BinaryView BinaryListView::get(size_t index) const {
+    const ubyte* pos = elements();
+    BinaryView value;
+    for (size_t i = 0; nextElement(pos, value); i++) {
+        if (i == index) {
+            return value;
+        }
+    }
+    return BinaryView();
+}
+
+List_sptr BinaryListView::toList() const {
+    if (!view) {
+        return nullptr;
+    }
+    auto value = view.toValue();
+    return std::get<List_sptr>(value);
+}
+
+BinaryDocument::BinaryDocument(const ubyte* src, size_t size) {
+    if (size < 2) {
+        throw std::runtime_error("bytes length is less than 2");
+    }
+    if (src[0] == gzip::MAGIC[0] && src[1] == gzip::MAGIC[1]) {
+        buffer = gzip::decompress(src, size);
+        src = buffer.data();
+        size = buffer.size();
+    }
+    root = BinaryMapView(BinaryView(src, src + size));
+    if (!root) {
+        throw std::runtime_error("root value is not an object");
+    }
+}
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "data/dynamic_fwd.hpp"
 
+class ByteBuilder;
+
 namespace dynamic {
     class Map;
 }
@@ -31,5 +36,166 @@ namespace json {
     std::vector<ubyte> to_binary(
         const dynamic::Value& obj, bool compress = false
     );
+    /// @brief Append uncompressed binary json document to the builder
+    void write_binary(ByteBuilder& builder, const dynamic::Map* obj);
+    /// @brief Write uncompressed binary json document passing bytes to the
+    /// consumer in chunks of bounded size (whole document is not buffered)
+    void write_binary(
+        const dynamic::Map* obj,
+        const std::function<void(const ubyte* data, size_t size)>& consumer
+    );
+
     std::shared_ptr<dynamic::Map> from_binary(const ubyte* src, size_t size);
+
+    class BinaryMapView;
+    class BinaryListView;
+
+    /// @brief Non-owning view of an encoded binary json value.
+    /// Values are decoded on access, nested documents are skipped using
+    /// their size field. View is invalid (false) if value is not found
+    class BinaryView {
+        /// @brief value type byte
+        const ubyte* ptr = nullptr;
+        /// @brief end of the encoded data
+        const ubyte* end = nullptr;
+
+        friend class BinaryMapView;
+        friend class BinaryListView;
+    public:
+        BinaryView() = default;
+        BinaryView(const ubyte* ptr, const ubyte* end);
+
+        explicit operator bool() const {
+            return ptr != nullptr;
+        }
+
+        /// @return BJSON_TYPE_* value type code
+        int getType() const {
+            return *ptr;
+        }
+
+        /// @return pointer to the byte after the encoded value
+        const ubyte* next() const;
+
+        integer_t asInteger() const;
+        number_t asNumber() const;
+        bool asBoolean() const;
+        /// @return string stored in the encoded data (not copied)
+        std::string_view asString() const;
+        BinaryMapView asMap() const;
+        BinaryListView asList() const;
+
+        /// @brief Decode value with all nested values
+        dynamic::Value toValue() const;
+    };
+
+    /// @brief dynamic::Map-like lazy view of an encoded document.
+    /// Keys lookup is a linear scan without allocations
+    class BinaryMapView {
+        BinaryView view;
+
+        /// @brief Read entry at pos and move pos to the next one
+        /// @return false if document end is reached
+        bool nextEntry(
+            const ubyte*& pos, std::string_view& key, BinaryView& value
+        ) const;
+        const ubyte* entries() const;
+    public:
+        BinaryMapView() = default;
+        BinaryMapView(BinaryView view);
+
+        explicit operator bool() const {
+            return static_cast<bool>(view);
+        }
+
+        BinaryView find(std::string_view key) const;
+
+        bool has(std::string_view key) const {
+            return static_cast<bool>(find(key));
+        }
+
+        std::string get(std::string_view key, const std::string& def) const;
+        number_t get(std::string_view key, double def) const;
+        integer_t get(std::string_view key, integer_t def) const;
+        bool get(std::string_view key, bool def) const;
+
+        int get(std::string_view key, int def) const {
+            return get(key, static_cast<integer_t>(def));
+        }
+        uint get(std::string_view key, uint def) const {
+            return get(key, static_cast<integer_t>(def));
+        }
+
+        BinaryMapView map(std::string_view key) const;
+        BinaryListView list(std::string_view key) const;
+
+        /// @brief Count entries (linear)
+        size_t size() const;
+
+        /// @param func called with (std::string_view key, BinaryView value)
+        template <typename Func>
+        void forEach(const Func& func) const {
+            const ubyte* pos = entries();
+            std::string_view key;
+            BinaryView value;
+            while (nextEntry(pos, key, value)) {
+                func(key, value);
+            }
+        }
+
+        /// @brief Decode document with all nested values
+        dynamic::Map_sptr toMap() const;
+    };
+
+    /// @brief dynamic::List-like lazy view of an encoded list.
+    /// Elements access is a linear scan
+    class BinaryListView {
+        BinaryView view;
+
+        /// @brief Read element at pos and move pos to the next one
+        /// @return false if list end is reached
+        bool nextElement(const ubyte*& pos, BinaryView& value) const;
+        const ubyte* elements() const;
+    public:
+        BinaryListView() = default;
+        BinaryListView(BinaryView view);
+
+        explicit operator bool() const {
+            return static_cast<bool>(view);
+        }
+
+        /// @brief Count elements (linear)
+        size_t size() const;
+
+        /// @return element view or invalid view if index is out of range
+        BinaryView get(size_t index) const;
+
+        /// @param func called with (BinaryView value)
+        template <typename Func>
+        void forEach(const Func& func) const {
+            const ubyte* pos = elements();
+            BinaryView value;
+            while (nextElement(pos, value)) {
+                func(value);
+            }
+        }
+
+        /// @brief Decode list with all nested values
+        dynamic::List_sptr toList() const;
+    };
+
+    /// @brief Encoded binary json document. Compressed data is
+    /// decompressed into owned buffer, otherwise source bytes are viewed
+    /// without copying and must outlive the document
+    class BinaryDocument {
+        std::vector<ubyte> buffer;
+        BinaryMapView root;
+    public:
+        BinaryDocument(const ubyte* src, size_t size);
+        BinaryDocument(const BinaryDocument&) = delete;
+
+        const BinaryMapView& getRoot() const {
+            return root;
+        }
+    };
 }
@@ -9,11 +9,7 @@ void ByteBuilder::put(ubyte b) {
 }
 
 void ByteBuilder::putCStr(const char* str) {
-    size_t size = strlen(str) + 1;
-    buffer.reserve(buffer.size() + size);
-    for (size_t i = 0; i < size; i++) {
-        buffer.push_back(str[i]);
-    }
+    put(reinterpret_cast<const ubyte*>(str), strlen(str) + 1);
 }
 
 void ByteBuilder::put(const std::string& s) {
@@ -23,10 +19,8 @@ void ByteBuilder::put(const std::string& s) {
 }
 
 void ByteBuilder::put(const ubyte* arr, size_t size) {
-    buffer.reserve(buffer.size() + size);
-    for (size_t i = 0; i < size; i++) {
-        buffer.push_back(arr[i]);
-    }
+    // insert keeps geometric growth unlike reserve with exact size
+    buffer.insert(buffer.end(), arr, arr + size);
 }
 
 void ByteBuilder::putInt16(int16_t val) {
@@ -35,7 +29,6 @@ void ByteBuilder::putInt16(int16_t val) {
 }
 
 void ByteBuilder::putInt32(int32_t val) {
-    buffer.reserve(buffer.size() + 4);
     buffer.push_back(static_cast<ubyte>(val >> 0 & 255));
     buffer.push_back(static_cast<ubyte>(val >> 8 & 255));
     buffer.push_back(static_cast<ubyte>(val >> 16 & 255));
@@ -43,7 +36,6 @@ void ByteBuilder::putInt32(int32_t val) {
 }
 
 void ByteBuilder::putInt64(int64_t val) {
-    buffer.reserve(buffer.size() + 8);
     buffer.push_back(static_cast<ubyte>(val >> 0 & 255));
     buffer.push_back(static_cast<ubyte>(val >> 8 & 255));
     buffer.push_back(static_cast<ubyte>(val >> 16 & 255));
@@ -94,8 +86,16 @@ void ByteBuilder::setInt64(size_t position, int64_t val) {
     buffer[position] = val >> 56 & 255;
 }
 
+void ByteBuilder::reserve(size_t size) {
+    buffer.reserve(size);
+}
+
+void ByteBuilder::clear() {
+    buffer.clear();
+}
+
 std::vector<ubyte> ByteBuilder::build() {
-    return buffer;
+    return std::move(buffer);
 }
 
 ByteReader::ByteReader(const ubyte* data, size_t size)
@@ -198,6 +198,17 @@ std::string ByteReader::getString() {
     );
 }
 
+std::string_view ByteReader::getStringView() {
+    uint32_t length = (uint32_t)getInt32();
+    if (pos + length > size) {
+        throw std::runtime_error("buffer underflow");
+    }
+    pos += length;
+    return std::string_view(
+        reinterpret_cast<const char*>(data + pos - length), length
+    );
+}
+
 bool ByteReader::hasNext() const {
     return pos < size;
 }
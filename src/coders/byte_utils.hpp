@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "typedefs.hpp"
@@ -34,6 +35,11 @@ public:
     void setInt32(size_t position, int32_t val);
     void setInt64(size_t position, int64_t val);
 
+    /* Preallocate buffer capacity (bytes) */
+    void reserve(size_t size);
+    /* Remove written bytes keeping buffer capacity */
+    void clear();
+
     inline size_t size() const {
         return buffer.size();
     }
@@ -41,6 +47,7 @@ public:
         return buffer.data();
     }
 
+    /* Move out written bytes (builder becomes empty) */
     std::vector<ubyte> build();
 };
 
@@ -72,6 +79,9 @@ public:
     const char* getCString();
     /// @brief Read string with unsigned 32 bit number before (length)
     std::string getString();
+    /// @brief Read string with unsigned 32 bit number before (length)
+    /// without copying
+    std::string_view getStringView();
     /// @return true if there is at least one byte remains
     bool hasNext() const;
 
@@ -6,60 +6,260 @@
 #include <math.h>
 #include <zlib.h>
 
-#include <memory>
-
-std::vector<ubyte> gzip::compress(const ubyte* src, size_t size) {
-    size_t buffer_size = 23 + size * 1.01;
-    std::vector<ubyte> buffer;
-    buffer.resize(buffer_size);
-
-    // zlib struct
-    z_stream defstream {};
-    defstream.zalloc = Z_NULL;
-    defstream.zfree = Z_NULL;
-    defstream.opaque = Z_NULL;
-    defstream.avail_in = size;
-    defstream.next_in = src;
-    defstream.avail_out = buffer_size;
-    defstream.next_out = buffer.data();
-
-    // compression
-    deflateInit2(
-        &defstream,
-        Z_DEFAULT_COMPRESSION,
-        Z_DEFLATED,
-        16 + MAX_WBITS,
-        8,
-        Z_DEFAULT_STRATEGY
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+/// @brief Output chunk size (bytes)
+inline constexpr size_t CHUNK_SIZE = 64 * 1024;
+/// @brief Max size hint taken from the footer (footer may be corrupted)
+inline constexpr size_t MAX_SIZE_HINT = 64 * 1024 * 1024;
+/// @brief Max contexts kept by a thread for reuse
+inline constexpr size_t MAX_POOLED_CONTEXTS = 4;
+
+namespace gzip {
+    struct DeflateContext {
+        z_stream stream {};
+        int level;
+        ubyte buffer[CHUNK_SIZE];
+
+        DeflateContext(int level) : level(level) {
+            if (deflateInit2(
+                    &stream,
+                    level,
+                    Z_DEFLATED,
+                    16 + MAX_WBITS,
+                    8,
+                    Z_DEFAULT_STRATEGY
+                ) != Z_OK) {
+                throw std::runtime_error("could not initialize deflate");
+            }
+        }
+
+        ~DeflateContext() {
+            deflateEnd(&stream);
+        }
+    };
+
+    struct InflateContext {
+        z_stream stream {};
+        ubyte buffer[CHUNK_SIZE];
+
+        InflateContext() {
+            if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK) {
+                throw std::runtime_error("could not initialize inflate");
+            }
+        }
+
+        ~InflateContext() {
+            inflateEnd(&stream);
+        }
+    };
+}
+
+using namespace gzip;
+
+template <class T>
+using contexts_pool = std::vector<std::unique_ptr<T>>;
+
+static thread_local contexts_pool<DeflateContext> deflate_pool;
+static thread_local contexts_pool<InflateContext> inflate_pool;
+
+template <class T>
+static std::unique_ptr<T> acquire(contexts_pool<T>& pool) {
+    if (pool.empty()) {
+        return nullptr;
+    }
+    auto context = std::move(pool.back());
+    pool.pop_back();
+    return context;
+}
+
+template <class T>
+static void release(contexts_pool<T>& pool, T* context) {
+    if (pool.size() < MAX_POOLED_CONTEXTS) {
+        pool.emplace_back(context);
+    } else {
+        delete context;
+    }
+}
+
+void ContextRelease::operator()(DeflateContext* context) const {
+    deflateReset(&context->stream);
+    release(deflate_pool, context);
+}
+
+void ContextRelease::operator()(InflateContext* context) const {
+    inflateReset(&context->stream);
+    release(inflate_pool, context);
+}
+
+static std::unique_ptr<DeflateContext, ContextRelease> acquire_deflate(
+    int level
+) {
+    auto pooled = acquire(deflate_pool);
+    if (pooled == nullptr) {
+        pooled = std::make_unique<DeflateContext>(level);
+    } else if (pooled->level != level) {
+        // buffers of the previous use are not valid anymore
+        auto& stream = pooled->stream;
+        stream.next_in = nullptr;
+        stream.avail_in = 0;
+        stream.next_out = nullptr;
+        stream.avail_out = 0;
+        if (deflateParams(&stream, level, Z_DEFAULT_STRATEGY) == Z_OK) {
+            pooled->level = level;
+        } else {
+            pooled = std::make_unique<DeflateContext>(level);
+        }
+    }
+    return std::unique_ptr<DeflateContext, ContextRelease>(pooled.release());
+}
+
+static std::unique_ptr<InflateContext, ContextRelease> acquire_inflate() {
+    auto pooled = acquire(inflate_pool);
+    if (pooled == nullptr) {
+        pooled = std::make_unique<InflateContext>();
+    }
+    return std::unique_ptr<InflateContext, ContextRelease>(pooled.release());
+}
+
+Encoder::Encoder(sink consumer, int level)
+    : context(acquire_deflate(level)), consumer(std::move(consumer)) {
+}
+
+Encoder::~Encoder() = default;
+
+void Encoder::process(const ubyte* src, size_t size, bool finish) {
+    auto& stream = context->stream;
+    stream.next_in = src;
+    stream.avail_in = size;
+    int status;
+    do {
+        stream.next_out = context->buffer;
+        stream.avail_out = CHUNK_SIZE;
+        status = deflate(&stream, finish ? Z_FINISH : Z_NO_FLUSH);
+        if (status == Z_STREAM_ERROR) {
+            throw std::runtime_error("deflate error");
+        }
+        size_t produced = CHUNK_SIZE - stream.avail_out;
+        if (produced) {
+            consumer(context->buffer, produced);
+        }
+    } while (stream.avail_out == 0 || (finish && status != Z_STREAM_END));
+}
+
+void Encoder::write(const ubyte* src, size_t size) {
+    if (finished) {
+        throw std::runtime_error("encoder is finished");
+    }
+    process(src, size, false);
+}
+
+void Encoder::finish() {
+    if (finished) {
+        return;
+    }
+    process(nullptr, 0, true);
+    finished = true;
+}
+
+Decoder::Decoder(sink consumer)
+    : context(acquire_inflate()), consumer(std::move(consumer)) {
+}
+
+Decoder::~Decoder() = default;
+
+static std::runtime_error inflate_error(const z_stream& stream) {
+    return std::runtime_error(
+        "corrupted gzip data: " +
+        std::string(stream.msg ? stream.msg : "inflate error")
     );
-    deflate(&defstream, Z_FINISH);
-    deflateEnd(&defstream);
+}
+
+void Decoder::write(const ubyte* src, size_t size) {
+    auto& stream = context->stream;
+    stream.next_in = src;
+    stream.avail_in = size;
+    while (stream.avail_in > 0 && !finished) {
+        stream.next_out = context->buffer;
+        stream.avail_out = CHUNK_SIZE;
+        int status = inflate(&stream, Z_NO_FLUSH);
+        switch (status) {
+            case Z_OK:
+            case Z_BUF_ERROR:
+                break;
+            case Z_STREAM_END:
+                finished = true;
+                break;
+            default:
+                throw inflate_error(stream);
+        }
+        size_t produced = CHUNK_SIZE - stream.avail_out;
+        if (produced) {
+            consumer(context->buffer, produced);
+        } else if (status == Z_BUF_ERROR) {
+            break;
+        }
+    }
+}
 
-    size_t compressed_size = defstream.next_out - buffer.data();
-    buffer.resize(compressed_size);
+void Decoder::finish() {
+    if (!finished) {
+        throw std::runtime_error("unexpected end of gzip data");
+    }
+}
+
+std::vector<ubyte> gzip::compress(const ubyte* src, size_t size, int level) {
+    auto context = acquire_deflate(level);
+    auto& stream = context->stream;
+
+    std::vector<ubyte> buffer(deflateBound(&stream, size));
+    stream.next_in = src;
+    stream.avail_in = size;
+    stream.next_out = buffer.data();
+    stream.avail_out = buffer.size();
+    if (deflate(&stream, Z_FINISH) != Z_STREAM_END) {
+        throw std::runtime_error("deflate error");
+    }
+    buffer.resize(stream.next_out - buffer.data());
     return buffer;
 }
 
 std::vector<ubyte> gzip::decompress(const ubyte* src, size_t size) {
-    // getting uncompressed data length from gzip footer
-    size_t decompressed_size =
-        *reinterpret_cast<const uint32_t*>(src + size - 4);
-    std::vector<ubyte> buffer;
-    buffer.resize(decompressed_size);
-
-    // zlib struct
-    z_stream infstream;
-    infstream.zalloc = Z_NULL;
-    infstream.zfree = Z_NULL;
-    infstream.opaque = Z_NULL;
-    infstream.avail_in = size;
-    infstream.next_in = src;
-    infstream.avail_out = decompressed_size;
-    infstream.next_out = buffer.data();
-
-    inflateInit2(&infstream, 16 + MAX_WBITS);
-    inflate(&infstream, Z_NO_FLUSH);
-    inflateEnd(&infstream);
+    if (size < 18) {
+        throw std::runtime_error("gzip data is too short");
+    }
+    // uncompressed data length from gzip footer is used as a hint only
+    uint32_t hint;
+    std::memcpy(&hint, src + size - 4, sizeof(hint));
 
+    auto context = acquire_inflate();
+    auto& stream = context->stream;
+    stream.next_in = src;
+    stream.avail_in = size;
+
+    std::vector<ubyte> buffer(
+        std::max(std::min(static_cast<size_t>(hint), MAX_SIZE_HINT), CHUNK_SIZE)
+    );
+    size_t produced = 0;
+    while (true) {
+        if (produced == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        stream.next_out = buffer.data() + produced;
+        stream.avail_out = buffer.size() - produced;
+        int status = inflate(&stream, Z_NO_FLUSH);
+        produced = buffer.size() - stream.avail_out;
+        if (status == Z_STREAM_END) {
+            break;
+        } else if (status == Z_BUF_ERROR && stream.avail_in == 0) {
+            throw std::runtime_error("unexpected end of gzip data");
+        } else if (status != Z_OK && status != Z_BUF_ERROR) {
+            throw inflate_error(stream);
+        }
+    }
+    buffer.resize(produced);
     return buffer;
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <vector>
 
 #include "typedefs.hpp"
@@ -7,13 +9,75 @@
 namespace gzip {
     const unsigned char MAGIC[] = "\x1F\x8B";
 
+    inline constexpr int DEFAULT_LEVEL = -1;
+    inline constexpr int BEST_SPEED = 1;
+    inline constexpr int BEST_COMPRESSION = 9;
+
+    /// @brief Consumer of produced bytes chunk
+    using sink = std::function<void(const ubyte* data, size_t size)>;
+
+    struct DeflateContext;
+    struct InflateContext;
+
+    /// @brief Returns zlib context to the current thread pool
+    struct ContextRelease {
+        void operator()(DeflateContext* context) const;
+        void operator()(InflateContext* context) const;
+    };
+
+    /// @brief Streaming GZIP compressor. Input is written in chunks,
+    /// compressed data is passed to the sink in chunks of bounded size.
+    /// zlib contexts are reused between encoders of the same thread
+    class Encoder {
+        std::unique_ptr<DeflateContext, ContextRelease> context;
+        sink consumer;
+        bool finished = false;
+
+        void process(const ubyte* src, size_t size, bool finish);
+    public:
+        /// @param level compression level (0-9, DEFAULT_LEVEL)
+        Encoder(sink consumer, int level = DEFAULT_LEVEL);
+        ~Encoder();
+
+        void write(const ubyte* src, size_t size);
+
+        /// @brief Flush remaining data and write GZIP footer
+        void finish();
+    };
+
+    /// @brief Streaming GZIP decompressor. Compressed data is written in
+    /// chunks, decompressed data is passed to the sink in chunks of bounded
+    /// size. Invalid data causes std::runtime_error
+    class Decoder {
+        std::unique_ptr<InflateContext, ContextRelease> context;
+        sink consumer;
+        bool finished = false;
+    public:
+        Decoder(sink consumer);
+        ~Decoder();
+
+        void write(const ubyte* src, size_t size);
+
+        /// @throws std::runtime_error if stream is incomplete
+        void finish();
+
+        /// @return true if the end of compressed stream is reached
+        bool isFinished() const {
+            return finished;
+        }
+    };
+
     /* Compress bytes array to GZIP format
      @param src source bytes array
-     @param size length of source bytes array */
-    std::vector<ubyte> compress(const ubyte* src, size_t size);
+     @param size length of source bytes array
+     @param level compression level (0-9, DEFAULT_LEVEL) */
+    std::vector<ubyte> compress(
+        const ubyte* src, size_t size, int level = DEFAULT_LEVEL
+    );
 
     /* Decompress bytes array from GZIP
      @param src GZIP data
-     @param size length of GZIP data */
+     @param size length of GZIP data
+     @throws std::runtime_error if data is corrupted or incomplete */
     std::vector<ubyte> decompress(const ubyte* src, size_t size);
 }
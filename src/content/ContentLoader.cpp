@@ -10,14 +10,17 @@
 #include "ContentBuilder.hpp"
 #include "ContentPack.hpp"
 #include "coders/json.hpp"
+#include "content_cache.hpp"
 #include "core_defs.hpp"
 #include "data/dynamic.hpp"
 #include "debug/Logger.hpp"
 #include "files/files.hpp"
 #include "items/ItemDef.hpp"
+#include "loading_order.hpp"
 #include "logic/scripting/scripting.hpp"
 #include "objects/rigging.hpp"
 #include "typedefs.hpp"
+#include "util/ParallelWorkers.hpp"
 #include "util/listutil.hpp"
 #include "util/stringutil.hpp"
 #include "voxels/Block.hpp"
@@ -119,33 +122,19 @@ void ContentLoader::fixPackIndices() {
 }
 
 void ContentLoader::loadBlock(
-    Block& def, const std::string& name, const fs::path& file
+    Block& def, const std::string& name, const dynamic::Map& root
 ) {
-    auto root = files::read_json(file);
-
-    if (root->has("parent")) {
-        std::string parentName;
-        root->str("parent", parentName);
-        auto parentDef = this->builder.blocks.get(parentName);
-        if (parentDef == nullptr) {
-            throw std::runtime_error(
-                "Failed to find parent(" + parentName + ") for " + name
-            );
-        }
-        parentDef->cloneTo(def);
-    }
-
-    root->str("caption", def.caption);
+    root.str("caption", def.caption);
 
     // block texturing
-    if (root->has("texture")) {
+    if (root.has("texture")) {
         std::string texture;
-        root->str("texture", texture);
+        root.str("texture", texture);
         for (uint i = 0; i < 6; i++) {
             def.textureFaces[i] = texture;
         }
-    } else if (root->has("texture-faces")) {
-        auto texarr = root->list("texture-faces");
+    } else if (root.has("texture-faces")) {
+        auto texarr = root.list("texture-faces");
         for (uint i = 0; i < 6; i++) {
             def.textureFaces[i] = texarr->str(i);
         }
@@ -153,11 +142,11 @@ void ContentLoader::loadBlock(
 
     // block model
     std::string modelName;
-    root->str("model", modelName);
+    root.str("model", modelName);
     if (auto model = BlockModel_from(modelName)) {
         if (*model == BlockModel::custom) {
-            if (root->has("model-primitives")) {
-                loadCustomBlockModel(def, root->map("model-primitives").get());
+            if (root.has("model-primitives")) {
+                loadCustomBlockModel(def, root.map("model-primitives").get());
             } else {
                 logger.error() << name << ": no 'model-primitives' found";
             }
@@ -168,11 +157,11 @@ void ContentLoader::loadBlock(
         def.model = BlockModel::none;
     }
 
-    root->str("material", def.material);
+    root.str("material", def.material);
 
     // rotation profile
     std::string profile = "none";
-    root->str("rotation", profile);
+    root.str("rotation", profile);
     def.rotatable = profile != "none";
     if (profile == BlockRotProfile::PIPE_NAME) {
         def.rotations = BlockRotProfile::PIPE;
@@ -184,7 +173,7 @@ void ContentLoader::loadBlock(
     }
 
     // block hitbox AABB [x, y, z, width, height, depth]
-    auto boxarr = root->list("hitboxes");
+    auto boxarr = root.list("hitboxes");
     if (boxarr) {
         def.hitboxes.resize(boxarr->size());
         for (uint i = 0; i < boxarr->size(); i++) {
@@ -194,7 +183,7 @@ void ContentLoader::loadBlock(
             hitboxesIndex.b = glm::vec3(box->num(3), box->num(4), box->num(5));
             hitboxesIndex.b += hitboxesIndex.a;
         }
-    } else if ((boxarr = root->list("hitbox"))) {
+    } else if ((boxarr = root.list("hitbox"))) {
         AABB aabb;
         aabb.a = glm::vec3(boxarr->num(0), boxarr->num(1), boxarr->num(2));
         aabb.b = glm::vec3(boxarr->num(3), boxarr->num(4), boxarr->num(5));
@@ -207,14 +196,14 @@ void ContentLoader::loadBlock(
     }
 
     // block light emission [r, g, b] where r,g,b in range [0..15]
-    if (auto emissionarr = root->list("emission")) {
+    if (auto emissionarr = root.list("emission")) {
         def.emission[0] = emissionarr->num(0);
         def.emission[1] = emissionarr->num(1);
         def.emission[2] = emissionarr->num(2);
     }
 
     // block size
-    if (auto sizearr = root->list("size")) {
+    if (auto sizearr = root.list("size")) {
         def.size.x = sizearr->num(0);
         def.size.y = sizearr->num(1);
         def.size.z = sizearr->num(2);
@@ -226,22 +215,22 @@ void ContentLoader::loadBlock(
     }
 
     // primitive properties
-    root->flag("obstacle", def.obstacle);
-    root->flag("replaceable", def.replaceable);
-    root->flag("light-passing", def.lightPassing);
-    root->flag("sky-light-passing", def.skyLightPassing);
-    root->flag("shadeless", def.shadeless);
-    root->flag("ambient-occlusion", def.ambientOcclusion);
-    root->flag("breakable", def.breakable);
-    root->flag("selectable", def.selectable);
-    root->flag("grounded", def.grounded);
-    root->flag("hidden", def.hidden);
-    root->num("draw-group", def.drawGroup);
-    root->str("picking-item", def.pickingItem);
-    root->str("script-name", def.scriptName);
-    root->str("ui-layout", def.uiLayout);
-    root->num("inventory-size", def.inventorySize);
-    root->num("tick-interval", def.tickInterval);
+    root.flag("obstacle", def.obstacle);
+    root.flag("replaceable", def.replaceable);
+    root.flag("light-passing", def.lightPassing);
+    root.flag("sky-light-passing", def.skyLightPassing);
+    root.flag("shadeless", def.shadeless);
+    root.flag("ambient-occlusion", def.ambientOcclusion);
+    root.flag("breakable", def.breakable);
+    root.flag("selectable", def.selectable);
+    root.flag("grounded", def.grounded);
+    root.flag("hidden", def.hidden);
+    root.num("draw-group", def.drawGroup);
+    root.str("picking-item", def.pickingItem);
+    root.str("script-name", def.scriptName);
+    root.str("ui-layout", def.uiLayout);
+    root.num("inventory-size", def.inventorySize);
+    root.num("tick-interval", def.tickInterval);
     if (def.tickInterval == 0) {
         def.tickInterval = 1;
     }
@@ -298,26 +287,12 @@ void ContentLoader::loadCustomBlockModel(Block& def, dynamic::Map* primitives) {
 }
 
 void ContentLoader::loadItem(
-    ItemDef& def, const std::string& name, const fs::path& file
+    ItemDef& def, const std::string& name, const dynamic::Map& root
 ) {
-    auto root = files::read_json(file);
-
-    if (root->has("parent")) {
-        std::string parentName;
-        root->str("parent", parentName);
-        auto parentDef = this->builder.items.get(parentName);
-        if (parentDef == nullptr) {
-            throw std::runtime_error(
-                "Failed to find parent(" + parentName + ") for " + name
-            );
-        }
-        parentDef->cloneTo(def);
-    }
-
-    root->str("caption", def.caption);
+    root.str("caption", def.caption);
 
     std::string iconTypeStr = "";
-    root->str("icon-type", iconTypeStr);
+    root.str("icon-type", iconTypeStr);
     if (iconTypeStr == "none") {
         def.iconType = item_icon_type::none;
     } else if (iconTypeStr == "block") {
@@ -327,13 +302,13 @@ void ContentLoader::loadItem(
     } else if (iconTypeStr.length()) {
         logger.error() << name << ": unknown icon type" << iconTypeStr;
     }
-    root->str("icon", def.icon);
-    root->str("placing-block", def.placingBlock);
-    root->str("script-name", def.scriptName);
-    root->num("stack-size", def.stackSize);
+    root.str("icon", def.icon);
+    root.str("placing-block", def.placingBlock);
+    root.str("script-name", def.scriptName);
+    root.num("stack-size", def.stackSize);
 
     // item light emission [r, g, b] where r,g,b in range [0..15]
-    if (auto emissionarr = root->list("emission")) {
+    if (auto emissionarr = root.list("emission")) {
         def.emission[0] = emissionarr->num(0);
         def.emission[1] = emissionarr->num(1);
         def.emission[2] = emissionarr->num(2);
@@ -341,31 +316,17 @@ void ContentLoader::loadItem(
 }
 
 void ContentLoader::loadEntity(
-    EntityDef& def, const std::string& name, const fs::path& file
+    EntityDef& def, const std::string& name, const dynamic::Map& root
 ) {
-    auto root = files::read_json(file);
-
-    if (root->has("parent")) {
-        std::string parentName;
-        root->str("parent", parentName);
-        auto parentDef = this->builder.entities.get(parentName);
-        if (parentDef == nullptr) {
-            throw std::runtime_error(
-                "Failed to find parent(" + parentName + ") for " + name
-            );
-        }
-        parentDef->cloneTo(def);
-    }
-
-    if (auto componentsarr = root->list("components")) {
+    if (auto componentsarr = root.list("components")) {
         for (size_t i = 0; i < componentsarr->size(); i++) {
             def.components.emplace_back(componentsarr->str(i));
         }
     }
-    if (auto boxarr = root->list("hitbox")) {
+    if (auto boxarr = root.list("hitbox")) {
         def.hitbox = glm::vec3(boxarr->num(0), boxarr->num(1), boxarr->num(2));
     }
-    if (auto sensorsarr = root->list("sensors")) {
+    if (auto sensorsarr = root.list("sensors")) {
         for (size_t i = 0; i < sensorsarr->size(); i++) {
             if (auto sensorarr = sensorsarr->list(i)) {
                 auto sensorType = sensorarr->str(0);
@@ -391,40 +352,39 @@ void ContentLoader::loadEntity(
             }
         }
     }
-    root->flag("save", def.save.enabled);
-    root->flag("save-skeleton-pose", def.save.skeleton.pose);
-    root->flag("save-skeleton-textures", def.save.skeleton.textures);
-    root->flag("save-body-velocity", def.save.body.velocity);
-    root->flag("save-body-settings", def.save.body.settings);
+    root.flag("save", def.save.enabled);
+    root.flag("save-skeleton-pose", def.save.skeleton.pose);
+    root.flag("save-skeleton-textures", def.save.skeleton.textures);
+    root.flag("save-body-velocity", def.save.body.velocity);
+    root.flag("save-body-settings", def.save.body.settings);
 
     std::string bodyTypeName;
-    root->str("body-type", bodyTypeName);
+    root.str("body-type", bodyTypeName);
     if (auto bodyType = BodyType_from(bodyTypeName)) {
         def.bodyType = *bodyType;
     }
 
-    root->str("skeleton-name", def.skeletonName);
-    root->flag("blocking", def.blocking);
+    root.str("skeleton-name", def.skeletonName);
+    root.flag("blocking", def.blocking);
 }
 
 void ContentLoader::loadEntity(
-    EntityDef& def, const std::string& full, const std::string& name
+    EntityDef& def, const std::string& full, const dynamic::Map* root
 ) {
-    auto folder = pack->folder;
-    auto configFile = folder / fs::path("entities/" + name + ".json");
-    if (fs::exists(configFile)) loadEntity(def, full, configFile);
+    if (root) loadEntity(def, full, *root);
 }
 
 void ContentLoader::loadBlock(
-    Block& def, const std::string& full, const std::string& name
+    Block& def, const std::string& full, const dynamic::Map* root
 ) {
     auto folder = pack->folder;
-    auto configFile = folder / fs::path("blocks/" + name + ".json");
-    if (fs::exists(configFile)) loadBlock(def, full, configFile);
+    if (root) loadBlock(def, full, *root);
 
     auto scriptfile = folder / fs::path("scripts/" + def.scriptName + ".lua");
     if (fs::is_regular_file(scriptfile)) {
-        scripting::load_block_script(env, full, scriptfile, def.rt.funcsset);
+        scripting::load_block_script(
+            env, full, scriptfile, def.rt.funcsset, def.rt.callbacks
+        );
     }
     if (!def.hidden) {
         auto& item = builder.items.create(full + BLOCK_ITEM_SUFFIX);
@@ -442,15 +402,16 @@ void ContentLoader::loadBlock(
 }
 
 void ContentLoader::loadItem(
-    ItemDef& def, const std::string& full, const std::string& name
+    ItemDef& def, const std::string& full, const dynamic::Map* root
 ) {
     auto folder = pack->folder;
-    auto configFile = folder / fs::path("items/" + name + ".json");
-    if (fs::exists(configFile)) loadItem(def, full, configFile);
+    if (root) loadItem(def, full, *root);
 
     auto scriptfile = folder / fs::path("scripts/" + def.scriptName + ".lua");
     if (fs::is_regular_file(scriptfile)) {
-        scripting::load_item_script(env, full, scriptfile, def.rt.funcsset);
+        scripting::load_item_script(
+            env, full, scriptfile, def.rt.funcsset, def.rt.callbacks
+        );
     }
 }
 
@@ -463,6 +424,83 @@ void ContentLoader::loadBlockMaterial(
     root->str("break-sound", def.breakSound);
 }
 
+namespace {
+    struct def_entry {
+        std::string full;
+        dynamic::Map_sptr root;
+    };
+}
+
+/// @brief Read definition files listed in the pack index in parallel
+/// @param list index list of definitions names
+/// @param prefix definitions folder name
+/// @return entries in the index order (root is nullptr if file not exists)
+static std::vector<def_entry> read_defs(
+    util::ParallelWorkers& workers,
+    const ContentPack& pack,
+    const dynamic::List& list,
+    const std::string& prefix
+) {
+    std::vector<def_entry> defs(list.size());
+    std::vector<fs::path> files(list.size());
+    for (size_t i = 0; i < list.size(); i++) {
+        auto name = list.str(i);
+        auto colon = name.find(':');
+        if (colon == std::string::npos) {
+            defs[i].full = pack.id + ":" + name;
+        } else {
+            defs[i].full = name;
+            name[colon] = '/';
+        }
+        files[i] = pack.folder / fs::path(prefix + "/" + name + ".json");
+    }
+    workers.run(defs.size(), [&](size_t begin, size_t end, uint) {
+        for (size_t i = begin; i < end; i++) {
+            if (fs::exists(files[i])) {
+                defs[i].root = files::read_json(files[i]);
+            }
+        }
+    });
+    return defs;
+}
+
+/// @brief Register definitions with parents registered first
+/// @param load function(def, entry) loading the created definition
+template <class T, typename Func>
+static void load_defs(
+    ContentUnitBuilder<T>& units, const std::vector<def_entry>& defs, Func load
+) {
+    std::vector<std::string> names(defs.size());
+    std::vector<std::string> parents(defs.size());
+    for (size_t i = 0; i < defs.size(); i++) {
+        names[i] = defs[i].full;
+        if (defs[i].root) {
+            defs[i].root->str("parent", parents[i]);
+        }
+    }
+    auto order = resolve_loading_order(
+        names,
+        parents,
+        [&units](const std::string& name) { return units.get(name) != nullptr; }
+    );
+    for (size_t index : order) {
+        const auto& entry = defs[index];
+        auto& def = units.create(entry.full);
+        if (!parents[index].empty()) {
+            units.get(parents[index])->cloneTo(def);
+        }
+        load(def, entry);
+    }
+}
+
+/// @return copy of resolved definition
+template <class T>
+static std::unique_ptr<T> copy_def(T& def) {
+    auto copy = std::make_unique<T>(def.name);
+    def.cloneTo(*copy);
+    return copy;
+}
+
 void ContentLoader::load() {
     logger.info() << "loading pack [" << pack->id << "]";
 
@@ -479,167 +517,32 @@ void ContentLoader::load() {
 
     if (!fs::is_regular_file(pack->getContentFile())) return;
 
-    auto root = files::read_json(pack->getContentFile());
-    std::vector<std::pair<std::string, std::string>> pendingDefs;
-    auto getJsonParent = [this](const std::string& prefix, const std::string& name) {
-            auto configFile = pack->folder / fs::path(prefix + "/" + name + ".json");
-            std::string parent;
-            if (fs::exists(configFile)) {
-                auto root = files::read_json(configFile);
-                if (root->has("parent")) root->str("parent", parent);
-            }
-            return parent;
-        };
-    auto processName = [this](const std::string& name) {
-        auto colon = name.find(':');
-        auto new_name = name;
-        std::string full =
-            colon == std::string::npos ? pack->id + ":" + name : name;
-        if (colon != std::string::npos) new_name[colon] = '/';
-
-        return std::make_pair(full, new_name);
-    };
-
-    if (auto blocksarr = root->list("blocks")) {
-        for (size_t i = 0; i < blocksarr->size(); i++) {
-            auto [full, name] = processName(blocksarr->str(i));
-            auto parent = getJsonParent("blocks", name);
-            if (parent.empty() || builder.blocks.get(parent)) {
-                // No dependency or dependency already loaded/exists in another
-                // content pack
-                auto& def = builder.blocks.create(full);
-                loadBlock(def, full, name);
-                stats->totalBlocks++;
-            } else {
-                // Dependency not loaded yet, add to pending items
-                pendingDefs.emplace_back(full, name);
-            }
-        }
-
-        // Resolve dependencies for pending items
-        bool progressMade = true;
-        while (!pendingDefs.empty() && progressMade) {
-            progressMade = false;
-
-            for (auto it = pendingDefs.begin(); it != pendingDefs.end();) {
-                auto parent = getJsonParent("blocks", it->second);
-                if (builder.blocks.get(parent)) {
-                    // Dependency resolved or parent exists in another pack,
-                    // load the item
-                    auto& def = builder.blocks.create(it->first);
-                    loadBlock(def, it->first, it->second);
-                    stats->totalBlocks++;
-                    it = pendingDefs.erase(it);  // Remove resolved item
-                    progressMade = true;
-                } else {
-                    ++it;
-                }
-            }
-        }
-
-        if (!pendingDefs.empty()) {
-            // Handle circular dependencies or missing dependencies
-            // You can log an error or throw an exception here if necessary
-            throw std::runtime_error("Unresolved block dependencies detected.");
-        }
+    fs::path cacheFile;
+    std::unique_ptr<content_cache::PackDefs> defs;
+    if (!cacheFolder.empty()) {
+        cacheKey = content_cache::compute_key(*pack, cacheKey);
+        cacheFile = cacheFolder / fs::u8path(pack->id + ".content");
+        defs = content_cache::read(cacheFile, cacheKey);
     }
-
-    if (auto itemsarr = root->list("items")) {
-        for (size_t i = 0; i < itemsarr->size(); i++) {
-            auto [full, name] = processName(itemsarr->str(i));
-            auto parent = getJsonParent("items", name);
-            if (parent.empty() || builder.items.get(parent)) {
-                // No dependency or dependency already loaded/exists in another
-                // content pack
-                auto& def = builder.items.create(full);
-                loadItem(def, full, name);
-                stats->totalItems++;
-            } else {
-                // Dependency not loaded yet, add to pending items
-                pendingDefs.emplace_back(full, name);
-            }
-        }
-
-        // Resolve dependencies for pending items
-        bool progressMade = true;
-        while (!pendingDefs.empty() && progressMade) {
-            progressMade = false;
-
-            for (auto it = pendingDefs.begin(); it != pendingDefs.end();) {
-                auto parent = getJsonParent("items", it->second);
-                if (builder.items.get(parent)) {
-                    // Dependency resolved or parent exists in another pack,
-                    // load the item
-                    auto& def = builder.items.create(it->first);
-                    loadItem(def, it->first, it->second);
-                    stats->totalItems++;
-                    it = pendingDefs.erase(it);  // Remove resolved item
-                    progressMade = true;
-                } else {
-                    ++it;
-                }
-            }
-        }
-
-        if (!pendingDefs.empty()) {
-            // Handle circular dependencies or missing dependencies
-            // You can log an error or throw an exception here if necessary
-            throw std::runtime_error("Unresolved item dependencies detected.");
+    if (defs) {
+        logger.info() << "definitions loaded from cache";
+        loadCachedDefinitions(*defs);
+    } else {
+        defs = std::make_unique<content_cache::PackDefs>();
+        parseDefinitions(*defs);
+        if (!cacheFile.empty() &&
+            !content_cache::write(cacheFile, cacheKey, *defs)) {
+            logger.warning() << "could not write content cache "
+                             << cacheFile.u8string();
         }
     }
 
-    if (auto entitiesarr = root->list("entities")) {
-        for (size_t i = 0; i < entitiesarr->size(); i++) {
-            auto [full, name] = processName(entitiesarr->str(i));
-            auto parent = getJsonParent("entities", name);
-            if (parent.empty() || builder.entities.get(parent)) {
-                // No dependency or dependency already loaded/exists in another
-                // content pack
-                auto& def = builder.entities.create(full);
-                loadEntity(def, full, name);
-                stats->totalEntities++;
-            } else {
-                // Dependency not loaded yet, add to pending items
-                pendingDefs.emplace_back(full, name);
-            }
-        }
-
-        // Resolve dependencies for pending items
-        bool progressMade = true;
-        while (!pendingDefs.empty() && progressMade) {
-            progressMade = false;
-
-            for (auto it = pendingDefs.begin(); it != pendingDefs.end();) {
-                auto parent = getJsonParent("entities", it->second);
-                if (builder.entities.get(parent)) {
-                    // Dependency resolved or parent exists in another pack,
-                    // load the item
-                    auto& def = builder.entities.create(it->first);
-                    loadEntity(def, it->first, it->second);
-                    stats->totalEntities++;
-                    it = pendingDefs.erase(it);  // Remove resolved item
-                    progressMade = true;
-                } else {
-                    ++it;
-                }
-            }
-        }
-
-        if (!pendingDefs.empty()) {
-            // Handle circular dependencies or missing dependencies
-            // You can log an error or throw an exception here if necessary
-            throw std::runtime_error(
-                "Unresolved entities dependencies detected."
-            );
-        }
+    for (const auto& material : defs->materials) {
+        builder.createBlockMaterial(material->name) = *material;
     }
-
-    fs::path materialsDir = folder / fs::u8path("block_materials");
-    if (fs::is_directory(materialsDir)) {
-        for (const auto& entry : fs::directory_iterator(materialsDir)) {
-            const fs::path& file = entry.path();
-            std::string name = pack->id + ":" + file.stem().u8string();
-            loadBlockMaterial(builder.createBlockMaterial(name), file);
+    for (size_t i = 0; i < RESOURCE_TYPES_COUNT; i++) {
+        for (const auto& name : defs->resources[i]) {
+            builder.resourceIndices[i].add(name, nullptr);
         }
     }
 
@@ -666,13 +569,64 @@ void ContentLoader::load() {
         }
     }
 
+}
+
+void ContentLoader::parseDefinitions(content_cache::PackDefs& defs) {
+    auto folder = pack->folder;
+    auto root = files::read_json(pack->getContentFile());
+    // definition files are parsed in parallel, while registration and
+    // scripts loading stay sequential
+    util::ParallelWorkers workers;
+
+    if (auto blocksarr = root->list("blocks")) {
+        auto entries = read_defs(workers, *pack, *blocksarr, "blocks");
+        load_defs(builder.blocks, entries, [&](auto& def, const auto& entry) {
+            loadBlock(def, entry.full, entry.root.get());
+            defs.blocks.push_back(copy_def(def));
+            stats->totalBlocks++;
+        });
+    }
+
+    if (auto itemsarr = root->list("items")) {
+        auto entries = read_defs(workers, *pack, *itemsarr, "items");
+        load_defs(builder.items, entries, [&](auto& def, const auto& entry) {
+            loadItem(def, entry.full, entry.root.get());
+            defs.items.push_back(copy_def(def));
+            stats->totalItems++;
+        });
+    }
+
+    if (auto entitiesarr = root->list("entities")) {
+        auto entries = read_defs(workers, *pack, *entitiesarr, "entities");
+        load_defs(
+            builder.entities,
+            entries,
+            [&](auto& def, const auto& entry) {
+                loadEntity(def, entry.full, entry.root.get());
+                defs.entities.push_back(copy_def(def));
+                stats->totalEntities++;
+            }
+        );
+    }
+
+    fs::path materialsDir = folder / fs::u8path("block_materials");
+    if (fs::is_directory(materialsDir)) {
+        for (const auto& entry : fs::directory_iterator(materialsDir)) {
+            const fs::path& file = entry.path();
+            auto material = std::make_unique<BlockMaterial>();
+            material->name = pack->id + ":" + file.stem().u8string();
+            loadBlockMaterial(*material, file);
+            defs.materials.push_back(std::move(material));
+        }
+    }
+
     fs::path resourcesFile = folder / fs::u8path("resources.json");
     if (fs::exists(resourcesFile)) {
         auto resRoot = files::read_json(resourcesFile);
         for (const auto& [key, _] : resRoot->values) {
             if (auto resType = ResourceType_from(key)) {
                 if (auto arr = resRoot->list(key)) {
-                    loadResources(*resType, arr.get());
+                    loadResources(defs, *resType, arr.get());
                 }
             } else {
                 logger.warning() << "unknown resource type: " << key;
@@ -681,10 +635,46 @@ void ContentLoader::load() {
     }
 }
 
-void ContentLoader::loadResources(ResourceType type, dynamic::List* list) {
+void ContentLoader::loadCachedDefinitions(
+    const content_cache::PackDefs& defs
+) {
+    // the same registration sequence as of parsing, but definitions
+    // properties are copied instead of loading from files
+    for (const auto& cached : defs.blocks) {
+        auto& def = builder.blocks.create(cached->name);
+        cached->cloneTo(def);
+        loadBlock(def, def.name, nullptr);
+        stats->totalBlocks++;
+    }
+    for (const auto& cached : defs.items) {
+        auto& def = builder.items.create(cached->name);
+        cached->cloneTo(def);
+        loadItem(def, def.name, nullptr);
+        stats->totalItems++;
+    }
+    for (const auto& cached : defs.entities) {
+        auto& def = builder.entities.create(cached->name);
+        cached->cloneTo(def);
+        loadEntity(def, def.name, nullptr);
+        stats->totalEntities++;
+    }
+}
+
+void ContentLoader::loadResources(
+    content_cache::PackDefs& defs, ResourceType type, dynamic::List* list
+) {
     for (size_t i = 0; i < list->size(); i++) {
-        builder.resourceIndices[static_cast<size_t>(type)].add(
-            pack->id + ":" + list->str(i), nullptr
+        defs.resources[static_cast<size_t>(type)].push_back(
+            pack->id + ":" + list->str(i)
         );
     }
 }
+
+void ContentLoader::setCache(const fs::path& folder, uint64_t dependencyKey) {
+    cacheFolder = folder;
+    cacheKey = dependencyKey;
+}
+
+uint64_t ContentLoader::getCacheKey() const {
+    return cacheKey;
+}
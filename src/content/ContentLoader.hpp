@@ -23,38 +23,65 @@ namespace dynamic {
     class List;
 }
 
+namespace content_cache {
+    struct PackDefs;
+}
+
 class ContentLoader {
     const ContentPack* pack;
     ContentPackRuntime* runtime;
     scriptenv env;
     ContentBuilder& builder;
     ContentPackStats* stats;
+    fs::path cacheFolder;
+    uint64_t cacheKey = 0;
 
+    /// @param root parsed definition file (nullptr if not exists)
     void loadBlock(
-        Block& def, const std::string& full, const std::string& name
+        Block& def, const std::string& full, const dynamic::Map* root
     );
     void loadItem(
-        ItemDef& def, const std::string& full, const std::string& name
+        ItemDef& def, const std::string& full, const dynamic::Map* root
     );
     void loadEntity(
-        EntityDef& def, const std::string& full, const std::string& name
+        EntityDef& def, const std::string& full, const dynamic::Map* root
     );
 
     static void loadCustomBlockModel(Block& def, dynamic::Map* primitives);
     static void loadBlockMaterial(BlockMaterial& def, const fs::path& file);
-    void loadBlock(
-        Block& def, const std::string& name, const fs::path& file
-    );
-    void loadItem(
-        ItemDef& def, const std::string& name, const fs::path& file
-    );
-    void loadEntity(
-        EntityDef& def, const std::string& name, const fs::path& file
+    void loadResources(
+        content_cache::PackDefs& defs, ResourceType type, dynamic::List* list
     );
-    void loadResources(ResourceType type, dynamic::List* list);
+
+    /// @brief Parse and register pack definitions
+    /// @param defs destination for copies of resolved definitions and
+    /// for parsed materials and resources
+    void parseDefinitions(content_cache::PackDefs& defs);
+    /// @brief Register definitions read from cache
+    void loadCachedDefinitions(const content_cache::PackDefs& defs);
 public:
     ContentLoader(ContentPack* pack, ContentBuilder& builder);
 
+    /// @brief Load definition properties from parsed file
+    /// (parent definition must be cloned before)
+    static void loadBlock(
+        Block& def, const std::string& name, const dynamic::Map& root
+    );
+    static void loadItem(
+        ItemDef& def, const std::string& name, const dynamic::Map& root
+    );
+    static void loadEntity(
+        EntityDef& def, const std::string& name, const dynamic::Map& root
+    );
+
+    /// @brief Enable compiled definitions cache
+    /// @param folder cache files folder
+    /// @param dependencyKey cache key of packs loaded before
+    void setCache(const fs::path& folder, uint64_t dependencyKey);
+
+    /// @return cache key of the pack and packs loaded before
+    uint64_t getCacheKey() const;
+
     bool fixPackIndices(
         const fs::path& folder,
         dynamic::Map* indicesRoot,
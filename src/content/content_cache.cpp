@@ -0,0 +1,453 @@
+#include "content_cache.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "ContentPack.hpp"
+#include "coders/byte_utils.hpp"
+#include "constants.hpp"
+#include "debug/Logger.hpp"
+#include "files/files.hpp"
+#include "items/ItemDef.hpp"
+#include "objects/EntityDef.hpp"
+#include "voxels/Block.hpp"
+
+namespace fs = std::filesystem;
+
+static debug::Logger logger("content-cache");
+
+static const char MAGIC[] = ".VECDEFS";
+static constexpr size_t MAGIC_SIZE = sizeof(MAGIC) - 1;
+/// @brief Must be increased on any change of the format or of definitions
+/// structures and loading
+static constexpr int32_t FORMAT_VERSION = 1;
+/// @brief magic, version, key, checksum
+static constexpr size_t HEADER_SIZE =
+    MAGIC_SIZE + sizeof(int32_t) + sizeof(int64_t) * 2;
+
+static constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+static constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+static void hash_bytes(uint64_t& hash, const void* data, size_t size) {
+    auto bytes = reinterpret_cast<const ubyte*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+}
+
+template <typename T>
+static void hash_value(uint64_t& hash, T value) {
+    hash_bytes(hash, &value, sizeof(T));
+}
+
+static void hash_string(uint64_t& hash, const std::string& str) {
+    hash_bytes(hash, str.data(), str.length() + 1);
+}
+
+content_cache::PackDefs::PackDefs() = default;
+content_cache::PackDefs::~PackDefs() = default;
+
+uint64_t content_cache::compute_key(
+    const ContentPack& pack, uint64_t dependencyKey
+) {
+    std::vector<fs::path> sources;
+    for (const auto& folderName :
+         {"blocks", "items", "entities", "block_materials"}) {
+        fs::path folder = pack.folder / fs::u8path(folderName);
+        if (!fs::is_directory(folder)) {
+            continue;
+        }
+        for (const auto& entry : fs::recursive_directory_iterator(folder)) {
+            if (entry.is_regular_file()) {
+                sources.push_back(entry.path());
+            }
+        }
+    }
+    // directory iteration order is unspecified
+    // (plain strings comparison is much faster than fs::path one)
+    std::sort(sources.begin(), sources.end(), [](const auto& a, const auto& b) {
+        return a.native() < b.native();
+    });
+    sources.push_back(pack.getContentFile());
+    sources.push_back(pack.folder / fs::u8path("resources.json"));
+
+    uint64_t hash = FNV_OFFSET;
+    hash_value(hash, FORMAT_VERSION);
+    hash_value(hash, ENGINE_VERSION_MAJOR);
+    hash_value(hash, ENGINE_VERSION_MINOR);
+    hash_value(hash, dependencyKey);
+    hash_string(hash, pack.id);
+    hash_string(hash, pack.version);
+    for (const auto& file : sources) {
+        const auto& name = file.native();
+        hash_bytes(hash, name.data(), (name.length() + 1) * sizeof(name[0]));
+
+        size_t length;
+        auto bytes = files::read_bytes(file, length);
+        if (bytes == nullptr) {
+            hash_value(hash, static_cast<uint64_t>(-1));
+            continue;
+        }
+        hash_value(hash, static_cast<uint64_t>(length));
+        hash_bytes(hash, bytes.get(), length);
+    }
+    return hash;
+}
+
+static void put_bool(ByteBuilder& builder, bool value) {
+    builder.put(static_cast<ubyte>(value));
+}
+
+static bool get_bool(ByteReader& reader) {
+    return reader.get() != 0;
+}
+
+static void put_vec3(ByteBuilder& builder, const glm::vec3& vec) {
+    builder.putFloat32(vec.x);
+    builder.putFloat32(vec.y);
+    builder.putFloat32(vec.z);
+}
+
+static glm::vec3 get_vec3(ByteReader& reader) {
+    float x = reader.getFloat32();
+    float y = reader.getFloat32();
+    float z = reader.getFloat32();
+    return {x, y, z};
+}
+
+static void put_aabb(ByteBuilder& builder, const AABB& aabb) {
+    put_vec3(builder, aabb.a);
+    put_vec3(builder, aabb.b);
+}
+
+static AABB get_aabb(ByteReader& reader) {
+    AABB aabb;
+    aabb.a = get_vec3(reader);
+    aabb.b = get_vec3(reader);
+    return aabb;
+}
+
+static void put_strings(
+    ByteBuilder& builder, const std::vector<std::string>& strings
+) {
+    builder.putInt32(strings.size());
+    for (const auto& str : strings) {
+        builder.put(str);
+    }
+}
+
+static std::vector<std::string> get_strings(ByteReader& reader) {
+    std::vector<std::string> strings(reader.getInt32());
+    for (auto& str : strings) {
+        str = reader.getString();
+    }
+    return strings;
+}
+
+template <typename T, typename Func>
+static void put_list(
+    ByteBuilder& builder, const std::vector<T>& list, Func put
+) {
+    builder.putInt32(list.size());
+    for (const auto& value : list) {
+        put(builder, value);
+    }
+}
+
+template <typename T, typename Func>
+static void get_list(ByteReader& reader, std::vector<T>& list, Func get) {
+    list.resize(reader.getInt32());
+    for (auto& value : list) {
+        value = get(reader);
+    }
+}
+
+static void put_block(ByteBuilder& builder, const Block& def) {
+    builder.put(def.name);
+    builder.put(def.caption);
+    for (const auto& texture : def.textureFaces) {
+        builder.put(texture);
+    }
+    put_strings(builder, def.modelTextures);
+    put_list(builder, def.modelBoxes, put_aabb);
+    put_list(builder, def.modelExtraPoints, put_vec3);
+    put_list(builder, def.modelUVs, [](auto& builder, const UVRegion& uv) {
+        builder.putFloat32(uv.u1);
+        builder.putFloat32(uv.v1);
+        builder.putFloat32(uv.u2);
+        builder.putFloat32(uv.v2);
+    });
+    builder.put(def.material);
+    builder.put(def.emission, 4);
+    builder.put(static_cast<ubyte>(def.size.x));
+    builder.put(static_cast<ubyte>(def.size.y));
+    builder.put(static_cast<ubyte>(def.size.z));
+    builder.put(def.drawGroup);
+    builder.put(static_cast<ubyte>(def.model));
+    put_bool(builder, def.lightPassing);
+    put_bool(builder, def.skyLightPassing);
+    put_bool(builder, def.shadeless);
+    put_bool(builder, def.ambientOcclusion);
+    put_bool(builder, def.obstacle);
+    put_bool(builder, def.selectable);
+    put_bool(builder, def.replaceable);
+    put_bool(builder, def.breakable);
+    put_bool(builder, def.rotatable);
+    put_bool(builder, def.grounded);
+    put_bool(builder, def.hidden);
+    put_list(builder, def.hitboxes, put_aabb);
+    builder.put(def.rotations.name);
+    builder.put(def.pickingItem);
+    builder.put(def.scriptName);
+    builder.put(def.uiLayout);
+    builder.putInt32(def.inventorySize);
+    builder.putInt32(def.tickInterval);
+}
+
+static const BlockRotProfile& get_rotation_profile(const std::string& name) {
+    for (const auto profile : {&BlockRotProfile::NONE,
+                               &BlockRotProfile::PIPE,
+                               &BlockRotProfile::PANE}) {
+        if (profile->name == name) {
+            return *profile;
+        }
+    }
+    throw std::runtime_error("unknown rotation profile " + name);
+}
+
+static std::unique_ptr<Block> get_block(ByteReader& reader) {
+    auto def = std::make_unique<Block>(reader.getString());
+    def->caption = reader.getString();
+    for (auto& texture : def->textureFaces) {
+        texture = reader.getString();
+    }
+    def->modelTextures = get_strings(reader);
+    get_list(reader, def->modelBoxes, get_aabb);
+    get_list(reader, def->modelExtraPoints, get_vec3);
+    get_list(reader, def->modelUVs, [](auto& reader) {
+        float u1 = reader.getFloat32();
+        float v1 = reader.getFloat32();
+        float u2 = reader.getFloat32();
+        float v2 = reader.getFloat32();
+        return UVRegion(u1, v1, u2, v2);
+    });
+    def->material = reader.getString();
+    for (auto& value : def->emission) {
+        value = reader.get();
+    }
+    def->size.x = static_cast<int8_t>(reader.get());
+    def->size.y = static_cast<int8_t>(reader.get());
+    def->size.z = static_cast<int8_t>(reader.get());
+    def->drawGroup = reader.get();
+    def->model = static_cast<BlockModel>(reader.get());
+    if (def->model > BlockModel::custom) {
+        throw std::runtime_error("invalid block model");
+    }
+    def->lightPassing = get_bool(reader);
+    def->skyLightPassing = get_bool(reader);
+    def->shadeless = get_bool(reader);
+    def->ambientOcclusion = get_bool(reader);
+    def->obstacle = get_bool(reader);
+    def->selectable = get_bool(reader);
+    def->replaceable = get_bool(reader);
+    def->breakable = get_bool(reader);
+    def->rotatable = get_bool(reader);
+    def->grounded = get_bool(reader);
+    def->hidden = get_bool(reader);
+    get_list(reader, def->hitboxes, get_aabb);
+    def->rotations = get_rotation_profile(reader.getString());
+    def->pickingItem = reader.getString();
+    def->scriptName = reader.getString();
+    def->uiLayout = reader.getString();
+    def->inventorySize = reader.getInt32();
+    def->tickInterval = reader.getInt32();
+    return def;
+}
+
+static void put_item(ByteBuilder& builder, const ItemDef& def) {
+    builder.put(def.name);
+    builder.put(def.caption);
+    builder.putInt32(def.stackSize);
+    put_bool(builder, def.generated);
+    builder.put(def.emission, 4);
+    builder.put(static_cast<ubyte>(def.iconType));
+    builder.put(def.icon);
+    builder.put(def.placingBlock);
+    builder.put(def.scriptName);
+}
+
+static std::unique_ptr<ItemDef> get_item(ByteReader& reader) {
+    auto def = std::make_unique<ItemDef>(reader.getString());
+    def->caption = reader.getString();
+    def->stackSize = reader.getInt32();
+    def->generated = get_bool(reader);
+    for (auto& value : def->emission) {
+        value = reader.get();
+    }
+    def->iconType = static_cast<item_icon_type>(reader.get());
+    if (def->iconType > item_icon_type::block) {
+        throw std::runtime_error("invalid item icon type");
+    }
+    def->icon = reader.getString();
+    def->placingBlock = reader.getString();
+    def->scriptName = reader.getString();
+    return def;
+}
+
+static void put_entity(ByteBuilder& builder, const EntityDef& def) {
+    builder.put(def.name);
+    put_strings(builder, def.components);
+    builder.put(static_cast<ubyte>(def.bodyType));
+    put_vec3(builder, def.hitbox);
+    put_list(builder, def.boxSensors, [](auto& builder, const auto& sensor) {
+        builder.putInt64(sensor.first);
+        put_aabb(builder, sensor.second);
+    });
+    put_list(
+        builder,
+        def.radialSensors,
+        [](auto& builder, const auto& sensor) {
+            builder.putInt64(sensor.first);
+            builder.putFloat32(sensor.second);
+        }
+    );
+    builder.put(def.skeletonName);
+    put_bool(builder, def.blocking);
+    put_bool(builder, def.save.enabled);
+    put_bool(builder, def.save.skeleton.textures);
+    put_bool(builder, def.save.skeleton.pose);
+    put_bool(builder, def.save.body.velocity);
+    put_bool(builder, def.save.body.settings);
+}
+
+static std::unique_ptr<EntityDef> get_entity(ByteReader& reader) {
+    auto def = std::make_unique<EntityDef>(reader.getString());
+    def->components = get_strings(reader);
+    def->bodyType = static_cast<BodyType>(reader.get());
+    if (def->bodyType > BodyType::DYNAMIC) {
+        throw std::runtime_error("invalid body type");
+    }
+    def->hitbox = get_vec3(reader);
+    get_list(reader, def->boxSensors, [](auto& reader) {
+        size_t index = reader.getInt64();
+        return std::make_pair(index, get_aabb(reader));
+    });
+    get_list(reader, def->radialSensors, [](auto& reader) {
+        size_t index = reader.getInt64();
+        return std::make_pair(index, reader.getFloat32());
+    });
+    def->skeletonName = reader.getString();
+    def->blocking = get_bool(reader);
+    def->save.enabled = get_bool(reader);
+    def->save.skeleton.textures = get_bool(reader);
+    def->save.skeleton.pose = get_bool(reader);
+    def->save.body.velocity = get_bool(reader);
+    def->save.body.settings = get_bool(reader);
+    return def;
+}
+
+static std::unique_ptr<content_cache::PackDefs> read_defs(
+    const ubyte* src, size_t size
+) {
+    ByteReader reader(src, size);
+    auto defs = std::make_unique<content_cache::PackDefs>();
+    get_list(reader, defs->blocks, get_block);
+    get_list(reader, defs->items, get_item);
+    get_list(reader, defs->entities, get_entity);
+    get_list(reader, defs->materials, [](auto& reader) {
+        auto material = std::make_unique<BlockMaterial>();
+        material->name = reader.getString();
+        material->stepsSound = reader.getString();
+        material->placeSound = reader.getString();
+        material->breakSound = reader.getString();
+        return material;
+    });
+    if (static_cast<size_t>(reader.getInt32()) != RESOURCE_TYPES_COUNT) {
+        throw std::runtime_error("resource types count mismatch");
+    }
+    for (auto& names : defs->resources) {
+        names = get_strings(reader);
+    }
+    if (reader.hasNext()) {
+        throw std::runtime_error("unexpected data after definitions");
+    }
+    return defs;
+}
+
+std::unique_ptr<content_cache::PackDefs> content_cache::read(
+    const fs::path& file, uint64_t key
+) {
+    if (!fs::is_regular_file(file)) {
+        return nullptr;
+    }
+    try {
+        auto bytes = files::read_bytes(file);
+        ByteReader reader(bytes.data(), bytes.size());
+        reader.checkMagic(MAGIC, MAGIC_SIZE);
+        if (reader.getInt32() != FORMAT_VERSION ||
+            static_cast<uint64_t>(reader.getInt64()) != key) {
+            return nullptr;
+        }
+        uint64_t checksum = reader.getInt64();
+        uint64_t hash = FNV_OFFSET;
+        hash_bytes(
+            hash, bytes.data() + HEADER_SIZE, bytes.size() - HEADER_SIZE
+        );
+        if (hash != checksum) {
+            throw std::runtime_error("checksum mismatch");
+        }
+        return read_defs(
+            bytes.data() + HEADER_SIZE, bytes.size() - HEADER_SIZE
+        );
+    } catch (const std::exception& err) {
+        logger.warning() << "damaged content cache " << file.u8string()
+                         << ": " << err.what();
+        return nullptr;
+    }
+}
+
+bool content_cache::write(
+    const fs::path& file, uint64_t key, const PackDefs& defs
+) {
+    ByteBuilder builder;
+    builder.put(reinterpret_cast<const ubyte*>(MAGIC), MAGIC_SIZE);
+    builder.putInt32(FORMAT_VERSION);
+    builder.putInt64(static_cast<int64_t>(key));
+    builder.putInt64(0);  // checksum
+
+    put_list(builder, defs.blocks, [](auto& builder, const auto& def) {
+        put_block(builder, *def);
+    });
+    put_list(builder, defs.items, [](auto& builder, const auto& def) {
+        put_item(builder, *def);
+    });
+    put_list(builder, defs.entities, [](auto& builder, const auto& def) {
+        put_entity(builder, *def);
+    });
+    put_list(builder, defs.materials, [](auto& builder, const auto& def) {
+        builder.put(def->name);
+        builder.put(def->stepsSound);
+        builder.put(def->placeSound);
+        builder.put(def->breakSound);
+    });
+    builder.putInt32(RESOURCE_TYPES_COUNT);
+    for (const auto& names : defs.resources) {
+        put_strings(builder, names);
+    }
+
+    uint64_t checksum = FNV_OFFSET;
+    hash_bytes(
+        checksum, builder.data() + HEADER_SIZE, builder.size() - HEADER_SIZE
+    );
+    builder.setInt64(HEADER_SIZE - sizeof(int64_t), checksum);
+
+    // written to temporary file first to never leave partial cache file
+    fs::path tmpfile = file;
+    tmpfile += ".tmp";
+    if (!files::write_bytes(tmpfile, builder.data(), builder.size())) {
+        return false;
+    }
+    std::error_code ec;
+    fs::rename(tmpfile, file, ec);
+    return !ec;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "content_fwd.hpp"
+
+class Block;
+struct BlockMaterial;
+struct ItemDef;
+struct EntityDef;
+struct ContentPack;
+
+/// @brief Compiled content definitions storage. Resolved definitions of a
+/// pack are stored on disk to skip parsing of unchanged packs
+namespace content_cache {
+    /// @brief Definitions loaded from a pack in order of registration
+    struct PackDefs {
+        std::vector<std::unique_ptr<Block>> blocks;
+        std::vector<std::unique_ptr<ItemDef>> items;
+        std::vector<std::unique_ptr<EntityDef>> entities;
+        std::vector<std::unique_ptr<BlockMaterial>> materials;
+        /// @brief Full names of resources by resource type
+        std::vector<std::string> resources[RESOURCE_TYPES_COUNT];
+
+        PackDefs();
+        ~PackDefs();
+    };
+
+    /// @brief Compute cache key of a pack
+    /// @param pack content pack
+    /// @param dependencyKey key of packs loaded before, definitions may
+    /// inherit or override their definitions
+    /// @return hash of the engine and pack versions and of the pack
+    /// definitions files content
+    uint64_t compute_key(const ContentPack& pack, uint64_t dependencyKey);
+
+    /// @brief Read pack definitions
+    /// @param file cache file
+    /// @param key expected cache key
+    /// @return nullptr if file does not exist, is outdated or damaged
+    std::unique_ptr<PackDefs> read(
+        const std::filesystem::path& file, uint64_t key
+    );
+
+    /// @brief Write pack definitions
+    /// @param file cache file
+    /// @param key cache key
+    /// @param defs resolved definitions
+    /// @return false if writing failed
+    bool write(
+        const std::filesystem::path& file, uint64_t key, const PackDefs& defs
+    );
+}
@@ -0,0 +1,62 @@
+#include "loading_order.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+
+static constexpr size_t UNRESOLVED = static_cast<size_t>(-1);
+static constexpr size_t VISITING = static_cast<size_t>(-2);
+
+std::vector<size_t> resolve_loading_order(
+    const std::vector<std::string>& names,
+    const std::vector<std::string>& parents,
+    const std::function<bool(const std::string&)>& exists
+) {
+    size_t count = names.size();
+    std::unordered_map<std::string, size_t> indices;
+    for (size_t i = 0; i < count; i++) {
+        indices.emplace(names[i], i);
+    }
+    // pass where the definition becomes registered
+    std::vector<size_t> passes(count, UNRESOLVED);
+    std::vector<size_t> stack;
+    for (size_t root = 0; root < count; root++) {
+        // walk up to the first resolved ancestor, then resolve back down
+        for (size_t i = root; passes[i] == UNRESOLVED;) {
+            const auto& parent = parents[i];
+            if (parent.empty() || exists(parent)) {
+                passes[i] = 0;
+                break;
+            }
+            const auto& found = indices.find(parent);
+            if (found == indices.end()) {
+                throw std::runtime_error(
+                    "Failed to find parent(" + parent + ") for " + names[i]
+                );
+            }
+            passes[i] = VISITING;
+            stack.push_back(i);
+            i = found->second;
+            if (passes[i] == VISITING) {
+                throw std::runtime_error(
+                    "Cyclic inheritance of " + names[i]
+                );
+            }
+        }
+        while (!stack.empty()) {
+            size_t i = stack.back();
+            stack.pop_back();
+            size_t parent = indices.at(parents[i]);
+            // parent registered later in the same pass is not visible
+            passes[i] = passes[parent] + (parent < i ? 0 : 1);
+        }
+    }
+    std::vector<size_t> order(count);
+    for (size_t i = 0; i < count; i++) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&passes](auto a, auto b) {
+        return passes[a] < passes[b];
+    });
+    return order;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+/// @brief Resolve registration order of pack definitions using the
+/// inheritance graph. Definitions are registered in the index order, a
+/// definition inheriting one defined later in the index is registered in
+/// the next pass after the parent (the same order as of sequential loading
+/// passes, so content indices are not changed)
+/// @param names full names of definitions in the index order
+/// @param parents parent full name of each definition (empty if none)
+/// @param exists checks if definition is already registered
+/// (by another pack or previous content type)
+/// @return definitions indices in registration order
+/// @throws std::runtime_error if a parent is missing or inheritance is
+/// cyclic
+std::vector<size_t> resolve_loading_order(
+    const std::vector<std::string>& names,
+    const std::vector<std::string>& parents,
+    const std::function<bool(const std::string&)>& exists
+);
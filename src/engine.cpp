@@ -28,6 +28,8 @@
 #include "logic/EngineController.hpp"
 #include "logic/CommandsInterpreter.hpp"
 #include "logic/scripting/scripting.hpp"
+#include "logic/scripting/scripting_gc.hpp"
+#include "logic/scripting/scripting_profiler.hpp"
 #include "util/listutil.hpp"
 #include "util/platform.hpp"
 #include "voxels/DefaultWorldGenerator.hpp"
@@ -191,6 +193,12 @@ void Engine::mainloop() {
                              settings.display.framerate.get());
 
         processPostRunnables();
+        scripting::gc::step(
+            settings.scripting.gcBudget.get() / 1e6,
+            settings.scripting.gcStepSize.get(),
+            settings.scripting.gcPause.get()
+        );
+        scripting::profiler::frame();
 
         Window::swapBuffers();
         Events::pollEvents();
@@ -264,6 +272,7 @@ void Engine::loadAssets() {
 
     auto new_assets = std::make_unique<Assets>();
     AssetsLoader loader(new_assets.get(), resPaths.get());
+    loader.setCacheFolder(paths->getCacheFolder());
     AssetsLoader::addDefaults(loader, content.get());
 
     // no need
@@ -313,15 +322,24 @@ void Engine::loadContent() {
     contentPacks = manager.getAll(names);
 
     std::vector<PathsRoot> resRoots;
+    auto cacheFolder = paths->getCacheFolder();
+    // chained as definitions may inherit or override previous packs ones
+    uint64_t cacheKey = 0;
+    auto loadPack = [&](ContentPack& pack) {
+        ContentLoader loader(&pack, contentBuilder);
+        loader.setCache(cacheFolder, cacheKey);
+        loader.load();
+        cacheKey = loader.getCacheKey();
+    };
     {
         auto pack = ContentPack::createCore(paths);
         resRoots.push_back({"core", pack.folder});
-        ContentLoader(&pack, contentBuilder).load();
+        loadPack(pack);
         load_configs(pack.folder);
     }
     for (auto& pack : contentPacks) {
         resRoots.push_back({pack.id, pack.folder});
-        ContentLoader(&pack, contentBuilder).load();
+        loadPack(pack);
         load_configs(pack.folder);
     } 
 
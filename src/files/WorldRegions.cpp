@@ -4,6 +4,7 @@
 #include <utility>
 #include <vector>
 
+#include "coders/binary_json.hpp"
 #include "coders/byte_utils.hpp"
 #include "coders/rle.hpp"
 #include "data/dynamic.hpp"
@@ -464,10 +465,10 @@ chunk_inventories_map WorldRegions::fetchInventories(int x, int z) {
     for (int i = 0; i < count; i++) {
         uint index = reader.getInt32();
         uint size = reader.getInt32();
-        auto map = json::from_binary(reader.pointer(), size);
+        json::BinaryDocument document(reader.pointer(), size);
         reader.skip(size);
         auto inv = std::make_shared<Inventory>(0, 0);
-        inv->deserialize(map.get());
+        inv->deserialize(document.getRoot());
         meta[index] = inv;
     }
     return meta;
@@ -479,11 +480,13 @@ dynamic::Map_sptr WorldRegions::fetchEntities(int x, int z) {
     if (data == nullptr) {
         return nullptr;
     }
-    auto map = json::from_binary(data, bytesSize);
-    if (map->size() == 0) {
+    json::BinaryDocument document(data, bytesSize);
+    const auto& root = document.getRoot();
+    // chunks without entities are not decoded
+    if (root.size() == 0 || root.list("data").size() == 0) {
         return nullptr;
     }
-    return map;
+    return root.toMap();
 }
 
 void WorldRegions::processRegionVoxels(int x, int z, const regionproc& func) {
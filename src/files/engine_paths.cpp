@@ -18,6 +18,7 @@ enum F_F_NAME {
     CONTENT_FOLDER,
     CONTROLS_FILE,
     SETTINGS_FILE,
+    CACHE_FOLDER,
 
     COUNT
 };
@@ -27,7 +28,7 @@ enum F_F_NAME {
 /// example:
 /// `std::filesystem::path settings = f_f_names[SETTINGS_FILE];`
 static std::array<std::string, F_F_NAME::COUNT> f_f_names {
-    "screenshots", "content", "controls.toml", "settings.toml"};
+    "screenshots", "content", "controls.toml", "settings.toml", "cache"};
 
 static std::filesystem::path toCanonic(std::filesystem::path path) {
     std::stack<std::string> parts;
@@ -97,6 +98,15 @@ std::filesystem::path EnginePaths::getNewScreenshotFile(const std::string& ext)
     return filename;
 }
 
+std::filesystem::path EnginePaths::getCacheFolder() {
+    auto folder =
+        userFilesFolder / std::filesystem::path(f_f_names[CACHE_FOLDER]);
+    if (!fs::is_directory(folder)) {
+        fs::create_directories(folder);
+    }
+    return folder;
+}
+
 std::filesystem::path EnginePaths::getWorldsFolder() {
     return userFilesFolder / std::filesystem::path("worlds");
 }
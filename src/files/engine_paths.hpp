@@ -34,6 +34,10 @@ public:
     std::filesystem::path getControlsFile();
     std::filesystem::path getSettingsFile();
 
+    /// @brief Get folder for generated files that may be safely deleted
+    /// (created if not exists)
+    std::filesystem::path getCacheFolder();
+
     void setContentPacks(std::vector<ContentPack>* contentPacks);
 
     std::vector<std::filesystem::path> scanForWorlds();
@@ -124,8 +124,22 @@ bool files::write_json(
 bool files::write_binary_json(
     const fs::path& filename, const dynamic::Map* obj, bool compression
 ) {
-    auto bytes = json::to_binary(obj, compression);
-    return files::write_bytes(filename, bytes.data(), bytes.size());
+    std::ofstream output(filename, std::ios::binary);
+    if (!output.is_open()) return false;
+    // document is written by chunks without full size buffer
+    auto write = [&output](const ubyte* data, size_t size) {
+        output.write(reinterpret_cast<const char*>(data), size);
+    };
+    if (!compression) {
+        json::write_binary(obj, write);
+        return output.good();
+    }
+    gzip::Encoder encoder(write);
+    json::write_binary(obj, [&encoder](const ubyte* data, size_t size) {
+        encoder.write(data, size);
+    });
+    encoder.finish();
+    return output.good();
 }
 
 std::shared_ptr<dynamic::Map> files::read_json(const fs::path& filename) {
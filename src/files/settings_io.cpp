@@ -75,6 +75,11 @@ SettingsHandler::SettingsHandler(EngineSettings& settings) {
     builder.add("language", &settings.ui.language);
     builder.add("world-preview-size", &settings.ui.worldPreviewSize);
 
+    builder.section("scripting");
+    builder.add("gc-budget", &settings.scripting.gcBudget);
+    builder.add("gc-step-size", &settings.scripting.gcStepSize);
+    builder.add("gc-pause", &settings.scripting.gcPause);
+
     builder.section("debug");
     builder.add("generator-test-mode", &settings.debug.generatorTestMode);
     builder.add("do-write-lights", &settings.debug.doWriteLights);
@@ -10,6 +10,7 @@
 #include "graphics/ui/elements/InputBindBox.hpp"
 #include "graphics/render/WorldRenderer.hpp"
 #include "logic/scripting/scripting.hpp"
+#include "logic/scripting/scripting_gc.hpp"
 #include "objects/Player.hpp"
 #include "objects/Entities.hpp"
 #include "objects/EntityDef.hpp"
@@ -78,6 +79,14 @@ std::shared_ptr<UINode> create_debug_panel(
     panel->add(create_label([]() {
         return L"lua-stack: " + std::to_wstring(scripting::get_values_on_stack());
     }));
+    panel->add(create_label([]() {
+        auto stats = scripting::gc::get_stats();
+        return L"lua-heap: " + std::to_wstring(stats.heapSize / 1024) +
+               L" KB gc-cycles: " + std::to_wstring(stats.cycles) +
+               L" gc-pause: " +
+               util::to_wstring(stats.lastPause * 1000.0, 2) + L" ms (max " +
+               util::to_wstring(stats.maxPause * 1000.0, 2) + L" ms)";
+    }));
     panel->add(create_label([=]() {
         auto& settings = engine->getSettings();
         bool culling = settings.graphics.frustumCulling.get();
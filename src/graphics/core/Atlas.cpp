@@ -3,7 +3,10 @@
 #include "Texture.hpp"
 #include "ImageData.hpp"
 #include "maths/LMPacker.hpp"
+#include "maths/SkylinePacker.hpp"
+#include "util/ParallelWorkers.hpp"
 
+#include <algorithm>
 #include <stdexcept>
 
 Atlas::Atlas(
@@ -22,7 +25,12 @@ Atlas::Atlas(
 Atlas::~Atlas() = default;
 
 void Atlas::prepare() {
-    texture = Texture::from(image.get());
+    texture = Texture::from(image.get(), mipmap.get());
+    mipmap.reset();
+}
+
+void Atlas::setMipmap(std::unique_ptr<ImageData> mipmap) {
+    this->mipmap = std::move(mipmap);
 }
 
 bool Atlas::has(const std::string& name) const {
@@ -49,6 +57,10 @@ ImageData* Atlas::getImage() const {
     return image.get();
 }
 
+const std::unordered_map<std::string, UVRegion>& Atlas::getRegions() const {
+    return regions;
+}
+
 void AtlasBuilder::add(const std::string& name, std::unique_ptr<ImageData> image) {
     entries.push_back(atlasentry{name, std::shared_ptr<ImageData>(image.release())});
     names.insert(name);
@@ -58,7 +70,56 @@ bool AtlasBuilder::has(const std::string& name) const {
     return names.find(name) != names.end();
 }
 
-std::unique_ptr<Atlas> AtlasBuilder::build(uint extrusion, bool prepare, uint maxResolution) {
+static std::runtime_error resolution_exceeded(uint maxResolution) {
+    return std::runtime_error(
+        "max atlas resolution "+std::to_string(maxResolution)+" exceeded"
+    );
+}
+
+static std::vector<rectangle> pack_lmpacker(
+    const uint sizes[], size_t count, uint extrusion, uint maxResolution,
+    uint& width, uint& height
+) {
+    LMPacker packer(sizes, count*2);
+    width = 32;
+    height = 32;
+    while (!packer.buildCompact(width, height, extrusion)) {
+        if (width > height) {
+            height *= 2;
+        } else {
+            width *= 2;
+        }
+        if (width > maxResolution || height > maxResolution) {
+            throw resolution_exceeded(maxResolution);
+        }
+    }
+    return packer.getResult();
+}
+
+static std::vector<rectangle> pack_skyline(
+    const uint sizes[], size_t count, uint extrusion, uint maxResolution,
+    uint& width, uint& height
+) {
+    SkylinePacker packer(sizes, count*2);
+    // images area is the lower bound, so single pass is enough usually
+    width = std::max(32u, packer.estimateWidth(extrusion));
+    while (width <= maxResolution) {
+        if (packer.build(width, maxResolution, extrusion)) {
+            height = 32;
+            while (height < packer.getHeight()) {
+                height *= 2;
+            }
+            return packer.getResult();
+        }
+        width *= 2;
+    }
+    throw resolution_exceeded(maxResolution);
+}
+
+std::unique_ptr<Atlas> AtlasBuilder::build(
+    uint extrusion, bool prepare, uint maxResolution,
+    util::ParallelWorkers* workers
+) {
     if (maxResolution == 0) {
         maxResolution = Texture::MAX_RESOLUTION;
     }
@@ -69,41 +130,56 @@ std::unique_ptr<Atlas> AtlasBuilder::build(uint extrusion, bool prepare, uint ma
         sizes[index++] = image->getWidth();
         sizes[index++] = image->getHeight();
     }
-    LMPacker packer(sizes.get(), entries.size()*2);
+    uint width = 0;
+    uint height = 0;
+    std::vector<rectangle> rects;
+    switch (packer) {
+        case AtlasPacker::lmpacker:
+            rects = pack_lmpacker(
+                sizes.get(), entries.size(), extrusion, maxResolution,
+                width, height
+            );
+            break;
+        case AtlasPacker::skyline:
+            rects = pack_skyline(
+                sizes.get(), entries.size(), extrusion, maxResolution,
+                width, height
+            );
+            break;
+    }
     sizes.reset(nullptr);
 
-    uint width = 32;
-    uint height = 32;
-    while (!packer.buildCompact(width, height, extrusion)) {
-        if (width > height) {
-            height *= 2;
-        } else {
-            width *= 2;
-        }
-        if (width > maxResolution || height > maxResolution) {
-            throw std::runtime_error(
-                "max atlas resolution "+std::to_string(maxResolution)+" exceeded"
-            );
+    auto canvas = std::make_unique<ImageData>(ImageFormat::rgba8888, width, height);
+    // packed rectangles with extrusion margins never overlap, so images
+    // may be blitted in any order
+    auto blit = [&](size_t begin, size_t end, uint) {
+        for (size_t i = begin; i < end; i++) {
+            const rectangle& rect = rects[i];
+            uint x = rect.x;
+            uint y = rect.y;
+            uint w = rect.width;
+            uint h = rect.height;
+            canvas->blit(entries[rect.idx].image.get(), x, y);
+            for (uint j = 0; j < extrusion; j++) {
+                canvas->extrude(x - j, y - j, w + j*2, h + j*2);
+            }
         }
+    };
+    if (workers) {
+        workers->run(rects.size(), blit);
+    } else {
+        blit(0, rects.size(), 0);
     }
 
-    auto canvas = std::make_unique<ImageData>(ImageFormat::rgba8888, width, height);
     std::unordered_map<std::string, UVRegion> regions;
-    std::vector<rectangle> rects = packer.getResult();
-    for (uint i = 0; i < entries.size(); i++) {
-        const rectangle& rect = rects[i];
-        const atlasentry& entry = entries[rect.idx];
+    float unitX = 1.0f / width;
+    float unitY = 1.0f / height;
+    for (const rectangle& rect : rects) {
         uint x = rect.x;
         uint y = rect.y;
         uint w = rect.width;
         uint h = rect.height;
-        canvas->blit(entry.image.get(), rect.x, rect.y);
-        for (uint j = 0; j < extrusion; j++) {
-            canvas->extrude(x - j, y - j, w + j*2, h + j*2);
-        }
-        float unitX = 1.0f / width;
-        float unitY = 1.0f / height;
-        regions[entry.name] = UVRegion(
+        regions[entries[rect.idx].name] = UVRegion(
             unitX * x, unitY * y, unitX * (x + w), unitY * (y + h)
         );
     }
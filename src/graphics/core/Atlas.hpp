@@ -13,9 +13,14 @@
 class ImageData;
 class Texture;
 
+namespace util {
+    class ParallelWorkers;
+}
+
 class Atlas {
     std::unique_ptr<Texture> texture;
     std::unique_ptr<ImageData> image;
+    std::unique_ptr<ImageData> mipmap;
     std::unordered_map<std::string, UVRegion> regions;
 public:
     /// @param image atlas raster
@@ -30,12 +35,26 @@ public:
 
     void prepare();
 
+    /// @brief Set mip level prepared on CPU to use in prepare()
+    /// instead of GL mipmap generation
+    void setMipmap(std::unique_ptr<ImageData> mipmap);
+
     bool has(const std::string& name) const;
     const UVRegion& get(const std::string& name) const;
     std::optional<UVRegion> getIf(const std::string& name) const;
 
     Texture* getTexture() const;
     ImageData* getImage() const;
+
+    const std::unordered_map<std::string, UVRegion>& getRegions() const;
+};
+
+/// @brief Atlas images packing algorithm
+enum class AtlasPacker {
+    /// @brief LMPacker, atlas size is doubled until all images fit
+    lmpacker,
+    /// @brief Skyline, single pass with width estimated from images area
+    skyline
 };
 
 struct atlasentry {
@@ -46,16 +65,27 @@ struct atlasentry {
 class AtlasBuilder {
     std::vector<atlasentry> entries;
     std::set<std::string> names;
+    AtlasPacker packer = AtlasPacker::lmpacker;
 public:
     AtlasBuilder() = default;
     void add(const std::string& name, std::unique_ptr<ImageData> image);
     bool has(const std::string& name) const;
     const std::set<std::string>& getNames() { return names; };
 
+    void setPacker(AtlasPacker packer) { this->packer = packer; }
+    AtlasPacker getPacker() const { return packer; }
+
     /// @brief Build atlas from all added images
     /// @param extrusion textures extrusion pixels 
     /// (greather is less mip-mapping artifacts)
     /// @param prepare generate atlas texture (calls .prepare()) 
     /// @param maxResolution max atlas resolution
-    std::unique_ptr<Atlas> build(uint extrusion, bool prepare=true, uint maxResolution=0);
+    /// @param workers workers used to blit images in parallel (optional).
+    /// Result does not depend on the number of workers
+    std::unique_ptr<Atlas> build(
+        uint extrusion,
+        bool prepare=true,
+        uint maxResolution=0,
+        util::ParallelWorkers* workers=nullptr
+    );
 };
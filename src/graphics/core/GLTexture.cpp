@@ -11,8 +11,13 @@ GLTexture::GLTexture(uint id, uint width, uint height)
     : Texture(width, height), id(id) {
 }
 
-GLTexture::GLTexture(const ubyte* data, uint width, uint height, ImageFormat imageFormat) 
-    : Texture(width, height) {
+GLTexture::GLTexture(
+    const ubyte* data,
+    uint width,
+    uint height,
+    ImageFormat imageFormat,
+    const ImageData* mipmap
+) : Texture(width, height) {
     glGenTextures(1, &id);
     glBindTexture(GL_TEXTURE_2D, id);
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
@@ -24,7 +29,17 @@ GLTexture::GLTexture(const ubyte* data, uint width, uint height, ImageFormat ima
     );
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-    glGenerateMipmap(GL_TEXTURE_2D);
+    if (mipmap) {
+        GLenum mipmapFormat = gl::to_glenum(mipmap->getFormat());
+        glTexImage2D(
+            GL_TEXTURE_2D, 1, mipmapFormat,
+            mipmap->getWidth(), mipmap->getHeight(), 0,
+            mipmapFormat, GL_UNSIGNED_BYTE,
+            static_cast<const GLvoid*>(mipmap->getData())
+        );
+    } else {
+        glGenerateMipmap(GL_TEXTURE_2D);
+    }
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1);
     glBindTexture(GL_TEXTURE_2D, 0);
 }
@@ -63,11 +78,15 @@ void GLTexture::setNearestFilter() {
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
-std::unique_ptr<GLTexture> GLTexture::from(const ImageData* image) {
+std::unique_ptr<GLTexture> GLTexture::from(
+    const ImageData* image, const ImageData* mipmap
+) {
     uint width = image->getWidth();
     uint height = image->getHeight();
     void* data = image->getData();
-    return std::make_unique<GLTexture>(static_cast<ubyte*>(data), width, height, image->getFormat());
+    return std::make_unique<GLTexture>(
+        static_cast<ubyte*>(data), width, height, image->getFormat(), mipmap
+    );
 }
 
 uint GLTexture::getId() const {
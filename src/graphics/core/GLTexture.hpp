@@ -7,7 +7,13 @@ protected:
     uint id;
 public:
     GLTexture(uint id, uint width, uint height);
-    GLTexture(const ubyte* data, uint width, uint height, ImageFormat format);
+    GLTexture(
+        const ubyte* data,
+        uint width,
+        uint height,
+        ImageFormat format,
+        const ImageData* mipmap = nullptr
+    );
     virtual ~GLTexture();
 
     virtual void bind() override;
@@ -23,5 +29,7 @@ public:
         return UVRegion(0.0f, 0.0f, 1.0f, 1.0f);
     }
 
-    static std::unique_ptr<GLTexture> from(const ImageData* image);
+    static std::unique_ptr<GLTexture> from(
+        const ImageData* image, const ImageData* mipmap = nullptr
+    );
 };
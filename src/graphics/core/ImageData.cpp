@@ -36,47 +36,33 @@ ImageData::ImageData(ImageFormat format, uint width, uint height, const ubyte* d
 
 ImageData::~ImageData() = default;
 
-void ImageData::flipX() {
+static uint get_comps(ImageFormat format) {
     switch (format) {
-        case ImageFormat::rgb888:
-        case ImageFormat::rgba8888: {
-            uint size = (format == ImageFormat::rgba8888) ? 4 : 3;
-            for (uint y = 0; y < height; y++) {
-                for (uint x = 0; x < width / 2; x++) {
-                    for (uint c = 0; c < size; c++) {
-                        ubyte temp = data[(y * width + x) * size + c];
-                        data[(y * width + x) * size + c] =
-                            data[(y * width + (width - x - 1)) * size + c];
-                        data[(y * width + (width - x - 1)) * size + c] = temp;
-                    }
-                }
-            }
-            break;
-        }
+        case ImageFormat::rgb888: return 3;
+        case ImageFormat::rgba8888: return 4;
         default:
-            throw std::runtime_error("format is not supported");
+            throw std::runtime_error("only unsigned byte formats supported");
     }
 }
 
-void ImageData::flipY() {
-    switch (format) {
-        case ImageFormat::rgb888:
-        case ImageFormat::rgba8888: {
-            uint size = (format == ImageFormat::rgba8888) ? 4 : 3;
-            for (uint y = 0; y < height/2; y++) {
-                for (uint x = 0; x < width; x++) {
-                    for (uint c = 0; c < size; c++) {
-                        ubyte temp = data[(y * width + x) * size + c];
-                        data[(y * width + x) * size + c] = 
-                               data[((height-y-1) * width + x) * size + c];
-                        data[((height-y-1) * width + x) * size + c] = temp;
-                    }
-                }
-            }
-            break;
+void ImageData::flipX() {
+    uint comps = get_comps(format);
+    size_t stride = width * comps;
+    for (uint y = 0; y < height; y++) {
+        ubyte* left = data.get() + y * stride;
+        ubyte* right = left + stride - comps;
+        for (; left < right; left += comps, right -= comps) {
+            std::swap_ranges(left, left + comps, right);
         }
-        default:
-            throw std::runtime_error("format is not supported");
+    }
+}
+
+void ImageData::flipY() {
+    size_t stride = width * get_comps(format);
+    for (uint y = 0; y < height / 2; y++) {
+        ubyte* top = data.get() + y * stride;
+        ubyte* bottom = data.get() + (height - y - 1) * stride;
+        std::swap_ranges(top, top + stride, bottom);
     }
 }
 
@@ -93,170 +79,153 @@ void ImageData::blit(const ImageData* image, int x, int y) {
     throw std::runtime_error("mismatching format");
 }
 
+/// @brief Source image rows and columns range visible on the target
+struct blit_range {
+    int x0, y0, x1, y1;
+
+    blit_range(const ImageData& dst, const ImageData& src, int x, int y) {
+        int dstwidth = dst.getWidth();
+        int dstheight = dst.getHeight();
+        x0 = std::max(0, -x);
+        y0 = std::max(0, -y);
+        x1 = std::min(static_cast<int>(src.getWidth()), dstwidth - x);
+        y1 = std::min(static_cast<int>(src.getHeight()), dstheight - y);
+    }
+
+    bool empty() const {
+        return x0 >= x1 || y0 >= y1;
+    }
+};
+
 void ImageData::blitRGB_on_RGBA(const ImageData* image, int x, int y) {
-    ubyte* source = image->getData();
+    blit_range range(*this, *image, x, y);
+    if (range.empty()) {
+        return;
+    }
     uint srcwidth = image->getWidth();
-    uint srcheight = image->getHeight();
-
-    for (uint srcy = std::max(0, -y);
-         srcy < std::min(srcheight, height - y);
-         srcy++) {
-        for (uint srcx = std::max(0, -x);
-             srcx < std::min(srcwidth, width - x);
-             srcx++) {
-            uint dstx = srcx + x;
-            uint dsty = srcy + y;
-            uint dstidx = (dsty * width + dstx) * 4;
-            uint srcidx = (srcy * srcwidth + srcx) * 3;
-            for (uint c = 0; c < 3; c++) {
-                data[dstidx + c] = source[srcidx + c];
-            }
-            data[dstidx + 3] = 255;
+    int count = range.x1 - range.x0;
+    for (int srcy = range.y0; srcy < range.y1; srcy++) {
+        const ubyte* src = image->getData() + (srcy * srcwidth + range.x0) * 3;
+        ubyte* dst = data.get() + ((srcy + y) * width + range.x0 + x) * 4;
+        for (int i = 0; i < count; i++) {
+            dst[i * 4] = src[i * 3];
+            dst[i * 4 + 1] = src[i * 3 + 1];
+            dst[i * 4 + 2] = src[i * 3 + 2];
+            dst[i * 4 + 3] = 255;
         }
     }
 }
 
 void ImageData::blitMatchingFormat(const ImageData* image, int x, int y) {
-    uint comps;
-    switch (format) {
-        case ImageFormat::rgb888: comps = 3; break;
-        case ImageFormat::rgba8888: comps = 4; break;
-        default:
-            throw std::runtime_error("only unsigned byte formats supported");    
+    uint comps = get_comps(format);
+    blit_range range(*this, *image, x, y);
+    if (range.empty()) {
+        return;
     }
-    ubyte* source = image->getData();
     uint srcwidth = image->getWidth();
-    uint srcheight = image->getHeight();
-
-    for (uint srcy = std::max(0, -y);
-         srcy < std::min(srcheight, height - y);
-         srcy++) {
-        for (uint srcx = std::max(0, -x);
-             srcx < std::min(srcwidth, width - x);
-             srcx++) {
-            uint dstx = srcx + x;
-            uint dsty = srcy + y;
-            uint dstidx = (dsty * width + dstx) * comps;
-            uint srcidx = (srcy * srcwidth + srcx) * comps;
-            for (uint c = 0; c < comps; c++) {
-                data[dstidx + c] = source[srcidx + c];
-            }
-        }
+    size_t rowsize = (range.x1 - range.x0) * comps;
+    for (int srcy = range.y0; srcy < range.y1; srcy++) {
+        std::memcpy(
+            data.get() + ((srcy + y) * width + range.x0 + x) * comps,
+            image->getData() + (srcy * srcwidth + range.x0) * comps,
+            rowsize
+        );
     }
 }
 
 /* Extrude rectangle zone border pixels out by 1 pixel.
    Used to remove atlas texture border artifacts */
 void ImageData::extrude(int x, int y, int w, int h) {
-    uint comps;
-    switch (format) {
-        case ImageFormat::rgb888: comps = 3; break;
-        case ImageFormat::rgba8888: comps = 4; break;
-        default:
-            throw std::runtime_error("only unsigned byte formats supported");    
-    }
+    uint comps = get_comps(format);
+    int iwidth = width;
+    int iheight = height;
     int rx = x + w - 1;
     int ry = y + h - 1;
-    // top-left pixel
-    if (x > 0 && static_cast<uint>(x) < width && 
-        y > 0 && static_cast<uint>(y) < height) {
-        uint srcidx = (y * width + x) * comps;
-        uint dstidx = ((y - 1) * width + x - 1) * comps;
-        for (uint c = 0; c < comps; c++) {
-            data[dstidx + c] = data[srcidx + c];
-        }
-    }
-    
-    // top-right pixel
-    if (rx >= 0 && static_cast<uint>(rx) < width-1 && 
-          y > 0 && static_cast<uint>(y) < height) {
-        uint srcidx = (y * width + rx) * comps;
-        uint dstidx = ((y - 1) * width + rx + 1) * comps;
-        for (uint c = 0; c < comps; c++) {
-            data[dstidx + c] = data[srcidx + c];
-        }
-    }
 
-    // bottom-left pixel
-    if (x > 0 && static_cast<uint>(x) < width && 
-        ry >= 0 && static_cast<uint>(ry) < height-1) {
-        uint srcidx = (ry * width + x) * comps;
-        uint dstidx = ((ry + 1) * width + x - 1) * comps;
-        for (uint c = 0; c < comps; c++) {
-            data[dstidx + c] = data[srcidx + c];
-        }
+    auto pixel = [this, comps](int px, int py) {
+        return data.get() + (py * width + px) * comps;
+    };
+    auto copy_pixel = [=](int dstx, int dsty, int srcx, int srcy) {
+        std::memcpy(pixel(dstx, dsty), pixel(srcx, srcy), comps);
+    };
+    bool left = x > 0 && x < iwidth;
+    bool top = y > 0 && y < iheight;
+    bool right = rx >= 0 && rx < iwidth - 1;
+    bool bottom = ry >= 0 && ry < iheight - 1;
+
+    // corners
+    if (left && top) copy_pixel(x - 1, y - 1, x, y);
+    if (right && top) copy_pixel(rx + 1, y - 1, rx, y);
+    if (left && bottom) copy_pixel(x - 1, ry + 1, x, ry);
+    if (right && bottom) copy_pixel(rx + 1, ry + 1, rx, ry);
+
+    int rowstart = std::max(y, 0);
+    int rowend = std::min(y + h, iheight);
+    int colstart = std::max(x, 0);
+    int colend = std::min(x + w, iwidth);
+    // left and right borders
+    for (int ey = rowstart; ey < rowend; ey++) {
+        if (left) copy_pixel(x - 1, ey, x, ey);
+        if (right) copy_pixel(rx + 1, ey, rx, ey);
     }
-    
-    // bottom-right pixel
-    if (rx >= 0 && static_cast<uint>(rx) < width-1 && 
-        ry >= 0 && static_cast<uint>(ry) < height-1) {
-        uint srcidx = (ry * width + rx) * comps;
-        uint dstidx = ((ry + 1) * width + rx + 1) * comps;
-        for (uint c = 0; c < comps; c++) {
-            data[dstidx + c] = data[srcidx + c];
+    // top and bottom borders
+    if (colstart < colend) {
+        size_t rowsize = (colend - colstart) * comps;
+        if (top) {
+            std::memcpy(pixel(colstart, y - 1), pixel(colstart, y), rowsize);
         }
-    }
-
-    // left border
-    if (x > 0 && static_cast<uint>(x) < width) {
-        for (uint ey = std::max(y, 0); static_cast<int>(ey) < y + h; ey++) {
-            uint srcidx = (ey * width + x) * comps;
-            uint dstidx = (ey * width + x - 1) * comps;
-            for (uint c = 0; c < comps; c++) {
-                data[dstidx + c] = data[srcidx + c];
-            }
+        if (bottom) {
+            std::memcpy(pixel(colstart, ry + 1), pixel(colstart, ry), rowsize);
         }
     }
+}
 
-    // top border
-    if (y > 0 && static_cast<uint>(y) < height) {
-        for (uint ex = std::max(x, 0); static_cast<int>(ex) < x + w; ex++) {
-            uint srcidx = (y * width + ex) * comps;
-            uint dstidx = ((y-1) * width + ex) * comps;
-            for (uint c = 0; c < comps; c++) {
-                data[dstidx + c] = data[srcidx + c];
-            }
-        }
+void ImageData::fixAlphaColor() {
+    // Fixing black transparent pixels for Mip-Mapping
+    if (width < 2 || height < 2) {
+        return;
     }
-    
-    // right border
-    if (rx >= 0 && static_cast<uint>(rx) < width-1) {
-        for (uint ey = std::max(y, 0); static_cast<int>(ey) < y + h; ey++) {
-            uint srcidx = (ey * width + rx) * comps;
-            uint dstidx = (ey * width + rx + 1) * comps;
-            for (uint c = 0; c < comps; c++) {
-                data[dstidx + c] = data[srcidx + c];
+    size_t stride = width * 4;
+    for (uint ly = 0; ly < height - 1; ly++) {
+        const ubyte* row = data.get() + ly * stride;
+        for (uint lx = 0; lx < width - 1; lx++) {
+            const ubyte* src = row + lx * 4;
+            if (src[3] == 0) {
+                continue;
             }
-        }
-    }
-
-    // bottom border
-    if (ry >= 0 && static_cast<uint>(ry) < height-1) {
-        for (uint ex = std::max(x, 0); static_cast<int>(ex) < x + w; ex++) {
-            uint srcidx = (ry * width + ex) * comps;
-            uint dstidx = ((ry+1) * width + ex) * comps;
-            for (uint c = 0; c < comps; c++) {
-                data[dstidx + c] = data[srcidx + c];
+            ubyte* right = data.get() + ly * stride + (lx + 1) * 4;
+            ubyte* below = data.get() + (ly + 1) * stride + lx * 4;
+            if (right[3] == 0) {
+                std::memcpy(right, src, 3);
+            }
+            if (below[3] == 0) {
+                std::memcpy(below, src, 3);
             }
         }
     }
 }
 
-void ImageData::fixAlphaColor() {
-    // Fixing black transparent pixels for Mip-Mapping
-    for (uint ly = 0; ly < height-1; ly++) {
-        for (uint lx = 0; lx < width-1; lx++) {
-            if (data[((ly) * width + lx) * 4 + 3]) {
-                for (int c = 0; c < 3; c++) {
-                    int val = data[((ly) + + lx) * 4 + c];
-                    if (data[((ly) * width + lx + 1) * 4 + 3] == 0)
-                        data[((ly) * width + lx + 1) * 4 + c] = val;
-                    if (data[((ly + 1) * width + lx) * 4 + 3] == 0)
-                        data[((ly + 1) * width + lx) * 4 + c] = val;
-                }
+std::unique_ptr<ImageData> ImageData::downsample() const {
+    uint comps = get_comps(format);
+    uint dstwidth = std::max(width / 2, 1U);
+    uint dstheight = std::max(height / 2, 1U);
+    auto image = std::make_unique<ImageData>(format, dstwidth, dstheight);
+    size_t stride = width * comps;
+    for (uint y = 0; y < dstheight; y++) {
+        const ubyte* row0 = data.get() + y * 2 * stride;
+        const ubyte* row1 = y * 2 + 1 < height ? row0 + stride : row0;
+        ubyte* dst = image->getData() + y * dstwidth * comps;
+        for (uint x = 0; x < dstwidth; x++) {
+            size_t left = x * 2 * comps;
+            size_t right = x * 2 + 1 < width ? left + comps : left;
+            for (uint c = 0; c < comps; c++) {
+                uint sum = row0[left + c] + row0[right + c] +
+                           row1[left + c] + row1[right + c];
+                dst[x * comps + c] = (sum + 2) / 4;
             }
         }
     }
+    return image;
 }
 
 std::unique_ptr<ImageData> add_atlas_margins(ImageData* image, int grid_size) {
@@ -29,6 +29,10 @@ public:
     void extrude(int x, int y, int w, int h);
     void fixAlphaColor();
 
+    /// @brief Create half-size image (2x2 box filter).
+    /// Used to prepare mip level without GL context
+    std::unique_ptr<ImageData> downsample() const;
+
     ubyte* getData() const {
         return data.get();
     }
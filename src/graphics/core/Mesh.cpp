@@ -4,10 +4,17 @@
 int Mesh::meshesCount = 0;
 int Mesh::drawCalls = 0;
 
-Mesh::Mesh(const float* vertexBuffer, size_t vertices, const int* indexBuffer, size_t indices, const vattr* attrs) : 
-    ibo(0),
+Mesh::Mesh(
+    const float* vertexBuffer,
+    size_t vertices,
+    const void* indexBuffer,
+    size_t indices,
+    size_t indexSize,
+    const vattr* attrs
+) : ibo(0),
     vertices(vertices),
-    indices(indices)
+    indices(indices),
+    indexSize(indexSize)
 {
     meshesCount++;
     vertexSize = 0;
@@ -18,7 +25,7 @@ Mesh::Mesh(const float* vertexBuffer, size_t vertices, const int* indexBuffer, s
     glGenVertexArrays(1, &vao);
     glGenBuffers(1, &vbo);
 
-    reload(vertexBuffer, vertices, indexBuffer, indices);
+    reload(vertexBuffer, vertices, indexBuffer, indices, indexSize);
 
     // attributes
     int offset = 0;
@@ -40,6 +47,20 @@ Mesh::~Mesh(){
 }
 
 void Mesh::reload(const float* vertexBuffer, size_t vertices, const int* indexBuffer, size_t indices){
+    reload(vertexBuffer, vertices, indexBuffer, indices, sizeof(int));
+}
+
+void Mesh::reload(const float* vertexBuffer, size_t vertices, const uint16_t* indexBuffer, size_t indices){
+    reload(vertexBuffer, vertices, indexBuffer, indices, sizeof(uint16_t));
+}
+
+void Mesh::reload(
+    const float* vertexBuffer,
+    size_t vertices,
+    const void* indexBuffer,
+    size_t indices,
+    size_t indexSize
+) {
     glBindVertexArray(vao);
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
     if (vertexBuffer != nullptr && vertices != 0) {
@@ -51,11 +72,13 @@ void Mesh::reload(const float* vertexBuffer, size_t vertices, const int* indexBu
     if (indexBuffer != nullptr && indices != 0) {
         if (ibo == 0) glGenBuffers(1, &ibo);
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(int) * indices, indexBuffer, GL_STATIC_DRAW);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexSize * indices, indexBuffer, GL_STATIC_DRAW);
     }
     else if (ibo != 0) {
         glDeleteBuffers(1, &ibo);
+        ibo = 0;
     }
+    this->indexSize = indexSize;
     this->vertices = vertices;
     this->indices = indices;
 }
@@ -64,7 +87,8 @@ void Mesh::draw(unsigned int primitive){
     drawCalls++;
     glBindVertexArray(vao);
     if (ibo != 0) {
-        glDrawElements(primitive, indices, GL_UNSIGNED_INT, 0);
+        GLenum type = indexSize == sizeof(uint16_t) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+        glDrawElements(primitive, indices, type, 0);
     }
     else {
         glDrawArrays(primitive, 0, vertices);
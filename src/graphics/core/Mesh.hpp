@@ -14,8 +14,16 @@ class Mesh {
     size_t vertices;
     size_t indices;
     size_t vertexSize;
+    size_t indexSize;
+
+    Mesh(const float* vertexBuffer, size_t vertices, const void* indexBuffer, size_t indices, size_t indexSize, const vattr* attrs);
+    void reload(const float* vertexBuffer, size_t vertices, const void* indexBuffer, size_t indices, size_t indexSize);
 public:
-    Mesh(const float* vertexBuffer, size_t vertices, const int* indexBuffer, size_t indices, const vattr* attrs);
+    Mesh(const float* vertexBuffer, size_t vertices, const int* indexBuffer, size_t indices, const vattr* attrs) :
+        Mesh(vertexBuffer, vertices, indexBuffer, indices, sizeof(int), attrs) {};
+    /// @brief Create mesh using 16-bit indices (vertices number must not exceed 65536)
+    Mesh(const float* vertexBuffer, size_t vertices, const uint16_t* indexBuffer, size_t indices, const vattr* attrs) :
+        Mesh(vertexBuffer, vertices, indexBuffer, indices, sizeof(uint16_t), attrs) {};
     Mesh(const float* vertexBuffer, size_t vertices, const vattr* attrs) :
         Mesh(vertexBuffer, vertices, nullptr, 0, attrs) {};
     ~Mesh();
@@ -26,6 +34,9 @@ public:
     /// @param indexBuffer indices buffer
     /// @param indices number of values in indices buffer
     void reload(const float* vertexBuffer, size_t vertices, const int* indexBuffer = nullptr, size_t indices = 0);
+
+    /// @brief Update GL vertex and 16-bit index buffers data
+    void reload(const float* vertexBuffer, size_t vertices, const uint16_t* indexBuffer, size_t indices);
     
     /// @brief Draw mesh with specified primitives type
     /// @param primitive primitives type
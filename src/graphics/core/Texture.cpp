@@ -1,6 +1,8 @@
 #include "Texture.hpp"
 #include "GLTexture.hpp"
 
-std::unique_ptr<Texture> Texture::from(const ImageData* image) {
-    return GLTexture::from(image);
+std::unique_ptr<Texture> Texture::from(
+    const ImageData* image, const ImageData* mipmap
+) {
+    return GLTexture::from(image, mipmap);
 }
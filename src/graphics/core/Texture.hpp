@@ -32,5 +32,9 @@ public:
 
     virtual uint getId() const = 0;
 
-    static std::unique_ptr<Texture> from(const ImageData* image);
+    /// @param image texture image
+    /// @param mipmap prepared mip level 1 (generated by GL if nullptr)
+    static std::unique_ptr<Texture> from(
+        const ImageData* image, const ImageData* mipmap = nullptr
+    );
 };
@@ -10,22 +10,55 @@
 #include "settings.hpp"
 
 #include <glm/glm.hpp>
+#include <algorithm>
 
 const uint BlocksRenderer::VERTEX_SIZE = 6;
 const glm::vec3 BlocksRenderer::SUN_VECTOR (0.411934f, 0.863868f, -0.279161f);
 
+/// @brief Number of faces the buffers are allocated for initially
+inline constexpr size_t INITIAL_FACES_CAPACITY = 1024;
+
+static const vattr CHUNK_ATTRS[]{ {3}, {2}, {1}, {0} };
+
+std::shared_ptr<Mesh> ChunkMeshData::createMesh() const {
+    if (useShortIndices) {
+        return std::make_shared<Mesh>(
+            vertices.data(), vertexCount, 
+            shortIndices.data(), indexCount, CHUNK_ATTRS
+        );
+    }
+    return std::make_shared<Mesh>(
+        vertices.data(), vertexCount, indices.data(), indexCount, CHUNK_ATTRS
+    );
+}
+
+ChunkMeshData ChunkMeshArenas::acquire() {
+    std::lock_guard lock(mutex);
+    if (freeArenas.empty()) {
+        return ChunkMeshData();
+    }
+    ChunkMeshData data = std::move(freeArenas.back());
+    freeArenas.pop_back();
+    return data;
+}
+
+void ChunkMeshArenas::release(ChunkMeshData data) {
+    std::lock_guard lock(mutex);
+    if (freeArenas.size() < limit) {
+        freeArenas.push_back(std::move(data));
+    }
+}
+
 BlocksRenderer::BlocksRenderer(
-    size_t capacity,
     const Content* content,
     const ContentGfxCache* cache,
-    const EngineSettings* settings
+    const EngineSettings* settings,
+    ChunkMeshArenas* arenas
 ) : content(content),
-    vertexBuffer(std::make_unique<float[]>(capacity)),
-    indexBuffer(std::make_unique<int[]>(capacity)),
+    arenas(arenas),
     vertexOffset(0),
     indexOffset(0),
     indexSize(0),
-    capacity(capacity),
     cache(cache),
     settings(settings) 
 {
@@ -43,6 +76,7 @@ BlocksRenderer::~BlocksRenderer() {
 void BlocksRenderer::vertex(
     const glm::vec3& coord, float u, float v, const glm::vec4& light
 ) {
+    float* vertexBuffer = meshData.vertices.data();
     vertexBuffer[vertexOffset++] = coord.x;
     vertexBuffer[vertexOffset++] = coord.y;
     vertexBuffer[vertexOffset++] = coord.z;
@@ -64,6 +98,7 @@ void BlocksRenderer::vertex(
 }
 
 void BlocksRenderer::index(int a, int b, int c, int d, int e, int f) {
+    int* indexBuffer = meshData.indices.data();
     indexBuffer[indexSize++] = indexOffset + a;
     indexBuffer[indexSize++] = indexOffset + b;
     indexBuffer[indexSize++] = indexOffset + c;
@@ -73,6 +108,19 @@ void BlocksRenderer::index(int a, int b, int c, int d, int e, int f) {
     indexOffset += 4;
 }
 
+void BlocksRenderer::reserveFace() {
+    auto& vertices = meshData.vertices;
+    if (vertexOffset + VERTEX_SIZE * 4 > vertices.size()) {
+        vertices.resize(std::max(
+            vertices.size() * 2, VERTEX_SIZE * 4 * INITIAL_FACES_CAPACITY
+        ));
+    }
+    auto& indices = meshData.indices;
+    if (indexSize + 6 > indices.size()) {
+        indices.resize(std::max(indices.size() * 2, 6 * INITIAL_FACES_CAPACITY));
+    }
+}
+
 /// @brief Add face with precalculated lights
 void BlocksRenderer::face(
     const glm::vec3& coord, 
@@ -84,10 +132,7 @@ void BlocksRenderer::face(
     const glm::vec4(&lights)[4],
     const glm::vec4& tint
 ) {
-    if (vertexOffset + BlocksRenderer::VERTEX_SIZE * 4 > capacity) {
-        overflow = true;
-        return;
-    }
+    reserveFace();
     auto X = axisX * w;
     auto Y = axisY * h;
     auto Z = axisZ * d;
@@ -124,10 +169,7 @@ void BlocksRenderer::faceAO(
     const UVRegion& region,
     bool lights
 ) {
-    if (vertexOffset + BlocksRenderer::VERTEX_SIZE * 4 > capacity) {
-        overflow = true;
-        return;
-    }
+    reserveFace();
 
     float s = 0.5f;
     if (lights) {
@@ -162,10 +204,7 @@ void BlocksRenderer::face(
     glm::vec4 tint,
     bool lights
 ) {
-    if (vertexOffset + BlocksRenderer::VERTEX_SIZE * 4 > capacity) {
-        overflow = true;
-        return;
-    }
+    reserveFace();
 
     float s = 0.5f;
     if (lights) {
@@ -193,6 +232,7 @@ void BlocksRenderer::tetragonicFace(
     const auto fp3 = (p3.x - 0.5f) * X + (p3.y - 0.5f) * Y + (p3.z - 0.5f) * Z;
     const auto fp4 = (p4.x - 0.5f) * X + (p4.y - 0.5f) * Y + (p4.z - 0.5f) * Z;
 
+    reserveFace();
     glm::vec4 tint(1.0f);
     if (lights) {
         auto dir = glm::cross(fp2 - fp1, fp3 - fp1);
@@ -504,9 +544,6 @@ void BlocksRenderer::render(const voxel* voxels) {
                 default:
                     break;
             }
-            if (overflow) {
-                return;
-            }
         }
     }
 }
@@ -517,7 +554,6 @@ void BlocksRenderer::build(const Chunk* chunk, const ChunksStorage* chunks) {
         chunk->x * CHUNK_W - voxelBufferPadding, 0,
         chunk->z * CHUNK_D - voxelBufferPadding);
     chunks->getVoxels(voxelsBuffer.get(), settings->graphics.backlight.get());
-    overflow = false;
     vertexOffset = 0;
     indexOffset = indexSize = 0;
     const voxel* voxels = chunk->voxels;
@@ -525,13 +561,35 @@ void BlocksRenderer::build(const Chunk* chunk, const ChunksStorage* chunks) {
 }
 
 std::shared_ptr<Mesh> BlocksRenderer::createMesh() {
-    const vattr attrs[]{ {3}, {2}, {1}, {0} };
     size_t vcount = vertexOffset / BlocksRenderer::VERTEX_SIZE;
     return std::make_shared<Mesh>(
-        vertexBuffer.get(), vcount, indexBuffer.get(), indexSize, attrs
+        meshData.vertices.data(), vcount, 
+        meshData.indices.data(), indexSize, CHUNK_ATTRS
     );
 }
 
+ChunkMeshData BlocksRenderer::createMeshData() {
+    size_t vcount = vertexOffset / BlocksRenderer::VERTEX_SIZE;
+    meshData.vertexCount = vcount;
+    meshData.indexCount = indexSize;
+    meshData.useShortIndices = vcount <= 0x10000;
+    if (meshData.useShortIndices) {
+        auto& shortIndices = meshData.shortIndices;
+        if (shortIndices.size() < indexSize) {
+            shortIndices.resize(indexSize);
+        }
+        const int* src = meshData.indices.data();
+        for (size_t i = 0; i < indexSize; i++) {
+            shortIndices[i] = static_cast<uint16_t>(src[i]);
+        }
+    }
+    ChunkMeshData data = std::move(meshData);
+    meshData = arenas ? arenas->acquire() : ChunkMeshData();
+    vertexOffset = 0;
+    indexOffset = indexSize = 0;
+    return data;
+}
+
 std::shared_ptr<Mesh> BlocksRenderer::render(const Chunk* chunk, const ChunksStorage* chunks) {
     build(chunk, chunks);
     return createMesh();
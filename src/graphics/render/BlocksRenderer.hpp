@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdlib.h>
+#include <mutex>
 #include <vector>
 #include <memory>
 #include <glm/glm.hpp>
@@ -22,17 +23,53 @@ class ContentGfxCache;
 struct EngineSettings;
 struct UVRegion;
 
+/// @brief Chunk mesh geometry built by BlocksRenderer.
+/// Move-only: buffers are passed between threads and recycled via
+/// ChunkMeshArenas without copying
+struct ChunkMeshData {
+    std::vector<float> vertices;
+    std::vector<int> indices;
+    /// @brief Used instead of indices if vertex count fits 16-bit indices
+    std::vector<uint16_t> shortIndices;
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+    bool useShortIndices = false;
+
+    ChunkMeshData() = default;
+    ChunkMeshData(ChunkMeshData&&) = default;
+    ChunkMeshData& operator=(ChunkMeshData&&) = default;
+    ChunkMeshData(const ChunkMeshData&) = delete;
+    ChunkMeshData& operator=(const ChunkMeshData&) = delete;
+
+    /// @brief Upload geometry to GPU (GL thread only)
+    std::shared_ptr<Mesh> createMesh() const;
+};
+
+/// @brief Thread-safe storage of released mesh buffers
+/// to reuse their capacity instead of allocating new ones
+class ChunkMeshArenas {
+    std::mutex mutex;
+    std::vector<ChunkMeshData> freeArenas;
+    size_t limit;
+public:
+    ChunkMeshArenas(size_t limit) : limit(limit) {}
+
+    /// @brief Get released buffers or empty ones if there are no free
+    ChunkMeshData acquire();
+
+    /// @brief Bring buffers back to the storage
+    void release(ChunkMeshData data);
+};
+
 class BlocksRenderer {
     static const glm::vec3 SUN_VECTOR;
     static const uint VERTEX_SIZE;
     const Content* const content;
-    std::unique_ptr<float[]> vertexBuffer;
-    std::unique_ptr<int[]> indexBuffer;
+    ChunkMeshArenas* arenas;
+    ChunkMeshData meshData;
     size_t vertexOffset;
     size_t indexOffset, indexSize;
-    size_t capacity;
     int voxelBufferPadding = 2;
-    bool overflow = false;
     const Chunk* chunk = nullptr;
     std::unique_ptr<VoxelsVolume> voxelsBuffer;
 
@@ -42,6 +79,8 @@ class BlocksRenderer {
 
     void vertex(const glm::vec3& coord, float u, float v, const glm::vec4& light);
     void index(int a, int b, int c, int d, int e, int f);
+    /// @brief Grow buffers if there is not enough space for another face
+    void reserveFace();
 
     void vertexAO(
         const glm::vec3& coord, float u, float v, 
@@ -142,11 +181,22 @@ class BlocksRenderer {
     glm::vec4 pickSoftLight(float x, float y, float z, const glm::ivec3& right, const glm::ivec3& up) const;
     void render(const voxel* voxels);
 public:
-    BlocksRenderer(size_t capacity, const Content* content, const ContentGfxCache* cache, const EngineSettings* settings);
+    /// @param arenas buffers storage used to replace buffers taken
+    /// by createMeshData (nullable)
+    BlocksRenderer(
+        const Content* content,
+        const ContentGfxCache* cache,
+        const EngineSettings* settings,
+        ChunkMeshArenas* arenas=nullptr
+    );
     virtual ~BlocksRenderer();
 
     void build(const Chunk* chunk, const ChunksStorage* chunks);
     std::shared_ptr<Mesh> render(const Chunk* chunk, const ChunksStorage* chunks);
     std::shared_ptr<Mesh> createMesh();
+
+    /// @brief Take built geometry out of the renderer.
+    /// Indices are packed to 16 bits when vertex count allows it
+    ChunkMeshData createMeshData();
     VoxelsVolume* getVoxelsBuffer() const;
 };
@@ -12,8 +12,6 @@
 
 static debug::Logger logger("chunks-render");
 
-const uint RENDERER_CAPACITY = 9 * 6 * 6 * 3000;
-
 class RendererWorker : public util::Worker<Chunk, RendererResult> {
     Level* level;
     BlocksRenderer renderer;
@@ -21,14 +19,16 @@ public:
     RendererWorker(
         Level* level, 
         const ContentGfxCache* cache, 
-        const EngineSettings* settings
+        const EngineSettings* settings,
+        ChunkMeshArenas* arenas
     ) : level(level), 
-        renderer(RENDERER_CAPACITY, level->content, cache, settings)
+        renderer(level->content, cache, settings, arenas)
     {}
 
     RendererResult operator()(const std::shared_ptr<Chunk>& chunk) override {
         renderer.build(chunk.get(), level->chunksStorage.get());
-        return RendererResult {glm::ivec2(chunk->x, chunk->z), &renderer};
+        return RendererResult {
+            glm::ivec2(chunk->x, chunk->z), renderer.createMeshData()};
     }
 };
 
@@ -37,18 +37,20 @@ ChunksRenderer::ChunksRenderer(
     const ContentGfxCache* cache, 
     const EngineSettings* settings
 ) : level(level),
+    arenas(std::thread::hardware_concurrency() * 2),
     threadPool(
         "chunks-render-pool",
-        [=](){return std::make_shared<RendererWorker>(level, cache, settings);}, 
-        [=](RendererResult& mesh){
-            meshes[mesh.key] = mesh.renderer->createMesh();
-            inwork.erase(mesh.key);
+        [=](){return std::make_shared<RendererWorker>(
+            level, cache, settings, &arenas);}, 
+        [=](RendererResult& result){
+            meshes[result.key] = result.mesh.createMesh();
+            inwork.erase(result.key);
+            arenas.release(std::move(result.mesh));
         })
 {
-    threadPool.setStandaloneResults(false);
     threadPool.setStopOnFail(false);
     renderer = std::make_unique<BlocksRenderer>(
-        RENDERER_CAPACITY, level->content, cache, settings
+        level->content, cache, settings
     );
     logger.info() << "created " << threadPool.getWorkersCount() << " workers";
 }
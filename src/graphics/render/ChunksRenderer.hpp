@@ -9,21 +9,22 @@
 #include "voxels/Block.hpp"
 #include "voxels/ChunksStorage.hpp"
 #include "util/ThreadPool.hpp"
+#include "BlocksRenderer.hpp"
 
 class Mesh;
 class Chunk;
 class Level;
-class BlocksRenderer;
 class ContentGfxCache;
 struct EngineSettings;
 
 struct RendererResult {
     glm::ivec2 key;
-    BlocksRenderer* renderer;
+    ChunkMeshData mesh;
 };
 
 class ChunksRenderer {
     Level* level;
+    ChunkMeshArenas arenas;
     std::unique_ptr<BlocksRenderer> renderer;
     std::unordered_map<glm::ivec2, std::shared_ptr<Mesh>> meshes;
     std::unordered_map<glm::ivec2, bool> inwork;
@@ -83,27 +83,16 @@ bool WorldRenderer::drawChunk(
     if (!chunk->flags.lighted) {
         return false;
     }
-    float distance = glm::distance(
-        camera->position,
-        glm::vec3(
-            (chunk->x + 0.5f) * CHUNK_W,
-            camera->position.y,
-            (chunk->z + 0.5f) * CHUNK_D
-        )
-    );
-    auto mesh = renderer->getOrRender(chunk, distance < CHUNK_W * 1.5f);
+    float dx = (chunk->x + 0.5f) * CHUNK_W - camera->position.x;
+    float dz = (chunk->z + 0.5f) * CHUNK_D - camera->position.z;
+    const float importantDistance = CHUNK_W * 1.5f;
+    bool important = dx * dx + dz * dz < importantDistance * importantDistance;
+    auto mesh = renderer->getOrRender(chunk, important);
     if (mesh == nullptr) {
         return false;
     }
-    if (culling) {
-        glm::vec3 min(chunk->x * CHUNK_W, chunk->bottom, chunk->z * CHUNK_D);
-        glm::vec3 max(
-            chunk->x * CHUNK_W + CHUNK_W,
-            chunk->top,
-            chunk->z * CHUNK_D + CHUNK_D
-        );
-
-        if (!frustumCulling->isBoxVisible(min, max)) return false;
+    if (culling && !chunksVisible[index]) {
+        return false;
     }
     glm::vec3 coord(chunk->x * CHUNK_W + 0.5f, 0.5f, chunk->z * CHUNK_D + 0.5f);
     glm::mat4 model = glm::translate(glm::mat4(1.0f), coord);
@@ -112,6 +101,79 @@ bool WorldRenderer::drawChunk(
     return true;
 }
 
+void WorldRenderer::updateChunksOrder(Chunks* chunks, Camera* camera) {
+    int cameraX = floordiv(
+        static_cast<int>(std::floor(camera->position.x)), CHUNK_W
+    );
+    int cameraZ = floordiv(
+        static_cast<int>(std::floor(camera->position.z)), CHUNK_D
+    );
+    // order depends on camera position relative to the matrix only
+    glm::ivec2 cameraPos(cameraX - chunks->ox, cameraZ - chunks->oz);
+    glm::ivec2 matrixSize(chunks->w, chunks->d);
+    if (chunksOrder.size() == chunks->volume && 
+        cameraPos == orderCameraPos && matrixSize == orderMatrixSize) {
+        return;
+    }
+    orderCameraPos = cameraPos;
+    orderMatrixSize = matrixSize;
+
+    int w = chunks->w;
+    chunksOrder.resize(chunks->volume);
+    for (size_t i = 0; i < chunks->volume; i++) {
+        chunksOrder[i] = i;
+    }
+    std::sort(
+        chunksOrder.begin(), chunksOrder.end(),
+        [w, cameraPos](size_t i, size_t j) {
+            int adx = static_cast<int>(i % w) - cameraPos.x;
+            int adz = static_cast<int>(i / w) - cameraPos.y;
+            int bdx = static_cast<int>(j % w) - cameraPos.x;
+            int bdz = static_cast<int>(j / w) - cameraPos.y;
+            int a = adx * adx + adz * adz;
+            int b = bdx * bdx + bdz * bdz;
+            return a > b || (a == b && i < j);
+        }
+    );
+}
+
+void WorldRenderer::cullChunks(Chunks* chunks, int x, int z, int w, int d) {
+    glm::vec3 min((chunks->ox + x) * CHUNK_W, 0, (chunks->oz + z) * CHUNK_D);
+    glm::vec3 max(
+        (chunks->ox + x + w) * CHUNK_W, CHUNK_H, (chunks->oz + z + d) * CHUNK_D
+    );
+    switch (frustumCulling->locateBox(min, max)) {
+        case Frustum::Location::outside:
+            return;
+        case Frustum::Location::inside:
+            for (int lz = z; lz < z + d; lz++) {
+                auto begin = chunksVisible.begin() + lz * chunks->w;
+                std::fill(begin + x, begin + x + w, true);
+            }
+            return;
+        case Frustum::Location::intersects:
+            break;
+    }
+    if (w == 1 && d == 1) {
+        size_t index = z * chunks->w + x;
+        const auto& chunk = chunks->chunks[index];
+        if (chunk == nullptr) {
+            return;
+        }
+        min.y = chunk->bottom;
+        max.y = chunk->top;
+        chunksVisible[index] = frustumCulling->isBoxVisible(min, max);
+        return;
+    }
+    if (w >= d) {
+        cullChunks(chunks, x, z, w / 2, d);
+        cullChunks(chunks, x + w / 2, z, w - w / 2, d);
+    } else {
+        cullChunks(chunks, x, z, w, d / 2);
+        cullChunks(chunks, x, z + d / 2, w, d - d / 2);
+    }
+}
+
 void WorldRenderer::drawChunks(Chunks* chunks, Camera* camera, Shader* shader) {
     auto assets = engine->getAssets();
     auto atlas = assets->get<Atlas>("blocks");
@@ -121,29 +183,18 @@ void WorldRenderer::drawChunks(Chunks* chunks, Camera* camera, Shader* shader) {
 
     // [warning] this whole method is not thread-safe for chunks
 
-    std::vector<size_t> indices;
-    for (size_t i = 0; i < chunks->volume; i++) {
-        if (chunks->chunks[i] == nullptr) continue;
-        indices.emplace_back(i);
-    }
-    float px = camera->position.x / static_cast<float>(CHUNK_W) - 0.5f;
-    float pz = camera->position.z / static_cast<float>(CHUNK_D) - 0.5f;
-    std::sort(indices.begin(), indices.end(), [chunks, px, pz](auto i, auto j) {
-        const auto a = chunks->chunks[i].get();
-        const auto b = chunks->chunks[j].get();
-        auto adx = (a->x - px);
-        auto adz = (a->z - pz);
-        auto bdx = (b->x - px);
-        auto bdz = (b->z - pz);
-        return (adx * adx + adz * adz > bdx * bdx + bdz * bdz);
-    });
+    updateChunksOrder(chunks, camera);
+
     bool culling = engine->getSettings().graphics.frustumCulling.get();
     if (culling) {
         frustumCulling->update(camera->getProjView());
+        chunksVisible.assign(chunks->volume, false);
+        cullChunks(chunks, 0, 0, chunks->w, chunks->d);
     }
     chunks->visible = 0;
-    for (size_t i = 0; i < indices.size(); i++) {
-        chunks->visible += drawChunk(indices[i], camera, shader, culling);
+    for (size_t index : chunksOrder) {
+        if (chunks->chunks[index] == nullptr) continue;
+        chunks->visible += drawChunk(index, camera, shader, culling);
     }
 }
 
@@ -8,6 +8,8 @@
 
 #include <glm/glm.hpp>
 
+#include "typedefs.hpp"
+
 class Level;
 class Player;
 class Camera;
@@ -41,9 +43,26 @@ class WorldRenderer {
     std::unique_ptr<ModelBatch> modelBatch;
     float timer = 0.0f;
 
+    /// @brief Chunks matrix indices sorted from far to near
+    std::vector<size_t> chunksOrder;
+    /// @brief Camera chunk position relative to the chunks matrix
+    /// chunksOrder was built for
+    glm::ivec2 orderCameraPos {};
+    glm::ivec2 orderMatrixSize {};
+    /// @brief Frustum culling results for chunks matrix indices
+    std::vector<ubyte> chunksVisible;
+
     bool drawChunk(size_t index, Camera* camera, Shader* shader, bool culling);
     void drawChunks(Chunks* chunks, Camera* camera, Shader* shader);
 
+    /// @brief Sort chunks matrix indices by distance if camera moved to
+    /// another chunk or the matrix was resized
+    void updateChunksOrder(Chunks* chunks, Camera* camera);
+
+    /// @brief Cull chunks matrix area recursively (quadtree traversal)
+    /// writing results to chunksVisible
+    void cullChunks(Chunks* chunks, int x, int z, int w, int d);
+
     /// @brief Render block selection lines
     void renderBlockSelection();
     
@@ -1,5 +1,6 @@
 #include "Inventory.hpp"
 
+#include "coders/binary_json.hpp"
 #include "content/ContentLUT.hpp"
 #include "data/dynamic.hpp"
 
@@ -62,6 +63,20 @@ void Inventory::deserialize(dynamic::Map* src) {
     }
 }
 
+void Inventory::deserialize(const json::BinaryMapView& src) {
+    id = src.get("id", 1);
+    size_t index = 0;
+    src.list("slots").forEach([this, &index](const json::BinaryView& value) {
+        auto item = value.asMap();
+        if (index == slots.size()) {
+            slots.emplace_back();
+        }
+        itemid_t id = item.get("id", ITEM_EMPTY);
+        itemcount_t count = item.get("count", 0);
+        slots[index++].set(ItemStack(id, count));
+    });
+}
+
 std::unique_ptr<dynamic::Map> Inventory::serialize() const {
     auto map = std::make_unique<dynamic::Map>();
     map->put("id", id);
@@ -11,6 +11,10 @@ namespace dynamic {
     class Map;
 }
 
+namespace json {
+    class BinaryMapView;
+}
+
 class ContentLUT;
 class ContentIndices;
 
@@ -39,6 +43,9 @@ public:
 
     /* deserializing inventory */
     void deserialize(dynamic::Map* src) override;
+    /* deserializing inventory from encoded binary json without decoding
+       whole tree */
+    void deserialize(const json::BinaryMapView& src);
     /* serializing inventory */
     std::unique_ptr<dynamic::Map> serialize() const override;
 
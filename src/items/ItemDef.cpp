@@ -9,7 +9,7 @@ void ItemDef::cloneTo(ItemDef& dst) {
     dst.caption = caption;
     dst.stackSize = stackSize;
     dst.generated = generated;
-    std::copy(&emission[0], &emission[3], dst.emission);
+    std::copy(&emission[0], &emission[4], dst.emission);
     dst.iconType = iconType;
     dst.icon = icon;
     dst.placingBlock = placingBlock;
@@ -12,6 +12,14 @@ struct item_funcs_set {
     bool on_block_break_by : 1;
 };
 
+/// @brief Item script functions resolved on script load
+/// (nullptr if not defined)
+struct item_callbacks {
+    scriptfunc on_use;
+    scriptfunc on_use_on_block;
+    scriptfunc on_block_break_by;
+};
+
 enum class item_icon_type {
     none,    // invisible (core:empty) must not be rendered
     sprite,  // textured quad: icon is `atlas_name:texture_name`
@@ -39,6 +47,7 @@ struct ItemDef {
         itemid_t id;
         blockid_t placingBlock;
         item_funcs_set funcsset {};
+        item_callbacks callbacks {};
         bool emissive = false;
     } rt {};
 
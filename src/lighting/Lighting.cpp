@@ -9,6 +9,7 @@
 #include "constants.hpp"
 #include "util/timeutil.hpp"
 
+#include <algorithm>
 #include <memory>
 
 Lighting::Lighting(const Content* content, Chunks* chunks) 
@@ -201,3 +202,77 @@ void Lighting::onBlockSet(int x, int y, int z, blockid_t id){
         }
     }
 }
+
+void Lighting::onBlocksSet(std::vector<glm::ivec3> positions) {
+    // top to bottom order to fill sky light columns from above
+    std::sort(
+        positions.begin(),
+        positions.end(),
+        [](const glm::ivec3& a, const glm::ivec3& b) { return a.y > b.y; }
+    );
+    const auto& blocks = content->getIndices()->blocks;
+    for (const auto& pos : positions) {
+        int x = pos.x, y = pos.y, z = pos.z;
+        solverR->remove(x, y, z);
+        solverG->remove(x, y, z);
+        solverB->remove(x, y, z);
+
+        voxel* vox = chunks->get(x, y, z);
+        if (vox == nullptr || vox->id == 0 ||
+            blocks.require(vox->id).skyLightPassing) {
+            continue;
+        }
+        solverS->remove(x, y, z);
+        for (int i = y - 1; i >= 0; i--) {
+            solverS->remove(x, i, z);
+            voxel* below = chunks->get(x, i - 1, z);
+            if (i == 0 || below == nullptr || below->id != 0) {
+                break;
+            }
+        }
+    }
+    solverR->solve();
+    solverG->solve();
+    solverB->solve();
+    solverS->solve();
+
+    LightSolver* solvers[] {
+        solverR.get(), solverG.get(), solverB.get(), solverS.get()};
+    for (const auto& pos : positions) {
+        int x = pos.x, y = pos.y, z = pos.z;
+        voxel* vox = chunks->get(x, y, z);
+        if (vox == nullptr) {
+            continue;
+        }
+        if (vox->id == 0) {
+            if (chunks->getLight(x, y + 1, z, 3) == 0xF) {
+                for (int i = y; i >= 0; i--) {
+                    voxel* column = chunks->get(x, i, z);
+                    if (column == nullptr || column->id != 0) {
+                        break;
+                    }
+                    solverS->add(x, i, z, 0xF);
+                }
+            }
+            for (auto solver : solvers) {
+                solver->add(x, y + 1, z);
+                solver->add(x, y - 1, z);
+                solver->add(x + 1, y, z);
+                solver->add(x - 1, y, z);
+                solver->add(x, y, z + 1);
+                solver->add(x, y, z - 1);
+            }
+        } else {
+            const auto& block = blocks.require(vox->id);
+            if (block.emission[0] || block.emission[1] || block.emission[2]) {
+                solverR->add(x, y, z, block.emission[0]);
+                solverG->add(x, y, z, block.emission[1]);
+                solverB->add(x, y, z, block.emission[2]);
+            }
+        }
+    }
+    solverR->solve();
+    solverG->solve();
+    solverB->solve();
+    solverS->solve();
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <glm/glm.hpp>
+#include <vector>
+
 #include "typedefs.hpp"
 
 class Content;
@@ -24,5 +27,10 @@ public:
     void onChunkLoaded(int cx, int cz, bool expand);
     void onBlockSet(int x, int y, int z, blockid_t id);
 
+    /// @brief Update lighting after a group of blocks is set. Unlike
+    /// onBlockSet calls, light is solved twice for the whole group
+    /// @param positions positions of the set blocks
+    void onBlocksSet(std::vector<glm::ivec3> positions);
+
     static void prebuildSkyLight(Chunk* chunk, const ContentIndices* indices);
 };
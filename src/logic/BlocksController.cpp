@@ -1,5 +1,8 @@
 #include "BlocksController.hpp"
 
+#include <algorithm>
+
+#include "constants.hpp"
 #include "content/Content.hpp"
 #include "items/Inventories.hpp"
 #include "items/Inventory.hpp"
@@ -33,6 +36,56 @@ void BlocksController::updateSides(int x, int y, int z) {
     updateBlock(x, y, z + 1);
 }
 
+size_t BlocksController::setRegion(
+    glm::ivec3 origin,
+    glm::ivec3 size,
+    const std::vector<voxel>& voxels,
+    bool noupdate
+) {
+    std::vector<glm::ivec3> positions;
+    std::vector<bool> changed(voxels.size());
+    for (int y = 0; y < size.y; y++) {
+        for (int z = 0; z < size.z; z++) {
+            for (int x = 0; x < size.x; x++) {
+                size_t index = (y * size.z + z) * size.x + x;
+                const auto& vox = voxels[index];
+                glm::ivec3 pos = origin + glm::ivec3(x, y, z);
+                if (vox.id == BLOCK_VOID || chunks->get(pos) == nullptr) {
+                    continue;
+                }
+                chunks->set(pos.x, pos.y, pos.z, vox.id, vox.state);
+                positions.push_back(pos);
+                changed[index] = true;
+            }
+        }
+    }
+    size_t count = positions.size();
+    lighting->onBlocksSet(std::move(positions));
+    if (noupdate || count == 0) {
+        return count;
+    }
+    auto isChanged = [&](int x, int y, int z) {
+        if (x < 0 || y < 0 || z < 0 || x >= size.x || y >= size.y ||
+            z >= size.z) {
+            return false;
+        }
+        return static_cast<bool>(changed[(y * size.z + z) * size.x + x]);
+    };
+    // update every block adjacent to a changed one once
+    for (int y = -1; y <= size.y; y++) {
+        for (int z = -1; z <= size.z; z++) {
+            for (int x = -1; x <= size.x; x++) {
+                if (isChanged(x - 1, y, z) || isChanged(x + 1, y, z) ||
+                    isChanged(x, y - 1, z) || isChanged(x, y + 1, z) ||
+                    isChanged(x, y, z - 1) || isChanged(x, y, z + 1)) {
+                    updateBlock(origin.x + x, origin.y + y, origin.z + z);
+                }
+            }
+        }
+    }
+    return count;
+}
+
 void BlocksController::breakBlock(
     Player* player, const Block& def, int x, int y, int z
 ) {
@@ -113,7 +166,18 @@ void BlocksController::randomTick(
             int bz = random.rand() % CHUNK_D;
             const voxel& vox = chunk.voxels[(by * CHUNK_D + bz) * CHUNK_W + bx];
             auto& block = indices->blocks.require(vox.id);
-            if (block.rt.funcsset.randupdate) {
+            if (block.rt.funcsset.randupdatebatch) {
+                if (randomUpdates.size() <= vox.id) {
+                    randomUpdates.resize(indices->blocks.count());
+                }
+                auto& positions = randomUpdates[vox.id];
+                if (positions.empty()) {
+                    randomUpdatesIds.push_back(vox.id);
+                }
+                positions.emplace_back(
+                    chunk.x * CHUNK_W + bx, by, chunk.z * CHUNK_D + bz
+                );
+            } else if (block.rt.funcsset.randupdate) {
                 scripting::random_update_block(
                     block, chunk.x * CHUNK_W + bx, by, chunk.z * CHUNK_D + bz
                 );
@@ -141,6 +205,14 @@ void BlocksController::randomTick(int tickid, int parts) {
             randomTick(*chunk, segments, indices);
         }
     }
+    // deterministic dispatch order
+    std::sort(randomUpdatesIds.begin(), randomUpdatesIds.end());
+    for (blockid_t id : randomUpdatesIds) {
+        auto& positions = randomUpdates[id];
+        scripting::random_update_blocks(indices->blocks.require(id), positions);
+        positions.clear();
+    }
+    randomUpdatesIds.clear();
 }
 
 int64_t BlocksController::createBlockInventory(int x, int y, int z) {
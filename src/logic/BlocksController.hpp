@@ -32,6 +32,11 @@ class BlocksController {
     util::Clock worldTickClock;
     uint padding;
     FastRandom random;
+    /// @brief Random updates positions collected during a tick for block
+    /// types having batched random update callback (indexed by block id)
+    std::vector<std::vector<glm::ivec3>> randomUpdates;
+    /// @brief Ids of block types having collected random updates
+    std::vector<blockid_t> randomUpdatesIds;
     std::vector<on_block_interaction> blockInteractionCallbacks;
 public:
     BlocksController(Level* level, uint padding);
@@ -39,6 +44,21 @@ public:
     void updateSides(int x, int y, int z);
     void updateBlock(int x, int y, int z);
 
+    /// @brief Set blocks of the box area. Lighting is updated once for all
+    /// changed blocks, neighbour blocks are updated once each
+    /// @param origin area minimal position
+    /// @param size area size
+    /// @param voxels area voxels in (y * size.z + z) * size.x + x order.
+    /// Voxels with BLOCK_VOID id are skipped
+    /// @param noupdate do not update blocks around changed ones
+    /// @return number of changed blocks
+    size_t setRegion(
+        glm::ivec3 origin,
+        glm::ivec3 size,
+        const std::vector<voxel>& voxels,
+        bool noupdate
+    );
+
     void breakBlock(Player* player, const Block& def, int x, int y, int z);
     void placeBlock(
         Player* player, const Block& def, blockstate state, int x, int y, int z
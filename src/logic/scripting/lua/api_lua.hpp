@@ -15,6 +15,7 @@
 
 // Libraries
 extern const luaL_Reg audiolib[];
+extern const luaL_Reg bjsonlib[];
 extern const luaL_Reg blocklib[];
 extern const luaL_Reg cameralib[];
 extern const luaL_Reg consolelib[];
@@ -30,12 +31,15 @@ extern const luaL_Reg jsonlib[];
 extern const luaL_Reg mat4lib[];
 extern const luaL_Reg packlib[];
 extern const luaL_Reg playerlib[];
+extern const luaL_Reg profilerlib[];
 extern const luaL_Reg quatlib[];  // quat.cpp
+extern const luaL_Reg taskslib[];
 extern const luaL_Reg timelib[];
 extern const luaL_Reg tomllib[];
 extern const luaL_Reg vec2lib[];  // vecn.cpp
 extern const luaL_Reg vec3lib[];  // vecn.cpp
 extern const luaL_Reg vec4lib[];  // vecn.cpp
+extern const luaL_Reg workerslib[];
 extern const luaL_Reg worldlib[];
 
 // Components
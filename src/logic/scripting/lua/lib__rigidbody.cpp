@@ -39,6 +39,7 @@ static int l_get_size(lua::State* L) {
 static int l_set_size(lua::State* L) {
     if (auto entity = get_entity(L, 1)) {
         entity->getRigidbody().hitbox.halfsize = lua::tovec3(L, 2) * 0.5f;
+        scripting::controller->getLevel()->entities->updateIndex(*entity);
     }
     return 0;
 }
@@ -0,0 +1,30 @@
+#include "coders/binary_json.hpp"
+#include "data/dynamic.hpp"
+#include "api_lua.hpp"
+
+static int l_bjson_to_bytes(lua::State* L) {
+    auto value = lua::tovalue(L, 1);
+    if (auto mapptr = std::get_if<dynamic::Map_sptr>(&value)) {
+        bool compress = lua::isnoneornil(L, 2) || lua::toboolean(L, 2);
+        return lua::newuserdata<lua::Bytearray>(
+            L, json::to_binary(mapptr->get(), compress)
+        );
+    } else {
+        throw std::runtime_error("table expected");
+    }
+}
+
+static int l_bjson_from_bytes(lua::State* L) {
+    if (auto bytearray = lua::touserdata<lua::Bytearray>(L, 1)) {
+        auto& bytes = bytearray->data();
+        auto map = json::from_binary(bytes.data(), bytes.size());
+        return lua::pushvalue(L, map);
+    } else {
+        throw std::runtime_error("bytearray expected");
+    }
+}
+
+const luaL_Reg bjsonlib[] = {
+    {"tobytes", lua::wrap<l_bjson_to_bytes>},
+    {"frombytes", lua::wrap<l_bjson_from_bytes>},
+    {NULL, NULL}};
@@ -1,3 +1,4 @@
+#include "constants.hpp"
 #include "content/Content.hpp"
 #include "lighting/Lighting.hpp"
 #include "logic/BlocksController.hpp"
@@ -111,6 +112,114 @@ static int l_get(lua::State* L) {
     return lua::pushinteger(L, id);
 }
 
+/// @brief Maximal number of voxels in get_region/set_region area
+static constexpr size_t MAX_REGION_VOLUME = 1 << 24;
+
+static glm::ivec3 require_region_size(lua::State* L, int idx) {
+    glm::ivec3 size(
+        lua::tointeger(L, idx),
+        lua::tointeger(L, idx + 1),
+        lua::tointeger(L, idx + 2)
+    );
+    if (size.x <= 0 || size.y <= 0 || size.z <= 0) {
+        throw std::runtime_error("region size must be positive");
+    }
+    if (static_cast<size_t>(size.x) * size.y * size.z > MAX_REGION_VOLUME) {
+        throw std::runtime_error("region is too big");
+    }
+    return size;
+}
+
+/// @brief Read integer from array at index or return fill value if the
+/// argument is not a table
+/// @param missing value returned for missing array elements
+static lua::Integer region_value(
+    lua::State* L,
+    int idx,
+    size_t index,
+    lua::Integer fill,
+    lua::Integer missing
+) {
+    if (!lua::istable(L, idx)) {
+        return fill;
+    }
+    lua::rawgeti(L, index + 1, idx);
+    auto value = lua::isnumber(L, -1) ? lua::tointeger(L, -1) : missing;
+    lua::pop(L);
+    return value;
+}
+
+/// block.get_region(x, y, z, w, h, d, states: bool) -> ids[, states]
+/// ids are -1 where chunks are not loaded
+static int l_get_region(lua::State* L) {
+    glm::ivec3 origin(
+        lua::tointeger(L, 1), lua::tointeger(L, 2), lua::tointeger(L, 3)
+    );
+    auto size = require_region_size(L, 4);
+    bool withStates = lua::toboolean(L, 7);
+    size_t volume = static_cast<size_t>(size.x) * size.y * size.z;
+
+    lua::createtable(L, volume, 0);
+    int idsTable = lua::gettop(L);
+    int statesTable = 0;
+    if (withStates) {
+        lua::createtable(L, volume, 0);
+        statesTable = lua::gettop(L);
+    }
+    auto chunks = level->chunks.get();
+    int index = 1;
+    for (int y = 0; y < size.y; y++) {
+        for (int z = 0; z < size.z; z++) {
+            for (int x = 0; x < size.x; x++, index++) {
+                auto vox = chunks->get(origin + glm::ivec3(x, y, z));
+                lua::pushinteger(L, vox ? vox->id : -1);
+                lua::rawseti(L, index, idsTable);
+                if (withStates) {
+                    lua::pushinteger(L, vox ? blockstate2int(vox->state) : 0);
+                    lua::rawseti(L, index, statesTable);
+                }
+            }
+        }
+    }
+    return withStates ? 2 : 1;
+}
+
+/// block.set_region(x, y, z, w, h, d, ids, states, noupdate) -> int
+/// ids and states are integers for the whole area or arrays.
+/// Negative or nil ids are skipped. Returns number of changed blocks
+static int l_set_region(lua::State* L) {
+    glm::ivec3 origin(
+        lua::tointeger(L, 1), lua::tointeger(L, 2), lua::tointeger(L, 3)
+    );
+    auto size = require_region_size(L, 4);
+    if (!lua::istable(L, 7) && !lua::isnumber(L, 7)) {
+        throw std::runtime_error("ids array or integer expected");
+    }
+    auto fillId = lua::istable(L, 7) ? 0 : lua::tointeger(L, 7);
+    auto fillStates = lua::istable(L, 8) ? 0 : lua::tointeger(L, 8);
+    bool noupdate = lua::toboolean(L, 9);
+    size_t volume = static_cast<size_t>(size.x) * size.y * size.z;
+
+    auto count = indices->blocks.count();
+    std::vector<voxel> voxels(volume);
+    for (size_t i = 0; i < volume; i++) {
+        auto id = region_value(L, 7, i, fillId, -1);
+        if (id < 0) {
+            voxels[i].id = BLOCK_VOID;
+            continue;
+        }
+        if (static_cast<size_t>(id) >= count) {
+            throw std::runtime_error("invalid block id " + std::to_string(id));
+        }
+        voxels[i].id = id;
+        voxels[i].state =
+            int2blockstate(region_value(L, 8, i, fillStates, 0));
+    }
+    return lua::pushinteger(
+        L, blocks->setRegion(origin, size, voxels, noupdate)
+    );
+}
+
 static int l_get_x(lua::State* L) {
     auto x = lua::tointeger(L, 1);
     auto y = lua::tointeger(L, 2);
@@ -446,6 +555,8 @@ const luaL_Reg blocklib[] = {
     {"is_replaceable_at", lua::wrap<l_is_replaceable_at>},
     {"set", lua::wrap<l_set>},
     {"get", lua::wrap<l_get>},
+    {"get_region", lua::wrap<l_get_region>},
+    {"set_region", lua::wrap<l_set_region>},
     {"get_X", lua::wrap<l_get_x>},
     {"get_Y", lua::wrap<l_get_y>},
     {"get_Z", lua::wrap<l_get_z>},
@@ -110,70 +110,51 @@ static int l_file_mkdirs(lua::State* L) {
 static int l_file_read_bytes(lua::State* L) {
     fs::path path = resolve_path(lua::require_string(L, 1));
     if (fs::is_regular_file(path)) {
-        size_t length = static_cast<size_t>(fs::file_size(path));
-
-        auto bytes = files::read_bytes(path, length);
-
-        lua::createtable(L, length, 0);
-        int newTable = lua::gettop(L);
-
-        for (size_t i = 0; i < length; i++) {
-            lua::pushinteger(L, bytes[i]);
-            lua::rawseti(L, i + 1, newTable);
-        }
-        return 1;
+        return lua::newuserdata<lua::Bytearray>(L, files::read_bytes(path));
     }
     throw std::runtime_error(
         "file does not exists " + util::quote(path.u8string())
     );
 }
 
-static int read_bytes_from_table(
-    lua::State* L, int tableIndex, std::vector<ubyte>& bytes
+/// @brief Get bytes from a bytearray or from an array of integers
+/// @param buffer destination used for table conversion
+/// @return bytearray data if bytearray given, otherwise buffer
+static const std::vector<ubyte>& require_bytes(
+    lua::State* L, int idx, std::vector<ubyte>& buffer
 ) {
-    if (!lua::istable(L, tableIndex)) {
-        throw std::runtime_error("table expected");
-    } else {
-        lua::pushnil(L);
-        while (lua::next(L, tableIndex - 1) != 0) {
-            const int byte = lua::tointeger(L, -1);
-            if (byte < 0 || byte > 255) {
-                throw std::runtime_error(
-                    "invalid byte '" + std::to_string(byte) + "'"
-                );
-            }
-            bytes.push_back(byte);
-            lua::pop(L);
+    if (lua::isuserdata(L, idx)) {
+        if (auto bytearray = lua::touserdata<lua::Bytearray>(L, idx)) {
+            return bytearray->data();
+        }
+    }
+    if (!lua::istable(L, idx)) {
+        throw std::runtime_error("bytearray or table expected");
+    }
+    size_t length = lua::objlen(L, idx);
+    buffer.resize(length);
+    for (size_t i = 0; i < length; i++) {
+        lua::rawgeti(L, i + 1, idx);
+        const auto byte = lua::tointeger(L, -1);
+        lua::pop(L);
+        if (byte < 0 || byte > 255) {
+            throw std::runtime_error(
+                "invalid byte '" + std::to_string(byte) + "'"
+            );
         }
-        return 1;
+        buffer[i] = static_cast<ubyte>(byte);
     }
+    return buffer;
 }
 
 static int l_file_write_bytes(lua::State* L) {
-    int pathIndex = 1;
-
-    if (!lua::isstring(L, pathIndex)) {
-        throw std::runtime_error("string expected");
-    }
-
-    fs::path path = resolve_path(lua::require_string(L, pathIndex));
-
-    if (auto bytearray = lua::touserdata<lua::Bytearray>(L, -1)) {
-        auto& bytes = bytearray->data();
-        return lua::pushboolean(
-            L, files::write_bytes(path, bytes.data(), bytes.size())
-        );
-    }
+    fs::path path = resolve_path(lua::require_string(L, 1));
 
-    std::vector<ubyte> bytes;
-    int result = read_bytes_from_table(L, -1, bytes);
-    if (result != 1) {
-        return result;
-    } else {
-        return lua::pushboolean(
-            L, files::write_bytes(path, bytes.data(), bytes.size())
-        );
-    }
+    std::vector<ubyte> buffer;
+    const auto& bytes = require_bytes(L, 2, buffer);
+    return lua::pushboolean(
+        L, files::write_bytes(path, bytes.data(), bytes.size())
+    );
 }
 
 static int l_file_list_all_res(lua::State* L, const std::string& path) {
@@ -210,41 +191,19 @@ static int l_file_list(lua::State* L) {
 }
 
 static int l_file_gzip_compress(lua::State* L) {
-    std::vector<ubyte> bytes;
-
-    int result = read_bytes_from_table(L, -1, bytes);
-
-    if (result != 1) {
-        return result;
-    } else {
-        auto compressed_bytes = gzip::compress(bytes.data(), bytes.size());
-        int newTable = lua::gettop(L);
-
-        for (size_t i = 0; i < compressed_bytes.size(); i++) {
-            lua::pushinteger(L, compressed_bytes.data()[i]);
-            lua::rawseti(L, i + 1, newTable);
-        }
-        return 1;
-    }
+    std::vector<ubyte> buffer;
+    const auto& bytes = require_bytes(L, 1, buffer);
+    return lua::newuserdata<lua::Bytearray>(
+        L, gzip::compress(bytes.data(), bytes.size())
+    );
 }
 
 static int l_file_gzip_decompress(lua::State* L) {
-    std::vector<ubyte> bytes;
-
-    int result = read_bytes_from_table(L, -1, bytes);
-
-    if (result != 1) {
-        return result;
-    } else {
-        auto decompressed_bytes = gzip::decompress(bytes.data(), bytes.size());
-        int newTable = lua::gettop(L);
-
-        for (size_t i = 0; i < decompressed_bytes.size(); i++) {
-            lua::pushinteger(L, decompressed_bytes.data()[i]);
-            lua::rawseti(L, i + 1, newTable);
-        }
-        return 1;
-    }
+    std::vector<ubyte> buffer;
+    const auto& bytes = require_bytes(L, 1, buffer);
+    return lua::newuserdata<lua::Bytearray>(
+        L, gzip::decompress(bytes.data(), bytes.size())
+    );
 }
 
 const luaL_Reg filelib[] = {
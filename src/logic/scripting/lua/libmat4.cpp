@@ -7,6 +7,43 @@
 #include <glm/gtx/matrix_decompose.hpp>
 #include <glm/gtx/quaternion.hpp>
 
+/// @return true if value at index is a mat4 userdata
+static bool is_matrix(lua::State* L, int idx) {
+    return lua::touserdata<lua::Matrix4>(L, idx) != nullptr;
+}
+
+/// @brief Push matrix as userdata if value at srcIdx is mat4 userdata,
+/// otherwise as a new table
+static int push_matrix(lua::State* L, int srcIdx, const glm::mat4& matrix) {
+    if (is_matrix(L, srcIdx)) {
+        return lua::newuserdata<lua::Matrix4>(L, matrix);
+    }
+    return lua::pushmat4(L, matrix);
+}
+
+/// @return vector or matrix argument length (components number)
+static uint arg_length(lua::State* L, int idx) {
+    if (is_matrix(L, idx)) {
+        return 16;
+    } else if (lua::touserdata<lua::Vector<4>>(L, idx)) {
+        return 4;
+    } else if (lua::touserdata<lua::Vector<3>>(L, idx)) {
+        return 3;
+    }
+    return lua::objlen(L, idx);
+}
+
+/// Overloads:
+/// mat4.new() -> mat4 - creates identity matrix userdata
+/// mat4.new(matrix: float[16]) -> mat4 - creates matrix userdata copy
+static int l_new(lua::State* L) {
+    uint argc = lua::check_argc(L, 0, 1);
+    if (argc == 0) {
+        return lua::newuserdata<lua::Matrix4>(L, glm::mat4(1.0f));
+    }
+    return lua::newuserdata<lua::Matrix4>(L, lua::tomat4(L, 1));
+}
+
 /// Overloads:
 /// mat4.idt() -> float[16] - creates identity matrix
 /// mat4.idt(dst: float[16]) -> float[16] - sets dst to identity matrix
@@ -42,20 +79,26 @@ static int l_determinant(lua::State* L) {
 static int l_mul(lua::State* L) {
     uint argc = lua::check_argc(L, 2, 3);
     auto matrix1 = lua::tomat4(L, 1);
-    uint len2 = lua::objlen(L, 2);
+    uint len2 = arg_length(L, 2);
     if (len2 < 3) {
         throw std::runtime_error("argument #2: vec3 or vec4 expected");
     }
     switch (argc) {
         case 2: {
             if (len2 == 4) {
-                return lua::pushvec(L, matrix1 * lua::tovec4(L, 2));
+                auto vec = matrix1 * lua::tovec4(L, 2);
+                if (lua::touserdata<lua::Vector<4>>(L, 2)) {
+                    return lua::newuserdata<lua::Vector<4>>(L, vec);
+                }
+                return lua::pushvec(L, vec);
             } else if (len2 == 3) {
-                return lua::pushvec(
-                    L, matrix1 * glm::vec4(lua::tovec3(L, 2), 1.0f)
-                );
+                auto vec = matrix1 * glm::vec4(lua::tovec3(L, 2), 1.0f);
+                if (lua::touserdata<lua::Vector<3>>(L, 2)) {
+                    return lua::newuserdata<lua::Vector<3>>(L, glm::vec3(vec));
+                }
+                return lua::pushvec(L, vec);
             }
-            return lua::pushmat4(L, matrix1 * lua::tomat4(L, 2));
+            return push_matrix(L, 1, matrix1 * lua::tomat4(L, 2));
         }
         case 3: {
             if (len2 == 4) {
@@ -87,7 +130,7 @@ inline int l_transform_func(lua::State* L) {
         case 2: {
             auto matrix = lua::tomat4(L, 1);
             auto vec = lua::tovec3(L, 2);
-            return lua::pushmat4(L, func(matrix, vec));
+            return push_matrix(L, 1, func(matrix, vec));
         }
         case 3: {
             auto matrix = lua::tomat4(L, 1);
@@ -121,7 +164,7 @@ inline int l_rotate(lua::State* L) {
             auto matrix = lua::tomat4(L, 1);
             auto vec = lua::tovec3(L, 2);
             auto angle = glm::radians(static_cast<float>(lua::tonumber(L, 3)));
-            return lua::pushmat4(L, glm::rotate(matrix, angle, vec));
+            return push_matrix(L, 1, glm::rotate(matrix, angle, vec));
         }
         case 4: {
             auto matrix = lua::tomat4(L, 1);
@@ -147,7 +190,7 @@ static int l_inverse(lua::State* L) {
     auto matrix = lua::tomat4(L, 1);
     switch (argc) {
         case 1: {
-            return lua::pushmat4(L, glm::inverse(matrix));
+            return push_matrix(L, 1, glm::inverse(matrix));
         }
         case 2: {
             return lua::setmat4(L, 2, glm::inverse(matrix));
@@ -165,7 +208,7 @@ static int l_transpose(lua::State* L) {
     auto matrix = lua::tomat4(L, 1);
     switch (argc) {
         case 1: {
-            return lua::pushmat4(L, glm::transpose(matrix));
+            return push_matrix(L, 1, glm::transpose(matrix));
         }
         case 2: {
             return lua::setmat4(L, 2, glm::transpose(matrix));
@@ -270,6 +313,7 @@ static int l_tostring(lua::State* L) {
 }
 
 const luaL_Reg mat4lib[] = {
+    {"new", lua::wrap<l_new>},
     {"idt", lua::wrap<l_idt>},
     {"mul", lua::wrap<l_mul>},
     {"scale", lua::wrap<l_transform_func<glm::scale>>},
@@ -0,0 +1,108 @@
+#include "engine.hpp"
+#include "files/engine_paths.hpp"
+#include "files/files.hpp"
+#include "logic/scripting/scripting_gc.hpp"
+#include "logic/scripting/scripting_profiler.hpp"
+#include "api_lua.hpp"
+
+using namespace scripting;
+
+static int l_profiler_start(lua::State* L) {
+    profiler::start(lua::toboolean(L, 1));
+    return 0;
+}
+
+static int l_profiler_stop(lua::State*) {
+    profiler::stop();
+    return 0;
+}
+
+static int l_profiler_reset(lua::State*) {
+    profiler::reset();
+    gc::reset_stats();
+    return 0;
+}
+
+static int l_profiler_is_enabled(lua::State* L) {
+    return lua::pushboolean(L, profiler::is_enabled());
+}
+
+static int l_profiler_get_entries(lua::State* L) {
+    auto entries = profiler::get_entries();
+    lua::createtable(L, entries.size(), 0);
+    for (size_t i = 0; i < entries.size(); i++) {
+        const auto& entry = entries[i];
+        lua::createtable(L, 0, 7);
+
+        lua::pushstring(L, entry.name);
+        lua::setfield(L, "name");
+        lua::pushstring(L, entry.source);
+        lua::setfield(L, "source");
+        lua::pushstring(L, entry.getPackId());
+        lua::setfield(L, "pack");
+        lua::pushinteger(L, entry.calls);
+        lua::setfield(L, "calls");
+        lua::pushnumber(L, entry.time / 1e9);
+        lua::setfield(L, "time");
+        lua::pushnumber(L, entry.maxTime / 1e9);
+        lua::setfield(L, "max_time");
+        lua::pushinteger(L, entry.allocated);
+        lua::setfield(L, "allocated");
+
+        lua::rawseti(L, i + 1);
+    }
+    return 1;
+}
+
+static int l_profiler_get_gc_stats(lua::State* L) {
+    auto stats = gc::get_stats();
+    lua::createtable(L, 0, 6);
+
+    lua::pushinteger(L, stats.heapSize);
+    lua::setfield(L, "heap_size");
+    lua::pushinteger(L, stats.peakHeapSize);
+    lua::setfield(L, "peak_heap_size");
+    lua::pushinteger(L, stats.cycles);
+    lua::setfield(L, "cycles");
+    lua::pushnumber(L, stats.lastPause);
+    lua::setfield(L, "last_pause");
+    lua::pushnumber(L, stats.maxPause);
+    lua::setfield(L, "max_pause");
+    lua::pushnumber(L, stats.totalTime);
+    lua::setfield(L, "total_time");
+    return 1;
+}
+
+static int l_profiler_export(lua::State* L) {
+    auto path = engine->getPaths()->resolve(lua::require_string(L, 1));
+    files::write_string(path, profiler::write_trace());
+    return lua::pushinteger(L, profiler::get_trace_size());
+}
+
+/// @brief pcall measuring the function call as named entry
+static int l_profiler_call(lua::State* L) {
+    std::string name = lua::require_string(L, 1);
+    if (!lua::isfunction(L, 2)) {
+        throw std::runtime_error("function expected");
+    }
+    int argc = lua::gettop(L) - 2;
+    bool success;
+    {
+        profiler::Scope scope([&](auto& entry) { entry.name = name; });
+        success = lua_pcall(L, argc, LUA_MULTRET, 0) == 0;
+    }
+    lua::pushboolean(L, success);
+    lua::insert(L, 2);
+    return lua::gettop(L) - 1;
+}
+
+const luaL_Reg profilerlib[] = {
+    {"start", lua::wrap<l_profiler_start>},
+    {"stop", lua::wrap<l_profiler_stop>},
+    {"reset", lua::wrap<l_profiler_reset>},
+    {"is_enabled", lua::wrap<l_profiler_is_enabled>},
+    {"get_entries", lua::wrap<l_profiler_get_entries>},
+    {"get_gc_stats", lua::wrap<l_profiler_get_gc_stats>},
+    {"export", lua::wrap<l_profiler_export>},
+    {"call", lua::wrap<l_profiler_call>},
+    {NULL, NULL}};
@@ -0,0 +1,45 @@
+#include "api_lua.hpp"
+#include "lua_tasks.hpp"
+
+static int l_tasks_spawn(lua::State* L) {
+    if (!lua::isfunction(L, 1)) {
+        throw std::runtime_error("function expected");
+    }
+    int argc = lua::gettop(L) - 1;
+    return lua::pushinteger(L, lua::tasks::spawn(L, argc));
+}
+
+static int l_tasks_is_alive(lua::State* L) {
+    return lua::pushboolean(L, lua::tasks::is_alive(lua::tointeger(L, 1)));
+}
+
+static int l_tasks_cancel(lua::State* L) {
+    lua::tasks::cancel(L, lua::tointeger(L, 1));
+    return 0;
+}
+
+static int l_tasks_count(lua::State* L) {
+    return lua::pushinteger(L, lua::tasks::count());
+}
+
+static int l_tasks_set_budget(lua::State* L) {
+    auto seconds = lua::tonumber(L, 1);
+    if (seconds <= 0.0) {
+        throw std::runtime_error("positive budget expected");
+    }
+    lua::tasks::set_budget(seconds);
+    return 0;
+}
+
+static int l_tasks_get_budget(lua::State* L) {
+    return lua::pushnumber(L, lua::tasks::get_budget());
+}
+
+const luaL_Reg taskslib[] = {
+    {"spawn", lua::wrap<l_tasks_spawn>},
+    {"is_alive", lua::wrap<l_tasks_is_alive>},
+    {"cancel", lua::wrap<l_tasks_cancel>},
+    {"count", lua::wrap<l_tasks_count>},
+    {"set_budget", lua::wrap<l_tasks_set_budget>},
+    {"get_budget", lua::wrap<l_tasks_get_budget>},
+    {NULL, NULL}};
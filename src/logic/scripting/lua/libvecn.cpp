@@ -15,6 +15,35 @@ inline T angle(glm::vec<2, T> vec) {
     return val;
 }
 
+/// @return true if value at index is a vecN userdata
+template <int n>
+static bool is_vector(lua::State* L, int idx) {
+    return lua::touserdata<lua::Vector<n>>(L, idx) != nullptr;
+}
+
+/// Overloads:
+/// vecN.new() -> vecN - creates zero vector userdata
+/// vecN.new(x, y, ...) -> vecN - creates vector userdata from components
+/// vecN.new(vec: float[N]) -> vecN - creates vector userdata copy of vec
+template <int n>
+static int l_new(lua::State* L) {
+    int argc = lua::gettop(L);
+    glm::vec<n, float> vec(0.0f);
+    if (argc == 1) {
+        vec = lua::tovec<n>(L, 1);
+    } else if (argc == n) {
+        for (int i = 0; i < n; i++) {
+            vec[i] = lua::tonumber(L, i + 1);
+        }
+    } else if (argc != 0) {
+        throw std::runtime_error(
+            "invalid arguments number (0, 1 or " + std::to_string(n) +
+            " expected)"
+        );
+    }
+    return lua::newuserdata<lua::Vector<n>>(L, vec);
+}
+
 template <int n, template <class> class Op>
 static int l_binop(lua::State* L) {
     uint argc = lua::check_argc(L, 2, 3);
@@ -23,7 +52,11 @@ static int l_binop(lua::State* L) {
     if (lua::isnumber(L, 2)) {  // scalar second operand overload
         auto b = lua::tonumber(L, 2);
         Op op;
-        if (argc == 2) {
+        if (argc == 2 && is_vector<n>(L, 1)) {
+            return lua::newuserdata<lua::Vector<n>>(
+                L, op(a, glm::vec<n, float>(b))
+            );
+        } else if (argc == 2) {
             lua::createtable(L, n, 0);
             for (uint i = 0; i < n; i++) {
                 lua::pushnumber(L, op(a[i], b));
@@ -36,7 +69,9 @@ static int l_binop(lua::State* L) {
     } else {
         auto b = lua::tovec<n>(L, 2);
         Op op;
-        if (argc == 2) {
+        if (argc == 2 && is_vector<n>(L, 1)) {
+            return lua::newuserdata<lua::Vector<n>>(L, op(a, b));
+        } else if (argc == 2) {
             lua::createtable(L, n, 0);
             for (uint i = 0; i < n; i++) {
                 lua::pushnumber(L, op(a[i], b[i]));
@@ -55,6 +90,9 @@ static int l_unaryop(lua::State* L) {
     auto vec = func(lua::tovec<n>(L, 1));
     switch (argc) {
         case 1:
+            if (is_vector<n>(L, 1)) {
+                return lua::newuserdata<lua::Vector<n>>(L, vec);
+            }
             lua::createtable(L, n, 0);
             for (uint i = 0; i < n; i++) {
                 lua::pushnumber(L, vec[i]);
@@ -81,7 +119,11 @@ static int l_pow(lua::State* L) {
 
     if (lua::isnumber(L, 2)) {
         auto b = lua::tonumber(L, 2);
-        if (argc == 2) {
+        if (argc == 2 && is_vector<n>(L, 1)) {
+            return lua::newuserdata<lua::Vector<n>>(
+                L, pow(a, glm::vec<n, float>(b))
+            );
+        } else if (argc == 2) {
             lua::createtable(L, n, 0);
             for (uint i = 0; i < n; i++) {
                 lua::pushnumber(L, pow(a[i], b));
@@ -93,7 +135,9 @@ static int l_pow(lua::State* L) {
         }
     } else {
         auto b = lua::tovec<n>(L, 2);
-        if (argc == 2) {
+        if (argc == 2 && is_vector<n>(L, 1)) {
+            return lua::newuserdata<lua::Vector<n>>(L, pow(a, b));
+        } else if (argc == 2) {
             lua::createtable(L, n, 0);
             for (uint i = 0; i < n; i++) {
                 lua::pushnumber(L, pow(a[i], b[i]));
@@ -120,6 +164,9 @@ static int l_inverse(lua::State* L) {
     auto vec = lua::tovec<n>(L, 1);
     switch (argc) {
         case 1:
+            if (is_vector<n>(L, 1)) {
+                return lua::newuserdata<lua::Vector<n>>(L, -vec);
+            }
             lua::createtable(L, n, 0);
             for (uint i = 0; i < n; i++) {
                 lua::pushnumber(L, (-1) * vec[i]);
@@ -178,6 +225,7 @@ static int l_tostring(lua::State* L) {
 }
 
 const luaL_Reg vec2lib[] = {
+    {"new", lua::wrap<l_new<2>>},
     {"add", lua::wrap<l_binop<2, std::plus>>},
     {"sub", lua::wrap<l_binop<2, std::minus>>},
     {"mul", lua::wrap<l_binop<2, std::multiplies>>},
@@ -194,6 +242,7 @@ const luaL_Reg vec2lib[] = {
     {NULL, NULL}};
 
 const luaL_Reg vec3lib[] = {
+    {"new", lua::wrap<l_new<3>>},
     {"add", lua::wrap<l_binop<3, std::plus>>},
     {"sub", lua::wrap<l_binop<3, std::minus>>},
     {"mul", lua::wrap<l_binop<3, std::multiplies>>},
@@ -210,6 +259,7 @@ const luaL_Reg vec3lib[] = {
     {NULL, NULL}};
 
 const luaL_Reg vec4lib[] = {
+    {"new", lua::wrap<l_new<4>>},
     {"add", lua::wrap<l_binop<4, std::plus>>},
     {"sub", lua::wrap<l_binop<4, std::minus>>},
     {"mul", lua::wrap<l_binop<4, std::multiplies>>},
@@ -0,0 +1,114 @@
+#include <algorithm>
+
+#include "voxels/ChunksStorage.hpp"
+#include "voxels/VoxelsVolume.hpp"
+#include "world/Level.hpp"
+#include "api_lua.hpp"
+#include "lua_workers.hpp"
+
+using namespace scripting;
+
+/// @brief Maximal number of voxels in a job blocks snapshot
+static constexpr size_t MAX_SNAPSHOT_VOLUME = 1 << 22;
+
+static int bytecode_writer(
+    lua::State*, const void* data, size_t size, void* dst
+) {
+    static_cast<std::string*>(dst)->append(
+        static_cast<const char*>(data), size
+    );
+    return 0;
+}
+
+static std::shared_ptr<VoxelsVolume> create_snapshot(lua::State* L, int idx) {
+    if (!lua::istable(L, idx) || lua::objlen(L, idx) < 6) {
+        throw std::runtime_error("area {x, y, z, w, h, d} expected");
+    }
+    int area[6];
+    for (int i = 0; i < 6; i++) {
+        lua::rawgeti(L, i + 1, idx);
+        area[i] = lua::tointeger(L, -1);
+        lua::pop(L);
+    }
+    int y1 = std::max(area[1], 0);
+    int y2 = std::min(area[1] + area[4], CHUNK_H);
+    int w = area[3];
+    int h = y2 - y1;
+    int d = area[5];
+    if (w <= 0 || h <= 0 || d <= 0) {
+        throw std::runtime_error("empty area");
+    }
+    if (static_cast<size_t>(w) * h * d > MAX_SNAPSHOT_VOLUME) {
+        throw std::runtime_error(
+            "area is too big (max volume is " +
+            std::to_string(MAX_SNAPSHOT_VOLUME) + ")"
+        );
+    }
+    auto snapshot =
+        std::make_shared<VoxelsVolume>(area[0], y1, area[2], w, h, d);
+    level->chunksStorage->getVoxels(snapshot.get());
+    return snapshot;
+}
+
+static int l_workers_submit(lua::State* L) {
+    if (!lua::isfunction(L, 1) || lua_iscfunction(L, 1)) {
+        throw std::runtime_error("Lua function expected");
+    }
+    if (lua_getupvalue(L, 1, 1)) {
+        lua::pop(L);
+        throw std::runtime_error("job function must not have upvalues");
+    }
+    std::string bytecode;
+    lua::pushvalue(L, 1);
+    lua_dump(L, bytecode_writer, &bytecode);
+    lua::pop(L);
+
+    dynamic::List_sptr args;
+    if (!lua::isnoneornil(L, 2)) {
+        if (!lua::istable(L, 2)) {
+            throw std::runtime_error("arguments table expected");
+        }
+        auto value = lua::tovalue(L, 2);
+        if (auto list = std::get_if<dynamic::List_sptr>(&value)) {
+            args = *list;
+        }
+    }
+    std::shared_ptr<VoxelsVolume> snapshot;
+    if (!lua::isnoneornil(L, 3)) {
+        if (level == nullptr) {
+            throw std::runtime_error("no world open");
+        }
+        snapshot = create_snapshot(L, 3);
+    }
+    return lua::pushinteger(
+        L,
+        lua::workers::submit(
+            content, std::move(bytecode), std::move(args), std::move(snapshot)
+        )
+    );
+}
+
+static int l_workers_poll(lua::State* L) {
+    lua::workers::JobResult result {};
+    if (!lua::workers::poll(lua::tointeger(L, 1), result)) {
+        return lua::pushboolean(L, false);
+    }
+    lua::pushboolean(L, true);
+    if (!result.success) {
+        lua::pushnil(L);
+        lua::pushstring(L, result.error);
+        return 3;
+    }
+    lua::pushvalue(L, result.value);
+    return 2;
+}
+
+static int l_workers_count(lua::State* L) {
+    return lua::pushinteger(L, lua::workers::count());
+}
+
+const luaL_Reg workerslib[] = {
+    {"submit", lua::wrap<l_workers_submit>},
+    {"poll", lua::wrap<l_workers_poll>},
+    {"count", lua::wrap<l_workers_count>},
+    {NULL, NULL}};
@@ -1,5 +1,6 @@
 #include "lua_custom_types.hpp"
 
+#include <functional>
 #include <sstream>
 
 #include "lua_util.hpp"
@@ -46,7 +47,7 @@ static int l_bytearray_remove(lua::State* L) {
     }
     auto& data = buffer->data();
     auto index = tointeger(L, 2) - 1;
-    if (static_cast<size_t>(index) > data.size()) {
+    if (static_cast<size_t>(index) >= data.size()) {
         return 0;
     }
     data.erase(data.begin() + index);
@@ -91,7 +92,7 @@ static int l_bytearray_meta_index(lua::State* L) {
         }
     }
     auto index = tointeger(L, 2) - 1;
-    if (static_cast<size_t>(index) > data.size()) {
+    if (static_cast<size_t>(index) >= data.size()) {
         return 0;
     }
     return pushinteger(L, data[index]);
@@ -181,3 +182,215 @@ int Bytearray::createMetatable(lua::State* L) {
     setmetatable(L);
     return 1;
 }
+
+/// @return component index or -1 if key is not a valid component key
+template <int n>
+static int vector_component(lua::State* L, int idx) {
+    if (isnumber(L, idx)) {
+        auto index = tointeger(L, idx) - 1;
+        return index >= 0 && index < n ? index : -1;
+    }
+    if (!isstring(L, idx)) {
+        return -1;
+    }
+    const char* key = tostring(L, idx);
+    if (key[0] == 0 || key[1] != 0) {
+        return -1;
+    }
+    int index;
+    switch (key[0]) {
+        case 'x': index = 0; break;
+        case 'y': index = 1; break;
+        case 'z': index = 2; break;
+        case 'w': index = 3; break;
+        default: return -1;
+    }
+    return index < n ? index : -1;
+}
+
+template <int n>
+static int l_vector_meta_index(lua::State* L) {
+    auto vector = touserdata<Vector<n>>(L, 1);
+    if (vector == nullptr) {
+        return 0;
+    }
+    int index = vector_component<n>(L, 2);
+    if (index == -1) {
+        return 0;
+    }
+    return pushnumber(L, vector->data()[index]);
+}
+
+template <int n>
+static int l_vector_meta_newindex(lua::State* L) {
+    auto vector = touserdata<Vector<n>>(L, 1);
+    if (vector == nullptr) {
+        return 0;
+    }
+    int index = vector_component<n>(L, 2);
+    if (index == -1) {
+        throw std::runtime_error("invalid vec" + std::to_string(n) + " key");
+    }
+    vector->data()[index] = tonumber(L, 3);
+    return 0;
+}
+
+template <int n>
+static int l_vector_meta_len(lua::State* L) {
+    return pushinteger(L, n);
+}
+
+template <int n>
+static int l_vector_meta_tostring(lua::State* L) {
+    auto vector = touserdata<Vector<n>>(L, 1);
+    if (vector == nullptr) {
+        return 0;
+    }
+    std::stringstream ss;
+    ss << "vec" << n << "{";
+    for (int i = 0; i < n; i++) {
+        if (i > 0) {
+            ss << ", ";
+        }
+        ss << vector->data()[i];
+    }
+    ss << "}";
+    return pushstring(L, ss.str());
+}
+
+/// @brief Get vector operand (number is converted to vector)
+template <int n>
+static glm::vec<n, float> vector_operand(lua::State* L, int idx) {
+    if (isnumber(L, idx)) {
+        return glm::vec<n, float>(tonumber(L, idx));
+    }
+    return tovec<n>(L, idx);
+}
+
+template <int n, template <class> class Op>
+static int l_vector_meta_binop(lua::State* L) {
+    Op<glm::vec<n, float>> op;
+    return newuserdata<Vector<n>>(
+        L, op(vector_operand<n>(L, 1), vector_operand<n>(L, 2))
+    );
+}
+
+template <int n>
+static int l_vector_meta_unm(lua::State* L) {
+    return newuserdata<Vector<n>>(L, -tovec<n>(L, 1));
+}
+
+template <int n>
+static int l_vector_meta_eq(lua::State* L) {
+    return pushboolean(L, tovec<n>(L, 1) == tovec<n>(L, 2));
+}
+
+template <int n>
+int Vector<n>::createMetatable(lua::State* L) {
+    createtable(L, 0, 10);
+    pushcfunction(L, lua::wrap<l_vector_meta_index<n>>);
+    setfield(L, "__index");
+    pushcfunction(L, lua::wrap<l_vector_meta_newindex<n>>);
+    setfield(L, "__newindex");
+    pushcfunction(L, lua::wrap<l_vector_meta_len<n>>);
+    setfield(L, "__len");
+    pushcfunction(L, lua::wrap<l_vector_meta_tostring<n>>);
+    setfield(L, "__tostring");
+    pushcfunction(L, lua::wrap<l_vector_meta_binop<n, std::plus>>);
+    setfield(L, "__add");
+    pushcfunction(L, lua::wrap<l_vector_meta_binop<n, std::minus>>);
+    setfield(L, "__sub");
+    pushcfunction(L, lua::wrap<l_vector_meta_binop<n, std::multiplies>>);
+    setfield(L, "__mul");
+    pushcfunction(L, lua::wrap<l_vector_meta_binop<n, std::divides>>);
+    setfield(L, "__div");
+    pushcfunction(L, lua::wrap<l_vector_meta_unm<n>>);
+    setfield(L, "__unm");
+    pushcfunction(L, lua::wrap<l_vector_meta_eq<n>>);
+    setfield(L, "__eq");
+    return 1;
+}
+
+template class lua::Vector<2>;
+template class lua::Vector<3>;
+template class lua::Vector<4>;
+
+static int l_matrix4_meta_index(lua::State* L) {
+    auto matrix = touserdata<Matrix4>(L, 1);
+    if (matrix == nullptr || !isnumber(L, 2)) {
+        return 0;
+    }
+    auto index = tointeger(L, 2) - 1;
+    if (index < 0 || index >= 16) {
+        return 0;
+    }
+    return pushnumber(L, matrix->data()[index / 4][index % 4]);
+}
+
+static int l_matrix4_meta_newindex(lua::State* L) {
+    auto matrix = touserdata<Matrix4>(L, 1);
+    if (matrix == nullptr) {
+        return 0;
+    }
+    auto index = tointeger(L, 2) - 1;
+    if (!isnumber(L, 2) || index < 0 || index >= 16) {
+        throw std::runtime_error("invalid mat4 index");
+    }
+    matrix->data()[index / 4][index % 4] = tonumber(L, 3);
+    return 0;
+}
+
+static int l_matrix4_meta_len(lua::State* L) {
+    return pushinteger(L, 16);
+}
+
+static int l_matrix4_meta_tostring(lua::State* L) {
+    auto matrix = touserdata<Matrix4>(L, 1);
+    if (matrix == nullptr) {
+        return 0;
+    }
+    const auto& m = matrix->data();
+    std::stringstream ss;
+    ss << "mat4 {";
+    for (uint y = 0; y < 4; y++) {
+        for (uint x = 0; x < 4; x++) {
+            if (x > 0) {
+                ss << " ";
+            }
+            ss << m[y][x];
+        }
+        ss << "; ";
+    }
+    ss << "}";
+    return pushstring(L, ss.str());
+}
+
+/// @brief matrix * matrix or matrix * vec4
+static int l_matrix4_meta_mul(lua::State* L) {
+    auto matrix = tomat4(L, 1);
+    if (auto vector = touserdata<Vector<4>>(L, 2)) {
+        return newuserdata<Vector<4>>(L, matrix * vector->data());
+    }
+    return newuserdata<Matrix4>(L, matrix * tomat4(L, 2));
+}
+
+static int l_matrix4_meta_eq(lua::State* L) {
+    return pushboolean(L, tomat4(L, 1) == tomat4(L, 2));
+}
+
+int Matrix4::createMetatable(lua::State* L) {
+    createtable(L, 0, 6);
+    pushcfunction(L, lua::wrap<l_matrix4_meta_index>);
+    setfield(L, "__index");
+    pushcfunction(L, lua::wrap<l_matrix4_meta_newindex>);
+    setfield(L, "__newindex");
+    pushcfunction(L, lua::wrap<l_matrix4_meta_len>);
+    setfield(L, "__len");
+    pushcfunction(L, lua::wrap<l_matrix4_meta_tostring>);
+    setfield(L, "__tostring");
+    pushcfunction(L, lua::wrap<l_matrix4_meta_mul>);
+    setfield(L, "__mul");
+    pushcfunction(L, lua::wrap<l_matrix4_meta_eq>);
+    setfield(L, "__eq");
+    return 1;
+}
@@ -29,4 +29,42 @@ namespace lua {
         static int createMetatable(lua::State*);
         inline static std::string TYPENAME = "bytearray";
     };
+
+    /// @brief Vector stored in userdata. May be used instead of numbers
+    /// array tables to avoid per-component access and tables allocation
+    template <int n>
+    class Vector : public Userdata {
+        glm::vec<n, float> vec;
+    public:
+        Vector(const glm::vec<n, float>& vec) : vec(vec) {
+        }
+
+        const std::string& getTypeName() const override {
+            return TYPENAME;
+        }
+        inline glm::vec<n, float>& data() {
+            return vec;
+        }
+
+        static int createMetatable(lua::State*);
+        inline static std::string TYPENAME = "vec" + std::to_string(n);
+    };
+
+    /// @brief 4x4 matrix stored in userdata
+    class Matrix4 : public Userdata {
+        glm::mat4 matrix;
+    public:
+        Matrix4(const glm::mat4& matrix) : matrix(matrix) {
+        }
+
+        const std::string& getTypeName() const override {
+            return TYPENAME;
+        }
+        inline glm::mat4& data() {
+            return matrix;
+        }
+
+        static int createMetatable(lua::State*);
+        inline static std::string TYPENAME = "mat4";
+    };
 }
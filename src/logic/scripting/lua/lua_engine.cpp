@@ -4,6 +4,7 @@
 #include <iostream>
 
 #include "debug/Logger.hpp"
+#include "logic/scripting/scripting_profiler.hpp"
 #include "util/stringutil.hpp"
 #include "api_lua.hpp"
 #include "lua_custom_types.hpp"
@@ -30,6 +31,7 @@ static void remove_lib_funcs(
 
 static void create_libs(lua::State* L) {
     openlib(L, "audio", audiolib);
+    openlib(L, "bjson", bjsonlib);
     openlib(L, "block", blocklib);
     openlib(L, "console", consolelib);
     openlib(L, "core", corelib);
@@ -42,12 +44,15 @@ static void create_libs(lua::State* L) {
     openlib(L, "mat4", mat4lib);
     openlib(L, "pack", packlib);
     openlib(L, "player", playerlib);
+    openlib(L, "profiler", profilerlib);
     openlib(L, "quat", quatlib);
+    openlib(L, "tasks", taskslib);
     openlib(L, "time", timelib);
     openlib(L, "toml", tomllib);
     openlib(L, "vec2", vec2lib);
     openlib(L, "vec3", vec3lib);
     openlib(L, "vec4", vec4lib);
+    openlib(L, "workers", workerslib);
     openlib(L, "world", worldlib);
 
     openlib(L, "entities", entitylib);
@@ -96,6 +101,10 @@ void lua::initialize() {
     initialize_libs_extends(L);
 
     newusertype<Bytearray, Bytearray::createMetatable>(L, "bytearray");
+    newusertype<Vector<2>, Vector<2>::createMetatable>(L, "__vec2");
+    newusertype<Vector<3>, Vector<3>::createMetatable>(L, "__vec3");
+    newusertype<Vector<4>, Vector<4>::createMetatable>(L, "__vec4");
+    newusertype<Matrix4, Matrix4::createMetatable>(L, "__mat4");
 }
 
 void lua::finalize() {
@@ -105,6 +114,7 @@ void lua::finalize() {
 bool lua::emit_event(
     lua::State* L, const std::string& name, std::function<int(lua::State*)> args
 ) {
+    scripting::profiler::Scope scope([&](auto& entry) { entry.name = name; });
     getglobal(L, "events");
     getfield(L, "emit");
     pushstring(L, name);
@@ -6,6 +6,7 @@
 #include "data/dynamic.hpp"
 #include "delegates.hpp"
 #include "logic/scripting/scripting_functional.hpp"
+#include "logic/scripting/scripting_profiler.hpp"
 #include "lua_util.hpp"
 
 namespace lua {
@@ -18,4 +19,38 @@ namespace lua {
         std::function<int(lua::State*)> args = [](auto*) { return 0; }
     );
     lua::State* get_main_thread();
+
+    /// @brief Emit event by registry reference to its handlers list
+    /// (events.handlers[name]). The only handler is called directly,
+    /// several handlers are called by events.emit
+    /// @param handlers reference to the event handlers list
+    /// @param name function returning the event name (called only if
+    /// the name is required)
+    /// @param args function pushing arguments and returning their number
+    /// @return first returned value converted to boolean
+    template <class NameFunc, class ArgsFunc>
+    bool emit_event(
+        lua::State* L, int handlers, const NameFunc& name, const ArgsFunc& args
+    ) {
+        int top = gettop(L);
+        pushref(L, handlers);
+        size_t count = objlen(L, -1);
+        if (count != 1) {
+            pop(L);
+            // no handlers left after pack.unload
+            return count > 0 && emit_event(L, name(), args);
+        }
+        rawgeti(L, 1);
+        remove(L, -2);
+        scripting::profiler::Scope scope(topointer(L, -1), [&](auto& entry) {
+            entry.name = name();
+            entry.source = getsource(L, -1);
+        });
+        bool result = false;
+        if (call_nothrow(L, args(L)) && gettop(L) > top) {
+            result = toboolean(L, top + 1);
+        }
+        pop(L, gettop(L) - top);
+        return result;
+    }
 }
@@ -0,0 +1,176 @@
+#include "lua_tasks.hpp"
+
+#include <chrono>
+#include <deque>
+#include <unordered_map>
+
+#include "logic/scripting/scripting_profiler.hpp"
+#include "lua_util.hpp"
+
+using namespace lua;
+using std::chrono::steady_clock;
+
+namespace {
+    struct Task {
+        int ref;
+        lua::State* thread;
+        /// @brief number of arguments passed on the first resume
+        int argc;
+        /// @brief task cancelled while running
+        bool cancelled = false;
+    };
+}
+
+/// @brief Number of VM instructions between budget checks.
+/// JIT-compiled code is not interrupted by the hook, so long compiled
+/// loops should yield explicitly
+inline constexpr int HOOK_INSTRUCTIONS = 1000;
+inline constexpr double DEFAULT_BUDGET = 0.002;
+
+static std::unordered_map<uint64_t, Task> tasks_map;
+/// @brief Round-robin resume order (may contain removed tasks ids)
+static std::deque<uint64_t> queue;
+static uint64_t next_id = 1;
+static double budget = DEFAULT_BUDGET;
+static lua::State* running = nullptr;
+static steady_clock::time_point deadline;
+
+/// @brief Check if the thread may be suspended from the hook:
+/// yield across C functions (pcall, metamethods, callbacks) is not allowed
+static bool is_yieldable(lua::State* L) {
+    lua_Debug ar;
+    for (int level = 0; lua_getstack(L, level, &ar); level++) {
+        if (!lua_getinfo(L, "S", &ar) || ar.what[0] == 'C') {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void budget_hook(lua::State* L, lua_Debug*) {
+    // hooks are global in LuaJIT: ignore engine callbacks made by the task
+    if (L != running || steady_clock::now() < deadline) {
+        return;
+    }
+    if (is_yieldable(L)) {
+        lua_yield(L, 0);
+    }
+}
+
+uint64_t tasks::spawn(lua::State* L, int argc) {
+    auto thread = lua_newthread(L);
+    lua::insert(L, -(argc + 2));
+    lua_xmove(L, thread, argc + 1);
+    int ref = lua::ref(L);
+
+    uint64_t id = next_id++;
+    tasks_map[id] = Task {ref, thread, argc};
+    queue.push_back(id);
+    return id;
+}
+
+bool tasks::is_alive(uint64_t id) {
+    const auto& found = tasks_map.find(id);
+    return found != tasks_map.end() && !found->second.cancelled;
+}
+
+void tasks::cancel(lua::State* L, uint64_t id) {
+    const auto& found = tasks_map.find(id);
+    if (found == tasks_map.end()) {
+        return;
+    }
+    auto& task = found->second;
+    if (task.thread == running) {
+        // the thread must stay referenced until resume returns
+        task.cancelled = true;
+        return;
+    }
+    lua::unref(L, task.ref);
+    tasks_map.erase(found);
+}
+
+size_t tasks::count() {
+    return tasks_map.size();
+}
+
+void tasks::set_budget(double seconds) {
+    budget = seconds;
+}
+
+double tasks::get_budget() {
+    return budget;
+}
+
+/// @return true if task is suspended and must be resumed later
+static bool resume(lua::State* L, Task& task) {
+    int argc = task.argc;
+    task.argc = 0;
+
+    running = task.thread;
+    lua_sethook(task.thread, budget_hook, LUA_MASKCOUNT, HOOK_INSTRUCTIONS);
+    int status = lua_resume(task.thread, argc);
+    lua_sethook(task.thread, nullptr, 0, 0);
+    running = nullptr;
+
+    if (status == LUA_YIELD) {
+        // yielded values are not used
+        lua_settop(task.thread, 0);
+        return !task.cancelled;
+    }
+    if (status != 0) {
+        luaL_traceback(L, task.thread, lua_tostring(task.thread, -1), 0);
+        log_error(tostring(L, -1));
+        pop(L);
+    }
+    return false;
+}
+
+void tasks::process(lua::State* L) {
+    if (queue.empty()) {
+        return;
+    }
+    scripting::profiler::Scope scope([](auto& entry) {
+        entry.name = "tasks.process";
+    });
+    deadline = steady_clock::now() +
+               std::chrono::duration_cast<steady_clock::duration>(
+                   std::chrono::duration<double>(budget)
+               );
+    // tasks spawned during processing are resumed next frame
+    size_t count = queue.size();
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0 && steady_clock::now() >= deadline) {
+            break;
+        }
+        uint64_t id = queue.front();
+        queue.pop_front();
+
+        auto found = tasks_map.find(id);
+        if (found == tasks_map.end()) {
+            continue;
+        }
+        // unlike iterators, references stay valid if task spawns new ones
+        auto& task = found->second;
+        if (resume(L, task)) {
+            queue.push_back(id);
+        } else {
+            lua::unref(L, task.ref);
+            tasks_map.erase(id);
+        }
+    }
+}
+
+void tasks::clear(lua::State* L) {
+    for (auto it = tasks_map.begin(); it != tasks_map.end();) {
+        if (it->second.thread == running) {
+            it->second.cancelled = true;
+            ++it;
+            continue;
+        }
+        lua::unref(L, it->second.ref);
+        it = tasks_map.erase(it);
+    }
+    if (tasks_map.empty()) {
+        queue.clear();
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "lua_commons.hpp"
+
+/// @brief Coroutines scheduler running script tasks in time slices.
+/// Tasks are resumed once per frame until the frame time budget is spent.
+/// A task yields explicitly (coroutine.yield) or is suspended by a debug
+/// hook when the budget is exceeded
+namespace lua::tasks {
+    /// @brief Create task from function and arguments at the stack top
+    /// (popped)
+    /// @param argc number of arguments
+    /// @return task id
+    uint64_t spawn(lua::State* L, int argc);
+
+    bool is_alive(uint64_t id);
+
+    /// @brief Remove task (does nothing if task does not exist)
+    void cancel(lua::State* L, uint64_t id);
+
+    size_t count();
+
+    /// @param seconds time limit of all tasks resumes per frame
+    void set_budget(double seconds);
+
+    double get_budget();
+
+    /// @brief Resume tasks until the budget is spent
+    void process(lua::State* L);
+
+    /// @brief Remove all tasks
+    void clear(lua::State* L);
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <type_traits>
 #include <typeindex>
 #include <typeinfo>
 #include <unordered_map>
@@ -18,6 +19,43 @@ namespace lua {
 
     std::string env_name(int env);
 
+    /// @brief Registry key of the T usertype metatable
+    template <class T>
+    inline void* usertype_key() {
+        return const_cast<std::string*>(&T::TYPENAME);
+    }
+
+    /// @brief Check the value metatable is registered for the T usertype
+    /// (by registerusertype) as luaL_checkudata does, so light userdata and
+    /// userdata created by other code are never cast
+    /// @return nullptr if value is not an userdata of the T type
+    template <class T>
+    inline T* touserdata(lua::State* L, int idx) {
+        if (lua_type(L, idx) != LUA_TUSERDATA) {
+            return nullptr;
+        }
+        void* rawptr = lua_touserdata(L, idx);
+        if (!lua_getmetatable(L, idx)) {
+            return nullptr;
+        }
+        bool valid;
+        if constexpr (std::is_same_v<T, Userdata>) {
+            // any usertype metatable is marked in the registry
+            lua_rawget(L, LUA_REGISTRYINDEX);
+            valid = lua_toboolean(L, -1);
+            lua_pop(L, 1);
+        } else {
+            lua_pushlightuserdata(L, usertype_key<T>());
+            lua_rawget(L, LUA_REGISTRYINDEX);
+            valid = lua_rawequal(L, -1, -2);
+            lua_pop(L, 2);
+        }
+        if (!valid) {
+            return nullptr;
+        }
+        return static_cast<T*>(static_cast<Userdata*>(rawptr));
+    }
+
     inline bool getglobal(lua::State* L, const std::string& name) {
         lua_getglobal(L, name.c_str());
         if (isnil(L, -1)) {
@@ -133,6 +171,10 @@ namespace lua {
     /// @brief pushes matrix table to the stack and updates it with glm matrix
     inline int setmat4(lua::State* L, int idx, glm::mat4 matrix) {
         pushvalue(L, idx);
+        if (auto dst = touserdata<Matrix4>(L, -1)) {
+            dst->data() = matrix;
+            return 1;
+        }
         for (uint y = 0; y < 4; y++) {
             for (uint x = 0; x < 4; x++) {
                 uint i = y * 4 + x;
@@ -145,6 +187,10 @@ namespace lua {
     template <int n>
     inline int setvec(lua::State* L, int idx, glm::vec<n, float> vec) {
         pushvalue(L, idx);
+        if (auto dst = touserdata<Vector<n>>(L, -1)) {
+            dst->data() = vec;
+            return 1;
+        }
         for (int i = 0; i < n; i++) {
             pushnumber(L, vec[i]);
             rawseti(L, i + 1);
@@ -217,18 +263,11 @@ namespace lua {
     inline void setglobal(lua::State* L, const std::string& name) {
         lua_setglobal(L, name.c_str());
     }
-    template <class T>
-    inline T* touserdata(lua::State* L, int idx) {
-        if (void* rawptr = lua_touserdata(L, idx)) {
-            return static_cast<T*>(rawptr);
-        }
-        return nullptr;
-    }
     template <class T, typename... Args>
     inline int newuserdata(lua::State* L, Args&&... args) {
         const auto& found = usertypeNames.find(typeid(T));
         void* ptr = lua_newuserdata(L, sizeof(T));
-        new (ptr) T(args...);
+        new (ptr) T(std::forward<Args>(args)...);
 
         if (found == usertypeNames.end()) {
             log_error(
@@ -240,6 +279,19 @@ namespace lua {
         return 1;
     }
 
+    /// @brief Store usertype metatable on top of the stack in the registry
+    /// to be accepted by touserdata
+    template <class T>
+    inline void registerusertype(lua::State* L) {
+        lua_pushlightuserdata(L, usertype_key<T>());
+        pushvalue(L, -2);
+        lua_rawset(L, LUA_REGISTRYINDEX);
+
+        pushvalue(L, -1);
+        pushboolean(L, true);
+        lua_rawset(L, LUA_REGISTRYINDEX);
+    }
+
     template <class T, lua_CFunction func>
     inline void newusertype(lua::State* L, const std::string& name) {
         usertypeNames[typeid(T)] = name;
@@ -247,12 +299,16 @@ namespace lua {
 
         pushcfunction(L, userdata_destructor);
         setfield(L, "__gc");
+        registerusertype<T>(L);
 
         setglobal(L, name);
     }
 
     template <int n>
     inline glm::vec<n, float> tovec(lua::State* L, int idx) {
+        if (auto vector = touserdata<Vector<n>>(L, idx)) {
+            return vector->data();
+        }
         pushvalue(L, idx);
         if (!istable(L, idx) || objlen(L, idx) < n) {
             throw std::runtime_error(
@@ -270,55 +326,13 @@ namespace lua {
     }
 
     inline glm::vec2 tovec2(lua::State* L, int idx) {
-        pushvalue(L, idx);
-        if (!istable(L, idx) || objlen(L, idx) < 2) {
-            throw std::runtime_error("value must be an array of two numbers");
-        }
-        rawgeti(L, 1);
-        auto x = tonumber(L, -1);
-        pop(L);
-        rawgeti(L, 2);
-        auto y = tonumber(L, -1);
-        pop(L);
-        pop(L);
-        return glm::vec2(x, y);
+        return tovec<2>(L, idx);
     }
     inline glm::vec3 tovec3(lua::State* L, int idx) {
-        pushvalue(L, idx);
-        if (!istable(L, idx) || objlen(L, idx) < 3) {
-            throw std::runtime_error("value must be an array of three numbers");
-        }
-        rawgeti(L, 1);
-        auto x = tonumber(L, -1);
-        pop(L);
-        rawgeti(L, 2);
-        auto y = tonumber(L, -1);
-        pop(L);
-        rawgeti(L, 3);
-        auto z = tonumber(L, -1);
-        pop(L);
-        pop(L);
-        return glm::vec3(x, y, z);
+        return tovec<3>(L, idx);
     }
     inline glm::vec4 tovec4(lua::State* L, int idx) {
-        pushvalue(L, idx);
-        if (!istable(L, idx) || objlen(L, idx) < 4) {
-            throw std::runtime_error("value must be an array of four numbers");
-        }
-        rawgeti(L, 1);
-        auto x = tonumber(L, -1);
-        pop(L);
-        rawgeti(L, 2);
-        auto y = tonumber(L, -1);
-        pop(L);
-        rawgeti(L, 3);
-        auto z = tonumber(L, -1);
-        pop(L);
-        rawgeti(L, 4);
-        auto w = tonumber(L, -1);
-        pop(L);
-        pop(L);
-        return glm::vec4(x, y, z, w);
+        return tovec<4>(L, idx);
     }
 
     inline glm::quat toquat(lua::State* L, int idx) {
@@ -356,6 +370,9 @@ namespace lua {
         );
     }
     inline glm::mat4 tomat4(lua::State* L, int idx) {
+        if (auto matrix = touserdata<Matrix4>(L, idx)) {
+            return matrix->data();
+        }
         pushvalue(L, idx);
         if (!istable(L, idx) || objlen(L, idx) < 16) {
             throw std::runtime_error("value must be an array of 16 numbers");
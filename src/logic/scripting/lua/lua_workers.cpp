@@ -0,0 +1,245 @@
+#include "lua_workers.hpp"
+
+#include <atomic>
+#include <optional>
+#include <unordered_map>
+
+#include "content/Content.hpp"
+#include "util/ThreadPool.hpp"
+#include "voxels/Block.hpp"
+#include "voxels/VoxelsVolume.hpp"
+#include "api_lua.hpp"
+
+using namespace lua;
+using namespace lua::workers;
+
+namespace {
+    struct Job {
+        uint64_t id;
+        std::string bytecode;
+        dynamic::List_sptr args;
+        std::shared_ptr<VoxelsVolume> snapshot;
+    };
+}
+
+/// @brief Instructions executed by a job between cancellation checks
+static constexpr int CANCEL_CHECK_INSTRUCTIONS = 10000;
+
+/// @brief Set on shutdown to interrupt running jobs before joining workers
+static std::atomic<bool> cancel_jobs = false;
+
+/// @brief Job being processed by the current worker thread
+static thread_local const Job* current_job = nullptr;
+/// @brief Content of the current worker thread
+static thread_local const Content* current_content = nullptr;
+
+static const voxel* get_snapshot_voxel(lua::State* L) {
+    if (current_job == nullptr || current_job->snapshot == nullptr) {
+        throw std::runtime_error("no blocks snapshot submitted with the job");
+    }
+    const auto& snapshot = *current_job->snapshot;
+    auto x = lua::tointeger(L, 1) - snapshot.getX();
+    auto y = lua::tointeger(L, 2) - snapshot.getY();
+    auto z = lua::tointeger(L, 3) - snapshot.getZ();
+    if (x < 0 || y < 0 || z < 0 || x >= snapshot.getW() ||
+        y >= snapshot.getH() || z >= snapshot.getD()) {
+        return nullptr;
+    }
+    const auto& vox = snapshot.getVoxels()[vox_index(
+        x, y, z, snapshot.getW(), snapshot.getD()
+    )];
+    return vox.id == BLOCK_VOID ? nullptr : &vox;
+}
+
+static int l_worker_block_get(lua::State* L) {
+    auto vox = get_snapshot_voxel(L);
+    return lua::pushinteger(L, vox == nullptr ? -1 : vox->id);
+}
+
+static int l_worker_block_get_states(lua::State* L) {
+    auto vox = get_snapshot_voxel(L);
+    int states = vox == nullptr ? 0 : blockstate2int(vox->state);
+    return lua::pushinteger(L, states);
+}
+
+static const Content* require_content() {
+    if (current_content == nullptr) {
+        throw std::runtime_error("no content loaded");
+    }
+    return current_content;
+}
+
+static int l_worker_block_index(lua::State* L) {
+    auto name = lua::require_string(L, 1);
+    return lua::pushinteger(L, require_content()->blocks.require(name).rt.id);
+}
+
+static int l_worker_block_name(lua::State* L) {
+    auto id = lua::tointeger(L, 1);
+    auto def = require_content()->getIndices()->blocks.get(id);
+    if (def == nullptr) {
+        return 0;
+    }
+    return lua::pushstring(L, def->name);
+}
+
+static const luaL_Reg workerblocklib[] = {
+    {"get", lua::wrap<l_worker_block_get>},
+    {"get_states", lua::wrap<l_worker_block_get_states>},
+    {"index", lua::wrap<l_worker_block_index>},
+    {"name", lua::wrap<l_worker_block_name>},
+    {NULL, NULL}};
+
+/// @brief Create usertype metatable without usertypeNames modification
+/// (types are registered by the main state)
+template <class T, lua_CFunction func>
+static void worker_usertype(lua::State* L, const std::string& name) {
+    func(L);
+    pushcfunction(L, userdata_destructor);
+    setfield(L, "__gc");
+    registerusertype<T>(L);
+    setglobal(L, name);
+}
+
+static void cancel_hook(lua::State* L, lua_Debug*) {
+    if (cancel_jobs) {
+        luaL_error(L, "job cancelled");
+    }
+}
+
+class LuaWorker : public util::Worker<Job, JobResult> {
+    lua::State* L;
+    const Content* content;
+public:
+    LuaWorker(const Content* content) : content(content) {
+        L = luaL_newstate();
+        if (L == nullptr) {
+            throw luaerror("could not to initialize worker Lua state");
+        }
+        pop(L, luaopen_base(L));
+        pop(L, luaopen_math(L));
+        pop(L, luaopen_string(L));
+        pop(L, luaopen_table(L));
+        pop(L, luaopen_bit(L));
+        for (auto name : {"dofile", "loadfile", "print"}) {
+            pushnil(L);
+            setglobal(L, name);
+        }
+        openlib(L, "block", workerblocklib);
+        openlib(L, "mat4", mat4lib);
+        openlib(L, "quat", quatlib);
+        openlib(L, "vec2", vec2lib);
+        openlib(L, "vec3", vec3lib);
+        openlib(L, "vec4", vec4lib);
+
+        worker_usertype<Vector<2>, Vector<2>::createMetatable>(L, "__vec2");
+        worker_usertype<Vector<3>, Vector<3>::createMetatable>(L, "__vec3");
+        worker_usertype<Vector<4>, Vector<4>::createMetatable>(L, "__vec4");
+        worker_usertype<Matrix4, Matrix4::createMetatable>(L, "__mat4");
+
+        // hooks are not called from JIT-compiled code, so a looping job
+        // could not be cancelled
+        luaJIT_setmode(L, 0, LUAJIT_MODE_ENGINE | LUAJIT_MODE_OFF);
+        lua_sethook(L, cancel_hook, LUA_MASKCOUNT, CANCEL_CHECK_INSTRUCTIONS);
+    }
+
+    ~LuaWorker() {
+        lua_close(L);
+    }
+
+    JobResult operator()(const std::shared_ptr<Job>& job) override {
+        current_job = job.get();
+        current_content = content;
+
+        JobResult result {job->id, false, dynamic::NONE, ""};
+        int top = gettop(L);
+        const auto& code = job->bytecode;
+        if (luaL_loadbuffer(L, code.data(), code.size(), "=job")) {
+            result.error = tostring(L, -1);
+        } else {
+            int argc = 0;
+            if (job->args) {
+                for (const auto& arg : job->args->values) {
+                    pushvalue(L, arg);
+                    argc++;
+                }
+            }
+            if (lua_pcall(L, argc, 1, 0)) {
+                result.error = tostring(L, -1);
+            } else {
+                try {
+                    result.value = tovalue(L, -1);
+                    result.success = true;
+                } catch (const std::runtime_error& err) {
+                    result.error = err.what();
+                }
+            }
+        }
+        lua_settop(L, top);
+        current_job = nullptr;
+        return result;
+    }
+};
+
+static std::unique_ptr<util::ThreadPool<Job, JobResult>> pool;
+/// @brief Submitted jobs results (empty if not finished)
+static std::unordered_map<uint64_t, std::optional<JobResult>> results;
+static uint64_t next_id = 1;
+
+uint64_t workers::submit(
+    const Content* content,
+    std::string bytecode,
+    dynamic::List_sptr args,
+    std::shared_ptr<VoxelsVolume> snapshot
+) {
+    if (pool == nullptr) {
+        pool = std::make_unique<util::ThreadPool<Job, JobResult>>(
+            "lua-workers",
+            [content]() { return std::make_shared<LuaWorker>(content); },
+            [](JobResult& result) {
+                const auto& found = results.find(result.id);
+                if (found != results.end()) {
+                    found->second = std::move(result);
+                }
+            }
+        );
+        pool->setStopOnFail(false);
+    }
+    uint64_t id = next_id++;
+    results[id] = std::nullopt;
+    pool->enqueueJob(std::make_shared<Job>(
+        Job {id, std::move(bytecode), std::move(args), std::move(snapshot)}
+    ));
+    return id;
+}
+
+bool workers::poll(uint64_t id, JobResult& dst) {
+    const auto& found = results.find(id);
+    if (found == results.end()) {
+        throw std::runtime_error("job " + std::to_string(id) + " not found");
+    }
+    if (!found->second.has_value()) {
+        return false;
+    }
+    dst = std::move(*found->second);
+    results.erase(found);
+    return true;
+}
+
+size_t workers::count() {
+    return results.size();
+}
+
+void workers::update() {
+    if (pool) {
+        pool->update();
+    }
+}
+
+void workers::shutdown() {
+    // running jobs are interrupted, queued ones are dropped by the pool
+    cancel_jobs = true;
+    pool = nullptr;
+    cancel_jobs = false;
+    results.clear();
+}
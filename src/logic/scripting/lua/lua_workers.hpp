@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "data/dynamic.hpp"
+
+class Content;
+class VoxelsVolume;
+
+/// @brief Pool of separate Lua states running side-effect-free jobs in
+/// parallel with the main thread. Worker states have math, vector and
+/// matrix libraries and read-only access to blocks copied on job submission
+namespace lua::workers {
+    struct JobResult {
+        uint64_t id;
+        bool success;
+        /// @brief value returned by the job function
+        dynamic::Value value;
+        /// @brief error message if job failed
+        std::string error;
+    };
+
+    /// @brief Enqueue a job, workers are started on first call
+    /// @param content content used by workers 'block' library
+    /// @param bytecode dumped Lua function without upvalues
+    /// @param args function arguments (may be nullptr)
+    /// @param snapshot blocks available to the job (may be nullptr)
+    /// @return job id
+    uint64_t submit(
+        const Content* content,
+        std::string bytecode,
+        dynamic::List_sptr args,
+        std::shared_ptr<VoxelsVolume> snapshot
+    );
+
+    /// @brief Take result of finished job
+    /// @param dst result destination
+    /// @return false if job is not finished yet
+    /// @throws std::runtime_error if job does not exist
+    bool poll(uint64_t id, JobResult& dst);
+
+    /// @return number of submitted jobs which results are not taken
+    size_t count();
+
+    /// @brief Collect finished jobs results (called on the main thread)
+    void update();
+
+    /// @brief Stop workers, drop all jobs and results
+    void shutdown();
+}
@@ -56,6 +56,48 @@ namespace lua {
         lua_rawseti(L, idx, n);
     }
 
+    /// @brief Pop value from the stack and store it in the registry
+    /// @return reference to the stored value
+    inline int ref(lua::State* L) {
+        return luaL_ref(L, LUA_REGISTRYINDEX);
+    }
+    inline void unref(lua::State* L, int ref) {
+        luaL_unref(L, LUA_REGISTRYINDEX, ref);
+    }
+    inline int pushref(lua::State* L, int ref) {
+        lua_rawgeti(L, LUA_REGISTRYINDEX, ref);
+        return 1;
+    }
+
+    /// @return Lua heap size in bytes
+    inline size_t heapsize(lua::State* L) {
+        return static_cast<size_t>(lua_gc(L, LUA_GCCOUNT, 0)) * 1024 +
+               lua_gc(L, LUA_GCCOUNTB, 0);
+    }
+    /// @brief Perform incremental garbage collection step
+    /// @param size step size (kilobytes)
+    /// @return true if the step finished a collection cycle
+    inline bool gcstep(lua::State* L, int size) {
+        return lua_gc(L, LUA_GCSTEP, size) == 1;
+    }
+    /// @param pause heap growth (percents) starting a new collection cycle
+    inline void gcsetpause(lua::State* L, int pause) {
+        lua_gc(L, LUA_GCSETPAUSE, pause);
+    }
+    /// @return chunk name of the function at the index
+    inline std::string getsource(lua::State* L, int idx) {
+        lua_Debug ar {};
+        lua_pushvalue(L, idx);
+        if (!lua_getinfo(L, ">S", &ar) || ar.source == nullptr) {
+            return "";
+        }
+        const char* source = ar.source;
+        if (*source == '@' || *source == '=') {
+            source++;
+        }
+        return source;
+    }
+
     inline int createtable(lua::State* L, int narr, int nrec) {
         lua_createtable(L, narr, nrec);
         return 1;
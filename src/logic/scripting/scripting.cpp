@@ -22,6 +22,10 @@
 #include "voxels/Block.hpp"
 #include "world/Level.hpp"
 #include "lua/lua_engine.hpp"
+#include "lua/lua_tasks.hpp"
+#include "lua/lua_workers.hpp"
+#include "scripting_gc.hpp"
+#include "scripting_profiler.hpp"
 
 using namespace scripting;
 
@@ -52,7 +56,9 @@ static void load_script(const fs::path& name, bool throwable) {
 void scripting::initialize(Engine* engine) {
     scripting::engine = engine;
     lua::initialize();
+    gc::initialize();
 
+    load_script(fs::path("events.lua"), true);
     load_script(fs::path("stdlib.lua"), true);
     load_script(fs::path("stdcmd.lua"), true);
     load_script(fs::path("classes.lua"), true);
@@ -141,6 +147,8 @@ void scripting::process_post_runnables() {
     if (lua::getglobal(L, "__process_post_runnables")) {
         lua::call_nothrow(L, 0);
     }
+    lua::tasks::process(L);
+    lua::workers::update();
 }
 
 void scripting::on_world_load(LevelController* controller) {
@@ -185,6 +193,8 @@ void scripting::on_world_quit() {
     }
     lua::pop(L);
 
+    lua::tasks::clear(L);
+    lua::workers::shutdown();
     if (lua::getglobal(L, "__scripts_cleanup")) {
         lua::call_nothrow(L, 0);
     }
@@ -195,36 +205,119 @@ void scripting::on_world_quit() {
     scripting::controller = nullptr;
 }
 
-void scripting::on_blocks_tick(const Block& block, int tps) {
-    std::string name = block.name + ".blockstick";
-    lua::emit_event(lua::get_main_thread(), name, [tps](auto L) {
-        return lua::pushinteger(L, tps);
+/// @brief Pop value from the stack and keep a registry reference to it
+/// @return reference handle
+/// @note handles of unloaded callbacks may share addresses with new ones,
+/// so profiler keys are cleared after each batch of created handles
+static scriptfunc create_scriptfunc(lua::State* L) {
+    int ref = lua::ref(L);
+    return std::shared_ptr<int>(new int(ref), [=](int* ref) { //-V508
+        lua::unref(L, *ref);
+        delete ref;
     });
 }
 
+/// @brief Get function reference from the table at the stack top
+/// @return nullptr if function is not defined
+static scriptfunc get_scriptfunc(lua::State* L, const std::string& name) {
+    if (!lua::getfield(L, name)) {
+        return nullptr;
+    }
+    return create_scriptfunc(L);
+}
+
+/// @brief Emit block or item event by pre-resolved handlers list
+/// @param handlers handlers list reference
+/// @param owner block or item name
+/// @param event event name suffix
+/// @param args function pushing arguments and returning their number
+/// @return first returned value converted to boolean
+template <class ArgsFunc>
+static bool call_callback(
+    const scriptfunc& handlers,
+    const std::string& owner,
+    const char* event,
+    const ArgsFunc& args
+) {
+    if (handlers == nullptr) {
+        return false;
+    }
+    return lua::emit_event(
+        lua::get_main_thread(),
+        *handlers,
+        [&]() { return owner + "." + event; },
+        args
+    );
+}
+
+void scripting::on_blocks_tick(const Block& block, int tps) {
+    call_callback(
+        block.rt.callbacks.onblockstick,
+        block.name,
+        "blockstick",
+        [tps](auto L) {
+            return lua::pushinteger(L, tps);
+        }
+    );
+}
+
 void scripting::update_block(const Block& block, int x, int y, int z) {
-    std::string name = block.name + ".update";
-    lua::emit_event(lua::get_main_thread(), name, [x, y, z](auto L) {
-        return lua::pushivec_stack(L, glm::ivec3(x, y, z));
-    });
+    call_callback(
+        block.rt.callbacks.update,
+        block.name,
+        "update",
+        [x, y, z](auto L) {
+            return lua::pushivec_stack(L, glm::ivec3(x, y, z));
+        }
+    );
 }
 
 void scripting::random_update_block(const Block& block, int x, int y, int z) {
-    std::string name = block.name + ".randupdate";
-    lua::emit_event(lua::get_main_thread(), name, [x, y, z](auto L) {
-        return lua::pushivec_stack(L, glm::ivec3(x, y, z));
-    });
+    call_callback(
+        block.rt.callbacks.randupdate,
+        block.name,
+        "randupdate",
+        [x, y, z](auto L) {
+            return lua::pushivec_stack(L, glm::ivec3(x, y, z));
+        }
+    );
+}
+
+void scripting::random_update_blocks(
+    const Block& block, const std::vector<glm::ivec3>& positions
+) {
+    call_callback(
+        block.rt.callbacks.randupdatebatch,
+        block.name,
+        "randupdatebatch",
+        [&](lua::State* L) {
+            lua::createtable(L, positions.size() * 3, 0);
+            int index = 1;
+            for (const auto& pos : positions) {
+                for (int i = 0; i < 3; i++) {
+                    lua::pushinteger(L, pos[i]);
+                    lua::rawseti(L, index++);
+                }
+            }
+            lua::pushinteger(L, positions.size());
+            return 2;
+        }
+    );
 }
 
 void scripting::on_block_placed(
     Player* player, const Block& block, int x, int y, int z
 ) {
-    std::string name = block.name + ".placed";
-    lua::emit_event(lua::get_main_thread(), name, [x, y, z, player](auto L) {
-        lua::pushivec_stack(L, glm::ivec3(x, y, z));
-        lua::pushinteger(L, player ? player->getId() : -1);
-        return 4;
-    });
+    call_callback(
+        block.rt.callbacks.onplaced,
+        block.name,
+        "placed",
+        [x, y, z, player](auto L) {
+            lua::pushivec_stack(L, glm::ivec3(x, y, z));
+            lua::pushinteger(L, player ? player->getId() : -1);
+            return 4;
+        }
+    );
     auto world_event_args = [&](lua::State* L) {
         lua::pushinteger(L, block.rt.id);
         lua::pushivec_stack(L, glm::ivec3(x, y, z));
@@ -245,18 +338,16 @@ void scripting::on_block_placed(
 void scripting::on_block_broken(
     Player* player, const Block& block, int x, int y, int z
 ) {
-    if (block.rt.funcsset.onbroken) {
-        std::string name = block.name + ".broken";
-        lua::emit_event(
-            lua::get_main_thread(),
-            name,
-            [x, y, z, player](auto L) {
-                lua::pushivec_stack(L, glm::ivec3(x, y, z));
-                lua::pushinteger(L, player ? player->getId() : -1);
-                return 4;
-            }
-        );
-    }
+    call_callback(
+        block.rt.callbacks.onbroken,
+        block.name,
+        "broken",
+        [x, y, z, player](auto L) {
+            lua::pushivec_stack(L, glm::ivec3(x, y, z));
+            lua::pushinteger(L, player ? player->getId() : -1);
+            return 4;
+        }
+    );
     auto world_event_args = [&](lua::State* L) {
         lua::pushinteger(L, block.rt.id);
         lua::pushivec_stack(L, glm::ivec3(x, y, z));
@@ -277,30 +368,36 @@ void scripting::on_block_broken(
 bool scripting::on_block_interact(
     Player* player, const Block& block, glm::ivec3 pos
 ) {
-    std::string name = block.name + ".interact";
-    return lua::emit_event(lua::get_main_thread(), name, [pos, player](auto L) {
-        lua::pushivec_stack(L, pos);
-        lua::pushinteger(L, player->getId());
-        return 4;
-    });
+    return call_callback(
+        block.rt.callbacks.oninteract,
+        block.name,
+        "interact",
+        [pos, player](auto L) {
+            lua::pushivec_stack(L, pos);
+            lua::pushinteger(L, player->getId());
+            return 4;
+        }
+    );
 }
 
 bool scripting::on_item_use(Player* player, const ItemDef& item) {
-    std::string name = item.name + ".use";
-    return lua::emit_event(
-        lua::get_main_thread(),
-        name,
-        [player](lua::State* L) { return lua::pushinteger(L, player->getId()); }
+    return call_callback(
+        item.rt.callbacks.on_use,
+        item.name,
+        "use",
+        [player](auto L) {
+            return lua::pushinteger(L, player->getId());
+        }
     );
 }
 
 bool scripting::on_item_use_on_block(
     Player* player, const ItemDef& item, glm::ivec3 ipos, glm::ivec3 normal
 ) {
-    std::string name = item.name + ".useon";
-    return lua::emit_event(
-        lua::get_main_thread(),
-        name,
+    return call_callback(
+        item.rt.callbacks.on_use_on_block,
+        item.name,
+        "useon",
         [ipos, normal, player](auto L) {
             lua::pushivec_stack(L, ipos);
             lua::pushinteger(L, player->getId());
@@ -313,10 +410,10 @@ bool scripting::on_item_use_on_block(
 bool scripting::on_item_break_block(
     Player* player, const ItemDef& item, int x, int y, int z
 ) {
-    std::string name = item.name + ".blockbreakby";
-    return lua::emit_event(
-        lua::get_main_thread(),
-        name,
+    return call_callback(
+        item.rt.callbacks.on_block_break_by,
+        item.name,
+        "blockbreakby",
         [x, y, z, player](auto L) {
             lua::pushivec_stack(L, glm::ivec3(x, y, z));
             lua::pushinteger(L, player->getId());
@@ -389,57 +486,66 @@ void scripting::on_entity_spawn(
         lua::call_nothrow(L, 0, 0);
 
         lua::pushenv(L, *compenv);
-        auto& funcsset = component->funcsset;
-        funcsset.on_grounded = lua::hasfield(L, "on_grounded");
-        funcsset.on_fall = lua::hasfield(L, "on_fall");
-        funcsset.on_despawn = lua::hasfield(L, "on_despawn");
-        funcsset.on_sensor_enter = lua::hasfield(L, "on_sensor_enter");
-        funcsset.on_sensor_exit = lua::hasfield(L, "on_sensor_exit");
-        funcsset.on_save = lua::hasfield(L, "on_save");
-        funcsset.on_aim_on = lua::hasfield(L, "on_aim_on");
-        funcsset.on_aim_off = lua::hasfield(L, "on_aim_off");
-        funcsset.on_attacked = lua::hasfield(L, "on_attacked");
-        funcsset.on_used = lua::hasfield(L, "on_used");
+        auto& callbacks = component->callbacks;
+        callbacks.on_grounded = get_scriptfunc(L, "on_grounded");
+        callbacks.on_fall = get_scriptfunc(L, "on_fall");
+        callbacks.on_despawn = get_scriptfunc(L, "on_despawn");
+        callbacks.on_sensor_enter = get_scriptfunc(L, "on_sensor_enter");
+        callbacks.on_sensor_exit = get_scriptfunc(L, "on_sensor_exit");
+        callbacks.on_save = get_scriptfunc(L, "on_save");
+        callbacks.on_aim_on = get_scriptfunc(L, "on_aim_on");
+        callbacks.on_aim_off = get_scriptfunc(L, "on_aim_off");
+        callbacks.on_attacked = get_scriptfunc(L, "on_attacked");
+        callbacks.on_used = get_scriptfunc(L, "on_used");
+        callbacks.on_update = get_scriptfunc(L, "on_update");
+        callbacks.on_render = get_scriptfunc(L, "on_render");
         lua::pop(L, 2);
 
-        component->env = compenv;
-    }
-}
+        auto& funcsset = component->funcsset;
+        funcsset.on_grounded = callbacks.on_grounded != nullptr;
+        funcsset.on_fall = callbacks.on_fall != nullptr;
+        funcsset.on_despawn = callbacks.on_despawn != nullptr;
+        funcsset.on_sensor_enter = callbacks.on_sensor_enter != nullptr;
+        funcsset.on_sensor_exit = callbacks.on_sensor_exit != nullptr;
+        funcsset.on_save = callbacks.on_save != nullptr;
+        funcsset.on_aim_on = callbacks.on_aim_on != nullptr;
+        funcsset.on_aim_off = callbacks.on_aim_off != nullptr;
+        funcsset.on_attacked = callbacks.on_attacked != nullptr;
+        funcsset.on_used = callbacks.on_used != nullptr;
 
-static void process_entity_callback(
-    const scriptenv& env,
-    const std::string& name,
-    std::function<int(lua::State*)> args
-) {
-    auto L = lua::get_main_thread();
-    lua::pushenv(L, *env);
-    if (lua::getfield(L, name)) {
-        if (args) {
-            lua::call_nothrow(L, args(L), 0);
-        } else {
-            lua::call_nothrow(L, 0, 0);
-        }
+        component->env = compenv;
     }
-    lua::pop(L);
+    profiler::clear_keys();
 }
 
+/// @brief Call pre-resolved callback of each entity component defining it
+/// @param name callback name (used by profiler)
 static void process_entity_callback(
     const Entity& entity,
-    const std::string& name,
-    bool entity_funcs_set::*flag,
-    std::function<int(lua::State*)> args
+    const char* name,
+    scriptfunc entity_callbacks::*callback,
+    const std::function<int(lua::State*)>& args
 ) {
+    auto L = lua::get_main_thread();
     const auto& script = entity.getScripting();
     for (auto& component : script.components) {
-        if (component->funcsset.*flag) {
-            process_entity_callback(component->env, name, args);
+        const auto& func = component->callbacks.*callback;
+        if (func == nullptr) {
+            continue;
         }
+        profiler::Scope scope([&](auto& entry) {
+            entry.name = component->name + "." + name;
+        });
+        int top = lua::gettop(L);
+        lua::pushref(L, *func);
+        lua::call_nothrow(L, args ? args(L) : 0, 0);
+        lua::pop(L, lua::gettop(L) - top);
     }
 }
 
 void scripting::on_entity_despawn(const Entity& entity) {
     process_entity_callback(
-        entity, "on_despawn", &entity_funcs_set::on_despawn, nullptr
+        entity, "on_despawn", &entity_callbacks::on_despawn, nullptr
     );
     auto L = lua::get_main_thread();
     lua::get_from(L, "stdcomp", "remove_Entity", true);
@@ -451,20 +557,20 @@ void scripting::on_entity_grounded(const Entity& entity, float force) {
     process_entity_callback(
         entity,
         "on_grounded",
-        &entity_funcs_set::on_grounded,
+        &entity_callbacks::on_grounded,
         [force](auto L) { return lua::pushnumber(L, force); }
     );
 }
 
 void scripting::on_entity_fall(const Entity& entity) {
     process_entity_callback(
-        entity, "on_fall", &entity_funcs_set::on_fall, nullptr
+        entity, "on_fall", &entity_callbacks::on_fall, nullptr
     );
 }
 
 void scripting::on_entity_save(const Entity& entity) {
     process_entity_callback(
-        entity, "on_save", &entity_funcs_set::on_save, nullptr
+        entity, "on_save", &entity_callbacks::on_save, nullptr
     );
 }
 
@@ -474,7 +580,7 @@ void scripting::on_sensor_enter(
     process_entity_callback(
         entity,
         "on_sensor_enter",
-        &entity_funcs_set::on_sensor_enter,
+        &entity_callbacks::on_sensor_enter,
         [index, oid](auto L) {
             lua::pushinteger(L, index);
             lua::pushinteger(L, oid);
@@ -489,7 +595,7 @@ void scripting::on_sensor_exit(
     process_entity_callback(
         entity,
         "on_sensor_exit",
-        &entity_funcs_set::on_sensor_exit,
+        &entity_callbacks::on_sensor_exit,
         [index, oid](auto L) {
             lua::pushinteger(L, index);
             lua::pushinteger(L, oid);
@@ -502,7 +608,7 @@ void scripting::on_aim_on(const Entity& entity, Player* player) {
     process_entity_callback(
         entity,
         "on_aim_on",
-        &entity_funcs_set::on_aim_on,
+        &entity_callbacks::on_aim_on,
         [player](auto L) { return lua::pushinteger(L, player->getId()); }
     );
 }
@@ -511,7 +617,7 @@ void scripting::on_aim_off(const Entity& entity, Player* player) {
     process_entity_callback(
         entity,
         "on_aim_off",
-        &entity_funcs_set::on_aim_off,
+        &entity_callbacks::on_aim_off,
         [player](auto L) { return lua::pushinteger(L, player->getId()); }
     );
 }
@@ -522,7 +628,7 @@ void scripting::on_attacked(
     process_entity_callback(
         entity,
         "on_attacked",
-        &entity_funcs_set::on_attacked,
+        &entity_callbacks::on_attacked,
         [player, attacker](auto L) {
             lua::pushinteger(L, attacker);
             lua::pushinteger(L, player->getId());
@@ -535,27 +641,42 @@ void scripting::on_entity_used(const Entity& entity, Player* player) {
     process_entity_callback(
         entity,
         "on_used",
-        &entity_funcs_set::on_used,
+        &entity_callbacks::on_used,
         [player](auto L) { return lua::pushinteger(L, player->getId()); }
     );
 }
 
-void scripting::on_entities_update(int tps, int parts, int part) {
-    auto L = lua::get_main_thread();
-    lua::get_from(L, STDCOMP, "update", true);
-    lua::pushinteger(L, tps);
-    lua::pushinteger(L, parts);
-    lua::pushinteger(L, part);
-    lua::call_nothrow(L, 3, 0);
-    lua::pop(L);
+void scripting::on_entities_update(
+    const std::vector<Entity>& entities, int tps
+) {
+    profiler::Scope scope([](auto& entry) { entry.name = "entities.update"; });
+    std::function<int(lua::State*)> args = [tps](auto L) {
+        return lua::pushinteger(L, tps);
+    };
+    for (const auto& entity : entities) {
+        // may be despawned by previous callbacks
+        if (!entity.getID().destroyFlag) {
+            process_entity_callback(
+                entity, "on_update", &entity_callbacks::on_update, args
+            );
+        }
+    }
 }
 
-void scripting::on_entities_render(float delta) {
-    auto L = lua::get_main_thread();
-    lua::get_from(L, STDCOMP, "render", true);
-    lua::pushnumber(L, delta);
-    lua::call_nothrow(L, 1, 0);
-    lua::pop(L);
+void scripting::on_entities_render(
+    const std::vector<Entity>& entities, float delta
+) {
+    profiler::Scope scope([](auto& entry) { entry.name = "entities.render"; });
+    std::function<int(lua::State*)> args = [delta](auto L) {
+        return lua::pushnumber(L, delta);
+    };
+    for (const auto& entity : entities) {
+        if (!entity.getID().destroyFlag) {
+            process_entity_callback(
+                entity, "on_render", &entity_callbacks::on_render, args
+            );
+        }
+    }
 }
 
 void scripting::on_ui_open(
@@ -626,40 +747,91 @@ static void load_script(
     lua::execute(lua::get_main_thread(), env, src, file.u8string());
 }
 
+/// @brief Register the environment function as event handler and keep
+/// a registry reference to the event handlers list. Handlers added later
+/// by events.on replace it in the same list
+/// @param dst reference handle destination (set to nullptr if not defined)
+/// @return true if function is defined
+static bool register_callback(
+    int env, const std::string& name, const std::string& id, scriptfunc& dst
+) {
+    if (!register_event(env, name, id)) {
+        dst = nullptr;
+        return false;
+    }
+    auto L = lua::get_main_thread();
+    lua::requireglobal(L, "events");
+    lua::getfield(L, "handlers");
+    if (!lua::getfield(L, id)) {
+        lua::pop(L, 2);
+        dst = nullptr;
+        return false;
+    }
+    dst = create_scriptfunc(L);
+    lua::pop(L, 2);
+    return true;
+}
+
 void scripting::load_block_script(
     const scriptenv& senv,
     const std::string& prefix,
     const fs::path& file,
-    block_funcs_set& funcsset
+    block_funcs_set& funcsset,
+    block_callbacks& callbacks
 ) {
     int env = *senv;
     load_script(env, "block", file);
     funcsset.init = register_event(env, "init", prefix + ".init");
-    funcsset.update = register_event(env, "on_update", prefix + ".update");
-    funcsset.randupdate =
-        register_event(env, "on_random_update", prefix + ".randupdate");
-    funcsset.onbroken = register_event(env, "on_broken", prefix + ".broken");
-    funcsset.onplaced = register_event(env, "on_placed", prefix + ".placed");
-    funcsset.oninteract =
-        register_event(env, "on_interact", prefix + ".interact");
-    funcsset.onblockstick =
-        register_event(env, "on_blocks_tick", prefix + ".blockstick");
+    funcsset.update = register_callback(
+        env, "on_update", prefix + ".update", callbacks.update
+    );
+    funcsset.randupdate = register_callback(
+        env, "on_random_update", prefix + ".randupdate", callbacks.randupdate
+    );
+    funcsset.onbroken = register_callback(
+        env, "on_broken", prefix + ".broken", callbacks.onbroken
+    );
+    funcsset.onplaced = register_callback(
+        env, "on_placed", prefix + ".placed", callbacks.onplaced
+    );
+    funcsset.oninteract = register_callback(
+        env, "on_interact", prefix + ".interact", callbacks.oninteract
+    );
+    funcsset.onblockstick = register_callback(
+        env, "on_blocks_tick", prefix + ".blockstick", callbacks.onblockstick
+    );
+    funcsset.randupdatebatch = register_callback(
+        env,
+        "on_random_update_batch",
+        prefix + ".randupdatebatch",
+        callbacks.randupdatebatch
+    );
+    profiler::clear_keys();
 }
 
 void scripting::load_item_script(
     const scriptenv& senv,
     const std::string& prefix,
     const fs::path& file,
-    item_funcs_set& funcsset
+    item_funcs_set& funcsset,
+    item_callbacks& callbacks
 ) {
     int env = *senv;
     load_script(env, "item", file);
     funcsset.init = register_event(env, "init", prefix + ".init");
-    funcsset.on_use = register_event(env, "on_use", prefix + ".use");
-    funcsset.on_use_on_block =
-        register_event(env, "on_use_on_block", prefix + ".useon");
-    funcsset.on_block_break_by =
-        register_event(env, "on_block_break_by", prefix + ".blockbreakby");
+    funcsset.on_use = register_callback(
+        env, "on_use", prefix + ".use", callbacks.on_use
+    );
+    funcsset.on_use_on_block = register_callback(
+        env, "on_use_on_block", prefix + ".useon", callbacks.on_use_on_block
+    );
+    funcsset.on_block_break_by = register_callback(
+        env,
+        "on_block_break_by",
+        prefix + ".blockbreakby",
+        callbacks.on_block_break_by
+    );
+    profiler::clear_keys();
 }
 
 void scripting::load_entity_component(
@@ -706,6 +878,8 @@ void scripting::load_layout_script(
 }
 
 void scripting::close() {
+    lua::tasks::clear(lua::get_main_thread());
+    lua::workers::shutdown();
     lua::finalize();
     content = nullptr;
     indices = nullptr;
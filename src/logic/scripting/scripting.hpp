@@ -24,7 +24,9 @@ struct ItemDef;
 class Inventory;
 class UiDocument;
 struct block_funcs_set;
+struct block_callbacks;
 struct item_funcs_set;
+struct item_callbacks;
 struct world_funcs_set;
 struct UserComponent;
 struct uidocscript;
@@ -63,6 +65,13 @@ namespace scripting {
     void on_blocks_tick(const Block& block, int tps);
     void update_block(const Block& block, int x, int y, int z);
     void random_update_block(const Block& block, int x, int y, int z);
+
+    /// @brief Pass all random updates of the block type made during
+    /// the tick to the block on_random_update_batch callback
+    /// @param positions updated blocks positions
+    void random_update_blocks(
+        const Block& block, const std::vector<glm::ivec3>& positions
+    );
     void on_block_placed(
         Player* player, const Block& block, int x, int y, int z
     );
@@ -101,8 +110,8 @@ namespace scripting {
     void on_entity_grounded(const Entity& entity, float force);
     void on_entity_fall(const Entity& entity);
     void on_entity_save(const Entity& entity);
-    void on_entities_update(int tps, int parts, int part);
-    void on_entities_render(float delta);
+    void on_entities_update(const std::vector<Entity>& entities, int tps);
+    void on_entities_render(const std::vector<Entity>& entities, float delta);
     void on_sensor_enter(const Entity& entity, size_t index, entityid_t oid);
     void on_sensor_exit(const Entity& entity, size_t index, entityid_t oid);
     void on_aim_on(const Entity& entity, Player* player);
@@ -123,11 +132,13 @@ namespace scripting {
     /// @param prefix pack id
     /// @param file item script file
     /// @param funcsset block callbacks set
+    /// @param callbacks block callbacks references destination
     void load_block_script(
         const scriptenv& env,
         const std::string& prefix,
         const fs::path& file,
-        block_funcs_set& funcsset
+        block_funcs_set& funcsset,
+        block_callbacks& callbacks
     );
 
     /// @brief Load script associated with an Item
@@ -135,11 +146,13 @@ namespace scripting {
     /// @param prefix pack id
     /// @param file item script file
     /// @param funcsset item callbacks set
+    /// @param callbacks item callbacks references destination
     void load_item_script(
         const scriptenv& env,
         const std::string& prefix,
         const fs::path& file,
-        item_funcs_set& funcsset
+        item_funcs_set& funcsset,
+        item_callbacks& callbacks
     );
 
     void load_entity_component(const std::string& name, const fs::path& file);
@@ -0,0 +1,104 @@
+#include "scripting_gc.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include "lua/lua_engine.hpp"
+
+using namespace scripting;
+
+using std::chrono::steady_clock;
+
+inline constexpr const char* SENTINEL_METATABLE = "__gc_sentinel";
+
+static gc::Stats stats {};
+/// @brief Incremental cycle started by frame steps is in progress
+static bool collecting = false;
+/// @brief Heap size at the last cycle end (bytes)
+static size_t cycleEndHeap = 0;
+static int currentPause = 200;
+
+static void create_sentinel(lua::State* L);
+
+/// @brief Finalizer of an unreachable userdata called once per cycle.
+/// Creates the next sentinel to be collected by the next cycle
+static int l_sentinel_gc(lua::State* L) {
+    stats.cycles++;
+    collecting = false;
+    cycleEndHeap = lua::heapsize(L);
+    create_sentinel(L);
+    return 0;
+}
+
+static void create_sentinel(lua::State* L) {
+    lua_newuserdata(L, 0);
+    luaL_getmetatable(L, SENTINEL_METATABLE);
+    lua::setmetatable(L);
+    lua::pop(L);
+}
+
+/// @return heap size starting frame steps: halfway to the automatic
+/// collector threshold, so the cycle is finished by steps in most cases
+static size_t get_start_threshold() {
+    return cycleEndHeap + cycleEndHeap * (currentPause - 100) / 200;
+}
+
+void gc::initialize() {
+    auto L = lua::get_main_thread();
+    luaL_newmetatable(L, SENTINEL_METATABLE);
+    lua::pushcfunction(L, l_sentinel_gc);
+    lua::setfield(L, "__gc");
+    lua::pop(L);
+    create_sentinel(L);
+
+    collecting = false;
+    cycleEndHeap = lua::heapsize(L);
+    reset_stats();
+}
+
+void gc::step(double budget, int stepSize, int pause) {
+    auto L = lua::get_main_thread();
+    if (pause != currentPause) {
+        currentPause = pause;
+        lua::gcsetpause(L, pause);
+    }
+    size_t heap = lua::heapsize(L);
+    stats.peakHeapSize = std::max(stats.peakHeapSize, heap);
+    if (budget <= 0.0) {
+        stats.lastPause = 0.0;
+        return;
+    }
+    if (!collecting) {
+        if (heap < get_start_threshold()) {
+            stats.lastPause = 0.0;
+            return;
+        }
+        collecting = true;
+    }
+    auto start = steady_clock::now();
+    auto deadline = start + std::chrono::duration_cast<steady_clock::duration>(
+                                std::chrono::duration<double>(budget)
+                            );
+    do {
+        if (lua::gcstep(L, stepSize)) {
+            collecting = false;
+            break;
+        }
+    } while (collecting && steady_clock::now() < deadline);
+
+    double time =
+        std::chrono::duration<double>(steady_clock::now() - start).count();
+    stats.lastPause = time;
+    stats.maxPause = std::max(stats.maxPause, time);
+    stats.totalTime += time;
+}
+
+gc::Stats gc::get_stats() {
+    auto copy = stats;
+    copy.heapSize = lua::heapsize(lua::get_main_thread());
+    return copy;
+}
+
+void gc::reset_stats() {
+    stats = {};
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/// @brief Lua garbage collector control and telemetry.
+/// Incremental collection steps are made every frame within a time budget,
+/// so the automatic collector rarely has to catch up on allocation-heavy
+/// frames
+namespace scripting::gc {
+    struct Stats {
+        /// @brief current Lua heap size (bytes)
+        size_t heapSize = 0;
+        /// @brief largest heap size observed on frame steps (bytes)
+        size_t peakHeapSize = 0;
+        /// @brief number of completed collection cycles (including
+        /// automatic and full collections)
+        uint64_t cycles = 0;
+        /// @brief time spent on the last frame steps (seconds)
+        double lastPause = 0.0;
+        /// @brief longest time spent on a frame steps (seconds)
+        double maxPause = 0.0;
+        /// @brief total time spent on frame steps (seconds)
+        double totalTime = 0.0;
+    };
+
+    /// @brief Start cycles counting for the main Lua state
+    void initialize();
+
+    /// @brief Run incremental collection steps if a cycle is in progress
+    /// or heap has grown enough to start a new one
+    /// @param budget time limit (seconds), 0 - automatic collection only
+    /// @param stepSize step size (kilobytes)
+    /// @param pause heap growth (percents) starting automatic cycle
+    void step(double budget, int stepSize, int pause);
+
+    Stats get_stats();
+
+    void reset_stats();
+}
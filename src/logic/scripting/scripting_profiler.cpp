@@ -0,0 +1,193 @@
+#include "scripting_profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <unordered_map>
+
+#include "lua/lua_engine.hpp"
+#include "util/stringutil.hpp"
+
+using namespace scripting;
+using namespace scripting::profiler;
+
+using std::chrono::steady_clock;
+
+namespace {
+    struct TraceEvent {
+        size_t entry;
+        int64_t start;
+        int64_t duration;
+    };
+}
+
+/// @brief Timeline events limit (~24 MB) to keep memory bounded when
+/// profiler is left enabled
+inline constexpr size_t MAX_TRACE_EVENTS = 1'000'000;
+
+static bool enabled = false;
+static bool tracing = false;
+static uint generation = 1;
+static steady_clock::time_point origin = steady_clock::now();
+static int64_t frameStart = 0;
+
+static std::vector<Entry> entries;
+static std::unordered_map<std::string, size_t> names;
+static std::unordered_map<const void*, size_t> keys;
+static std::vector<TraceEvent> events;
+static std::vector<TraceEvent> frames;
+
+static int64_t timestamp() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               steady_clock::now() - origin
+    )
+        .count();
+}
+
+std::string Entry::getPackId() const {
+    size_t sep = name.find_first_of(":.");
+    return name.substr(0, sep);
+}
+
+bool profiler::is_enabled() {
+    return enabled;
+}
+
+void profiler::start(bool trace) {
+    enabled = true;
+    tracing = trace;
+    frameStart = timestamp();
+}
+
+void profiler::stop() {
+    enabled = false;
+}
+
+void profiler::reset() {
+    entries.clear();
+    names.clear();
+    keys.clear();
+    events.clear();
+    frames.clear();
+    generation++;
+    frameStart = timestamp();
+}
+
+void profiler::frame() {
+    if (!enabled) {
+        return;
+    }
+    int64_t time = timestamp();
+    if (tracing && events.size() + frames.size() < MAX_TRACE_EVENTS) {
+        frames.push_back(TraceEvent {0, frameStart, time - frameStart});
+    }
+    frameStart = time;
+}
+
+std::vector<Entry> profiler::get_entries() {
+    auto sorted = entries;
+    std::sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+        return a.time > b.time;
+    });
+    return sorted;
+}
+
+size_t profiler::get_trace_size() {
+    return events.size() + frames.size();
+}
+
+static void write_event(
+    std::stringstream& ss,
+    const std::string& name,
+    const std::string& category,
+    int tid,
+    const TraceEvent& event
+) {
+    ss << "{\"name\":" << name << ",\"cat\":" << category
+       << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << tid
+       << ",\"ts\":" << event.start / 1000.0
+       << ",\"dur\":" << event.duration / 1000.0 << "}";
+}
+
+std::string profiler::write_trace() {
+    std::vector<std::string> escapedNames;
+    std::vector<std::string> categories;
+    for (const auto& entry : entries) {
+        escapedNames.push_back(util::escape(entry.name));
+        categories.push_back(util::escape(entry.getPackId()));
+    }
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    ss << "{\"traceEvents\":[\n";
+    ss << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,"
+          "\"args\":{\"name\":\"frames\"}},\n";
+    ss << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":1,"
+          "\"args\":{\"name\":\"scripts\"}}";
+    for (const auto& frame : frames) {
+        ss << ",\n";
+        write_event(ss, "\"frame\"", "\"engine\"", 0, frame);
+    }
+    for (const auto& event : events) {
+        ss << ",\n";
+        write_event(
+            ss, escapedNames[event.entry], categories[event.entry], 1, event
+        );
+    }
+    ss << "\n]}\n";
+    return ss.str();
+}
+
+void profiler::clear_keys() {
+    keys.clear();
+}
+
+int64_t profiler::find_entry(const void* key) {
+    const auto& found = keys.find(key);
+    if (found == keys.end()) {
+        return -1;
+    }
+    return found->second;
+}
+
+size_t profiler::add_entry(const void* key, Entry entry) {
+    size_t index;
+    const auto& found = names.find(entry.name);
+    if (found == names.end()) {
+        index = entries.size();
+        names[entry.name] = index;
+        entries.push_back(std::move(entry));
+    } else {
+        index = found->second;
+    }
+    if (key) {
+        keys[key] = index;
+    }
+    return index;
+}
+
+void Scope::begin(size_t entry) {
+    this->entry = entry;
+    this->generation = ::generation;
+    heap = lua::heapsize(lua::get_main_thread());
+    start = timestamp();
+}
+
+void Scope::end() {
+    int64_t time = timestamp() - start;
+    if (generation != ::generation) {
+        return;
+    }
+    size_t heapAfter = lua::heapsize(lua::get_main_thread());
+
+    auto& entry = entries[this->entry];
+    entry.calls++;
+    entry.time += time;
+    entry.maxTime = std::max(entry.maxTime, time);
+    if (heapAfter > heap) {
+        entry.allocated += heapAfter - heap;
+    }
+    if (tracing && events.size() + frames.size() < MAX_TRACE_EVENTS) {
+        events.push_back(TraceEvent {this->entry, start, time});
+    }
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "typedefs.hpp"
+
+/// @brief Opt-in profiler of script calls made by the engine.
+/// Measures time, calls count and Lua heap growth per callback.
+/// Measurements are taken on the main thread only.
+namespace scripting::profiler {
+    struct Entry {
+        /// @brief callback or event name (e.g. 'base:torch.update')
+        std::string name;
+        /// @brief script file the callback is defined in (if known)
+        std::string source;
+        size_t calls = 0;
+        /// @brief cumulative time (nanoseconds)
+        int64_t time = 0;
+        /// @brief longest call time (nanoseconds)
+        int64_t maxTime = 0;
+        /// @brief Lua heap growth during calls (bytes). Approximate as
+        /// garbage collector steps made during call are subtracted
+        int64_t allocated = 0;
+
+        /// @return pack id extracted from the entry name
+        std::string getPackId() const;
+    };
+
+    bool is_enabled();
+
+    /// @brief Start or continue profiling
+    /// @param trace keep timeline events for Chrome trace export
+    void start(bool trace);
+
+    void stop();
+
+    /// @brief Clear all measurements
+    void reset();
+
+    /// @brief Mark frame end on the timeline
+    void frame();
+
+    /// @brief Get entries sorted by cumulative time descending
+    std::vector<Entry> get_entries();
+
+    /// @brief Get number of timeline events recorded
+    size_t get_trace_size();
+
+    /// @brief Generate Chrome trace JSON (chrome://tracing, Perfetto,
+    /// speedscope)
+    std::string write_trace();
+
+    /// @brief Forget callback keys passed to Scope (they become
+    /// invalid when scripts are unloaded)
+    void clear_keys();
+
+    /// @brief Find entry index by callback key
+    /// @return entry index or -1 if not found
+    int64_t find_entry(const void* key);
+
+    /// @brief Get existing entry with same name or add new one
+    /// @param key callback key (nullptr if not available)
+    /// @return entry index
+    size_t add_entry(const void* key, Entry entry);
+
+    /// @brief Measures a script call from construction to destruction
+    /// if profiler is enabled. Nested calls time is included
+    class Scope {
+        bool active;
+        size_t entry = 0;
+        int64_t start = 0;
+        size_t heap = 0;
+        /// @brief measurements generation (call is dropped if
+        /// profiler was reset during the call)
+        uint generation = 0;
+
+        void begin(size_t entry);
+        void end();
+    public:
+        /// @param init function filling entry name and source, called
+        /// once per key
+        /// @param key stable callback identity to skip entry lookup by name
+        template <class InitFunc>
+        Scope(const void* key, const InitFunc& init) : active(is_enabled()) {
+            if (!active) {
+                return;
+            }
+            int64_t index = find_entry(key);
+            if (index == -1) {
+                Entry entry {};
+                init(entry);
+                index = add_entry(key, std::move(entry));
+            }
+            begin(index);
+        }
+
+        /// @param init function filling entry name and source, called on
+        /// every measured call
+        template <class InitFunc>
+        explicit Scope(const InitFunc& init) : active(is_enabled()) {
+            if (!active) {
+                return;
+            }
+            Entry entry {};
+            init(entry);
+            begin(add_entry(nullptr, std::move(entry)));
+        }
+
+        Scope(const Scope&) = delete;
+
+        ~Scope() {
+            if (active) {
+                end();
+            }
+        }
+    };
+}
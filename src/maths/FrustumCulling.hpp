@@ -1,13 +1,24 @@
 #pragma once
 
+#include <algorithm>
+
 #include <glm/matrix.hpp>
 
 class Frustum {
 public:
+    enum class Location { outside, intersects, inside };
+
     Frustum() = default;
 
     void update(glm::mat4 projview);
     bool isBoxVisible(const glm::vec3& minp, const glm::vec3& maxp) const;
+
+    /// @brief Fast box test checking only the nearest and the farthest box
+    /// vertices for each plane. Conservative: box may be reported as
+    /// intersecting while being outside near the frustum edges.
+    /// All planes are tested at once using planes components stored
+    /// per axis (branchless loop vectorized by the compiler)
+    Location locateBox(const glm::vec3& minp, const glm::vec3& maxp) const;
 private:
     enum Planes {
         Left = 0,
@@ -28,8 +39,17 @@ private:
     template <Planes a, Planes b, Planes c>
     glm::vec3 intersection(const glm::vec3* crosses) const;
 
+    /// @brief Planes count padded to the SIMD width
+    static constexpr int BATCH = 8;
+
     glm::vec4 m_planes[Count];
     glm::vec3 m_points[8];
+
+    /// @brief m_planes components by axis, padding planes accept any box
+    alignas(32) float m_planesX[BATCH] {};
+    alignas(32) float m_planesY[BATCH] {};
+    alignas(32) float m_planesZ[BATCH] {};
+    alignas(32) float m_planesW[BATCH] {};
 };
 
 inline void Frustum::update(glm::mat4 m) {
@@ -41,6 +61,14 @@ inline void Frustum::update(glm::mat4 m) {
     m_planes[Near] = m[3] + m[2];
     m_planes[Far] = m[3] - m[2];
 
+    for (int i = 0; i < BATCH; i++) {
+        glm::vec4 plane = i < Count ? m_planes[i] : glm::vec4(0, 0, 0, 1);
+        m_planesX[i] = plane.x;
+        m_planesY[i] = plane.y;
+        m_planesZ[i] = plane.z;
+        m_planesW[i] = plane.w;
+    }
+
     glm::vec3 crosses[Combinations] = {
         glm::cross(glm::vec3(m_planes[Left]), glm::vec3(m_planes[Right])),
         glm::cross(glm::vec3(m_planes[Left]), glm::vec3(m_planes[Bottom])),
@@ -116,6 +144,30 @@ inline bool Frustum::isBoxVisible(const glm::vec3& minp, const glm::vec3& maxp)
     return true;
 }
 
+inline Frustum::Location Frustum::locateBox(
+    const glm::vec3& minp, const glm::vec3& maxp
+) const {
+    // products with the box bounds are the same as when selecting
+    // the nearest and the farthest vertices by the plane normal signs
+    int outside = 0;
+    int intersects = 0;
+    for (int i = 0; i < BATCH; i++) {
+        float x0 = m_planesX[i] * minp.x, x1 = m_planesX[i] * maxp.x;
+        float y0 = m_planesY[i] * minp.y, y1 = m_planesY[i] * maxp.y;
+        float z0 = m_planesZ[i] * minp.z, z1 = m_planesZ[i] * maxp.z;
+        float farthest = std::max(x0, x1) + std::max(y0, y1) +
+                         std::max(z0, z1) + m_planesW[i];
+        float nearest = std::min(x0, x1) + std::min(y0, y1) +
+                        std::min(z0, z1) + m_planesW[i];
+        outside |= farthest < 0.0f;
+        intersects |= nearest < 0.0f;
+    }
+    if (outside) {
+        return Location::outside;
+    }
+    return intersects ? Location::intersects : Location::inside;
+}
+
 template <Frustum::Planes a, Frustum::Planes b, Frustum::Planes c>
 inline glm::vec3 Frustum::intersection(const glm::vec3* crosses) const {
     float D = glm::dot(glm::vec3(m_planes[a]), crosses[ij2k<b, c>::k]);
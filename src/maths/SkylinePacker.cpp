@@ -0,0 +1,113 @@
+#include "SkylinePacker.hpp"
+
+#include <algorithm>
+
+SkylinePacker::SkylinePacker(const uint32_t sizes[], size_t length) {
+    for (unsigned int i = 0; i < length / 2; i++) {
+        rects.emplace_back(i, 0, 0, (int)sizes[i * 2], (int)sizes[i * 2 + 1]);
+    }
+    // taller rectangles first keep the skyline flat
+    std::stable_sort(rects.begin(), rects.end(), [](auto& a, auto& b) {
+        if (a.height != b.height) {
+            return a.height > b.height;
+        }
+        return a.width > b.width;
+    });
+}
+
+uint32_t SkylinePacker::fit(
+    size_t index, uint32_t w, uint32_t h, uint32_t limit
+) const {
+    if (skyline[index].x + w > width) {
+        return UINT32_MAX;
+    }
+    uint32_t y = 0;
+    uint32_t covered = 0;
+    for (size_t i = index; covered < w; i++) {
+        y = std::max(y, skyline[i].y);
+        if (y + h > limit) {
+            return UINT32_MAX;
+        }
+        covered += skyline[i].width;
+    }
+    return y;
+}
+
+void SkylinePacker::place(
+    size_t index, uint32_t x, uint32_t y, uint32_t w, uint32_t h
+) {
+    skyline.insert(skyline.begin() + index, segment {x, y + h, w});
+    // cut segments covered by the placed rectangle
+    for (size_t i = index + 1; i < skyline.size();) {
+        auto& seg = skyline[i];
+        uint32_t end = x + w;
+        if (seg.x >= end) {
+            break;
+        }
+        uint32_t shrink = end - seg.x;
+        if (seg.width <= shrink) {
+            skyline.erase(skyline.begin() + i);
+            continue;
+        }
+        seg.x += shrink;
+        seg.width -= shrink;
+        break;
+    }
+    // merge neighbour segments of the same level
+    for (size_t i = 0; i + 1 < skyline.size();) {
+        if (skyline[i].y == skyline[i + 1].y) {
+            skyline[i].width += skyline[i + 1].width;
+            skyline.erase(skyline.begin() + i + 1);
+        } else {
+            i++;
+        }
+    }
+    height = std::max(height, y + h);
+}
+
+bool SkylinePacker::build(
+    uint32_t width, uint32_t maxHeight, uint16_t extension
+) {
+    this->width = width;
+    height = 0;
+    skyline.clear();
+    skyline.push_back(segment {0, 0, width});
+
+    for (auto& rect : rects) {
+        uint32_t w = rect.width + extension * 2;
+        uint32_t h = rect.height + extension * 2;
+        uint32_t bestY = UINT32_MAX;
+        size_t bestIndex = 0;
+        for (size_t i = 0; i < skyline.size(); i++) {
+            uint32_t y = fit(i, w, h, maxHeight);
+            if (y < bestY) {
+                bestY = y;
+                bestIndex = i;
+            }
+        }
+        if (bestY == UINT32_MAX) {
+            return false;
+        }
+        uint32_t x = skyline[bestIndex].x;
+        place(bestIndex, x, bestY, w, h);
+        rect.x = x + extension;
+        rect.y = bestY + extension;
+    }
+    return true;
+}
+
+uint32_t SkylinePacker::estimateWidth(uint16_t extension) const {
+    uint64_t area = 0;
+    uint32_t maxWidth = 0;
+    for (const auto& rect : rects) {
+        uint64_t w = rect.width + extension * 2;
+        uint64_t h = rect.height + extension * 2;
+        area += w * h;
+        maxWidth = std::max(maxWidth, static_cast<uint32_t>(w));
+    }
+    uint32_t width = 1;
+    while (static_cast<uint64_t>(width) * width < area || width < maxWidth) {
+        width *= 2;
+    }
+    return width;
+}
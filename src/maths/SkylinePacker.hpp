@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <vector>
+
+#include "LMPacker.hpp"
+
+/// @brief Skyline bottom-left rectangles packer.
+/// Unlike LMPacker only the width is fixed: rectangles are placed in a
+/// single pass and the used height is the result
+class SkylinePacker {
+    struct segment {
+        uint32_t x;
+        uint32_t y;
+        uint32_t width;
+    };
+
+    std::vector<rectangle> rects;
+    std::vector<segment> skyline;
+    uint32_t width = 0;
+    uint32_t height = 0;
+
+    /// @return lowest y where the rectangle fits starting at the segment
+    /// or UINT32_MAX
+    uint32_t fit(size_t index, uint32_t w, uint32_t h, uint32_t limit) const;
+    void place(size_t index, uint32_t x, uint32_t y, uint32_t w, uint32_t h);
+public:
+    SkylinePacker(const uint32_t sizes[], size_t length);
+
+    /// @brief Pack rectangles into area of the given width
+    /// @param width area width
+    /// @param maxHeight max area height
+    /// @param extension margin reserved around each rectangle
+    /// @return false if rectangles do not fit
+    bool build(uint32_t width, uint32_t maxHeight, uint16_t extension);
+
+    /// @brief Estimate minimal power-of-two width for the rectangles
+    /// @param extension margin reserved around each rectangle
+    uint32_t estimateWidth(uint16_t extension) const;
+
+    /// @return height used by the last build
+    uint32_t getHeight() const {
+        return height;
+    }
+
+    std::vector<rectangle> getResult() {
+        return rects;
+    }
+};
@@ -4,6 +4,7 @@
 #include <sstream>
 
 #include "assets/Assets.hpp"
+#include "constants.hpp"
 #include "content/Content.hpp"
 #include "data/dynamic_util.hpp"
 #include "debug/Logger.hpp"
@@ -28,6 +29,9 @@ static inline std::string COMP_RIGIDBODY = "rigidbody";
 static inline std::string COMP_SKELETON = "skeleton";
 static inline std::string SAVED_DATA_VARNAME = "SAVED_DATA";
 
+/// @brief Min number of moving bodies to step them in parallel
+inline constexpr size_t MIN_PARALLEL_BODIES = 64;
+
 void Transform::refresh() {
     combined = glm::mat4(1.0f);
     combined = glm::translate(combined, pos);
@@ -60,7 +64,11 @@ void Entity::setRig(const rigging::SkeletonConfig* rigConfig) {
 }
 
 Entities::Entities(Level* level)
-    : level(level), sensorsTickClock(20, 3), updateTickClock(20, 3) {
+    : level(level),
+      grid(CHUNK_W),
+      sensorsTickClock(20, 3),
+      updateTickClock(20, 3),
+      collidersCaches(physicsWorkers.getPartitionsCount()) {
 }
 
 template <void (*callback)(const Entity&, size_t, entityid_t)>
@@ -172,6 +180,7 @@ entityid_t Entities::spawn(
         loadEntity(saved, get(id).value());
     }
     body.hitbox.position = tsf.pos;
+    updateIndex(entity, tsf, body);
     scripting::on_entity_spawn(
         def, id, scripting.components, std::move(args), std::move(componentsMap)
     );
@@ -245,16 +254,18 @@ std::optional<Entities::RaycastResult> Entities::rayCast(
     glm::vec3 start, glm::vec3 dir, float maxDistance, entityid_t ignore
 ) {
     Ray ray(start, dir);
-    auto view = registry.view<EntityId, Transform, Rigidbody>();
 
     entityid_t foundUID = 0;
     glm::ivec3 foundNormal;
 
-    for (auto [entity, eid, transform, body] : view.each()) {
+    AABB area(start, start);
+    area.addPoint(start + dir * maxDistance);
+    grid.query(area, [&](entt::entity entity) {
+        const auto& eid = registry.get<EntityId>(entity);
         if (eid.uid == ignore) {
-            continue;
+            return false;
         }
-        auto& hitbox = body.hitbox;
+        auto& hitbox = registry.get<Rigidbody>(entity).hitbox;
         glm::ivec3 normal;
         double distance;
         if (ray.intersectAABB(
@@ -264,7 +275,8 @@ std::optional<Entities::RaycastResult> Entities::rayCast(
             foundNormal = normal;
             maxDistance = static_cast<float>(distance);
         }
-    }
+        return false;
+    });
     if (foundUID) {
         return Entities::RaycastResult {foundUID, foundNormal, maxDistance};
     } else {
@@ -288,6 +300,20 @@ void Entities::onSave(const Entity& entity) {
     scripting::on_entity_save(entity);
 }
 
+void Entities::updateIndex(
+    entt::entity entity, const Transform& tsf, const Rigidbody& body
+) {
+    AABB bounds = body.hitbox.getAABB();
+    bounds.addPoint(tsf.pos);
+    grid.update(entity, bounds);
+}
+
+void Entities::updateIndex(const Entity& entity) {
+    updateIndex(
+        entity.getHandler(), entity.getTransform(), entity.getRigidbody()
+    );
+}
+
 dynamic::Value Entities::serialize(const Entity& entity) {
     auto root = dynamic::create_map();
     auto& eid = entity.getID();
@@ -385,6 +411,7 @@ void Entities::clean() {
             for (auto& sensor : rigidbody.sensors) {
                 physics->removeSensor(&sensor);
             }
+            grid.remove(it->second);
             uids.erase(it->second);
             registry.destroy(it->second);
             it = entities.erase(it);
@@ -449,38 +476,107 @@ void Entities::updatePhysics(float delta) {
 
     auto view = registry.view<EntityId, Transform, Rigidbody>();
     auto physics = level->physics.get();
+    const Chunks* chunks = level->chunks.get();
+
+    physicsBodies.clear();
     for (auto [entity, eid, transform, rigidbody] : view.each()) {
         if (!rigidbody.enabled || rigidbody.hitbox.type == BodyType::STATIC) {
+            updateIndex(entity, transform, rigidbody);
             continue;
         }
         auto& hitbox = rigidbody.hitbox;
-        auto prevVel = hitbox.velocity;
-        bool grounded = hitbox.grounded;
-
-        float vel = glm::length(prevVel);
-        int substeps = static_cast<int>(delta * vel * 20);
-        substeps = std::min(100, std::max(2, substeps));
-        physics->step(level->chunks.get(), &hitbox, delta, substeps, eid.uid);
-        hitbox.linearDamping = hitbox.grounded * 24;
+        physicsBodies.push_back(PhysicsBody {
+            entity,
+            eid.uid,
+            &hitbox,
+            hitbox.grounded,
+            hitbox.grounded,
+            hitbox.velocity,
+            0.0f});
+    }
+
+    // bodies integration does not call scripts and only reads chunks,
+    // so it's done in parallel
+    auto stepBodies = [=](size_t begin, size_t end, uint partition) {
+        auto& colliders = collidersCaches[partition];
+        for (size_t i = begin; i < end; i++) {
+            auto& hitbox = *physicsBodies[i].hitbox;
+            float vel = glm::length(hitbox.velocity);
+            int substeps = static_cast<int>(delta * vel * 20);
+            substeps = std::min(100, std::max(2, substeps));
+            physics->step(chunks, &hitbox, delta, substeps, colliders);
+            hitbox.linearDamping = hitbox.grounded * 24;
+        }
+    };
+    if (physicsBodies.size() < MIN_PARALLEL_BODIES) {
+        stepBodies(0, physicsBodies.size(), 0);
+    } else {
+        physicsWorkers.run(physicsBodies.size(), stepBodies);
+    }
+
+    sensorEvents.clear();
+    for (auto& body : physicsBodies) {
+        auto& transform = registry.get<Transform>(body.entity);
+        auto& rigidbody = registry.get<Rigidbody>(body.entity);
+        const auto& hitbox = rigidbody.hitbox;
+        body.grounded = hitbox.grounded;
+        body.impact = glm::length(body.prevVelocity - hitbox.velocity);
         transform.setPos(hitbox.position);
-        if (hitbox.grounded && !grounded) {
-            scripting::on_entity_grounded(
-                *get(eid.uid), glm::length(prevVel - hitbox.velocity)
-            );
+        updateIndex(body.entity, transform, rigidbody);
+        physics->checkSensors(hitbox, body.uid, sensorEvents);
+    }
+
+    // events are dispatched after all bodies are stepped in a fixed order.
+    // scripts may spawn entities, so hitbox pointers are not used here
+    for (const auto& event : sensorEvents) {
+        const auto& sensor = *event.sensor;
+        sensor.enterCallback(sensor.entity, sensor.index, event.entity);
+    }
+    for (const auto& body : physicsBodies) {
+        if (body.grounded == body.prevGrounded) {
+            continue;
         }
-        if (!hitbox.grounded && grounded) {
-            scripting::on_entity_fall(*get(eid.uid));
+        auto entity = get(body.uid);
+        if (!entity) {
+            continue;
+        }
+        if (body.grounded) {
+            scripting::on_entity_grounded(*entity, body.impact);
+        } else {
+            scripting::on_entity_fall(*entity);
+        }
+    }
+}
+
+void Entities::collectScripted(
+    scriptfunc entity_callbacks::*callback, int parts, int part
+) {
+    scriptedEntities.clear();
+    auto view = registry.view<EntityId, ScriptComponents>();
+    for (auto [entity, eid, script] : view.each()) {
+        if (eid.destroyFlag || eid.uid % parts != part) {
+            continue;
+        }
+        for (const auto& component : script.components) {
+            if (component->callbacks.*callback) {
+                scriptedEntities.emplace_back(*this, eid.uid, registry, entity);
+                break;
+            }
         }
     }
 }
 
 void Entities::update(float delta) {
     if (updateTickClock.update(delta)) {
-        scripting::on_entities_update(
-            updateTickClock.getTickRate(),
+        // scripts may spawn entities, so the view is not iterated here
+        collectScripted(
+            &entity_callbacks::on_update,
             updateTickClock.getParts(),
             updateTickClock.getPart()
         );
+        scripting::on_entities_update(
+            scriptedEntities, updateTickClock.getTickRate()
+        );
     }
 }
 
@@ -558,7 +654,8 @@ void Entities::render(
     bool pause
 ) {
     if (!pause) {
-        scripting::on_entities_render(delta);
+        collectScripted(&entity_callbacks::on_render, 1, 0);
+        scripting::on_entities_render(scriptedEntities, delta);
     }
 
     auto view = registry.view<Transform, rigging::Skeleton>();
@@ -576,45 +673,46 @@ void Entities::render(
 }
 
 bool Entities::hasBlockingInside(AABB aabb) {
-    auto view = registry.view<EntityId, Rigidbody>();
-    for (auto [entity, eid, body] : view.each()) {
-        if (eid.def.blocking && aabb.intersect(body.hitbox.getAABB(), -0.05f)) {
-            return true;
-        }
-    }
-    return false;
+    return grid.query(aabb, [&](entt::entity entity) {
+        const auto& eid = registry.get<EntityId>(entity);
+        const auto& body = registry.get<Rigidbody>(entity);
+        return eid.def.blocking && aabb.intersect(body.hitbox.getAABB(), -0.05f);
+    });
 }
 
 std::vector<Entity> Entities::getAllInside(AABB aabb) {
     std::vector<Entity> collected;
-    auto view = registry.view<Transform>();
-    for (auto [entity, transform] : view.each()) {
+    grid.query(aabb, [&](entt::entity entity) {
+        const auto& transform = registry.get<Transform>(entity);
         if (aabb.contains(transform.pos)) {
             const auto& found = uids.find(entity);
             if (found == uids.end()) {
-                continue;
+                return false;
             }
             if (auto wrapper = get(found->second)) {
                 collected.push_back(*wrapper);
             }
         }
-    }
+        return false;
+    });
     return collected;
 }
 
 std::vector<Entity> Entities::getAllInRadius(glm::vec3 center, float radius) {
     std::vector<Entity> collected;
-    auto view = registry.view<Transform>();
-    for (auto [entity, transform] : view.each()) {
+    AABB area(center - glm::vec3(radius), center + glm::vec3(radius));
+    grid.query(area, [&](entt::entity entity) {
+        const auto& transform = registry.get<Transform>(entity);
         if (glm::distance2(transform.pos, center) <= radius * radius) {
             const auto& found = uids.find(entity);
             if (found == uids.end()) {
-                continue;
+                return false;
             }
             if (auto wrapper = get(found->second)) {
                 collected.push_back(*wrapper);
             }
         }
-    }
+        return false;
+    });
     return collected;
 }
@@ -7,8 +7,11 @@
 
 #include "data/dynamic.hpp"
 #include "physics/Hitbox.hpp"
+#include "physics/PhysicsSolver.hpp"
+#include "physics/SpatialGrid.hpp"
 #include "typedefs.hpp"
 #include "util/Clock.hpp"
+#include "util/ParallelWorkers.hpp"
 #define GLM_ENABLE_EXPERIMENTAL
 #include <entt/entity/registry.hpp>
 #include <glm/gtx/norm.hpp>
@@ -28,6 +31,22 @@ struct entity_funcs_set {
     bool on_used;
 };
 
+/// @brief Pre-resolved component callbacks (nullptr if not defined)
+struct entity_callbacks {
+    scriptfunc on_despawn;
+    scriptfunc on_grounded;
+    scriptfunc on_fall;
+    scriptfunc on_sensor_enter;
+    scriptfunc on_sensor_exit;
+    scriptfunc on_save;
+    scriptfunc on_aim_on;
+    scriptfunc on_aim_off;
+    scriptfunc on_attacked;
+    scriptfunc on_used;
+    scriptfunc on_update;
+    scriptfunc on_render;
+};
+
 struct EntityDef;
 
 struct EntityId {
@@ -78,6 +97,7 @@ struct Rigidbody {
 struct UserComponent {
     std::string name;
     entity_funcs_set funcsset;
+    entity_callbacks callbacks;
     scriptenv env;
 
     UserComponent(
@@ -165,18 +185,48 @@ public:
 };
 
 class Entities {
+    /// @brief Body stepped by physics update
+    struct PhysicsBody {
+        entt::entity entity;
+        entityid_t uid;
+        Hitbox* hitbox;
+        bool prevGrounded;
+        bool grounded;
+        glm::vec3 prevVelocity;
+        /// @brief Velocity change used as grounding force
+        float impact;
+    };
+
     entt::registry registry;
     Level* level;
     std::unordered_map<entityid_t, entt::entity> entities;
     std::unordered_map<entt::entity, entityid_t> uids;
+    /// @brief Broadphase for entities queries
+    SpatialGrid<entt::entity> grid;
     entityid_t nextID = 1;
     util::Clock sensorsTickClock;
     util::Clock updateTickClock;
 
+    util::ParallelWorkers physicsWorkers;
+    /// @brief Colliders cache per physics workers partition
+    std::vector<CollidersCache> collidersCaches;
+    std::vector<PhysicsBody> physicsBodies;
+    std::vector<SensorEvent> sensorEvents;
+    /// @brief Entities which scripts are called in current update/render
+    std::vector<Entity> scriptedEntities;
+
     void updateSensors(
         Rigidbody& body, const Transform& tsf, std::vector<Sensor*>& sensors
     );
     void preparePhysics(float delta);
+    /// @brief Fill scriptedEntities with the update partition entities
+    /// having the component callback defined
+    void collectScripted(
+        scriptfunc entity_callbacks::*callback, int parts, int part
+    );
+    void updateIndex(
+        entt::entity entity, const Transform& tsf, const Rigidbody& body
+    );
 public:
     struct RaycastResult {
         entityid_t entity;
@@ -235,6 +285,11 @@ public:
     void loadEntity(const dynamic::Map_sptr& map);
     void loadEntity(const dynamic::Map_sptr& map, Entity entity);
     void onSave(const Entity& entity);
+
+    /// @brief Update entity bounds in the spatial index.
+    /// Call after entity is moved or resized outside of physics update
+    void updateIndex(const Entity& entity);
+
     bool hasBlockingInside(AABB aabb);
     std::vector<Entity> getAllInside(AABB aabb);
     std::vector<Entity> getAllInRadius(glm::vec3 center, float radius);
@@ -179,8 +179,9 @@ void Player::postUpdate() {
 
 void Player::teleport(glm::vec3 position) {
     this->position = position;
-    if (auto hitbox = getHitbox()) {
-        hitbox->position = position;
+    if (auto entity = level->entities->get(eid)) {
+        entity->getRigidbody().hitbox.position = position;
+        level->entities->updateIndex(*entity);
     }
 }
 
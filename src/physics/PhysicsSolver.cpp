@@ -14,16 +14,184 @@
 const float E = 0.03f;
 const float MAX_FIX = 0.1f;
 
-PhysicsSolver::PhysicsSolver(glm::vec3 gravity) : gravity(gravity) {
+/// @brief Sensors grid cell size
+const float SENSORS_CELL_SIZE = 8.0f;
+/// @brief Max expected hitbox movement colliders are gathered for
+const float MAX_COLLIDERS_REACH = 8.0f;
+/// @brief Gathered colliders area margin covering probes and position fixes
+const float COLLIDERS_MARGIN = 1.0f;
+/// @brief Max probes and position fixes distance from the hitbox
+const float PROBES_MARGIN = E + MAX_FIX + 0.5f;
+
+PhysicsSolver::PhysicsSolver(glm::vec3 gravity) 
+    : gravity(gravity), sensors(SENSORS_CELL_SIZE) {
+}
+
+/// @brief Calculate end of a probe face range. Faces were sampled with step
+/// s while sample index <= (half-E)*2/s, so the range is kept the same
+/// @return false if the range is empty
+static inline bool probe_end(float start, float half, float s, float& end) {
+    float count = (half - E) * 2 / s;
+    if (count < 0.0f) {
+        return false;
+    }
+    end = start + std::floor(count) * s;
+    return true;
+}
+
+/// @brief std::floor without library call (value is in int range)
+static inline int floor_int(float value) {
+    int i = static_cast<int>(value);
+    return i - (value < i);
+}
+
+static inline int ceil_int(float value) {
+    int i = static_cast<int>(value);
+    return i + (value > i);
+}
+
+bool CollidersCache::cellsRange(
+    const glm::vec3& min,
+    const glm::vec3& max,
+    bool exclusive,
+    glm::ivec3& from,
+    glm::ivec3& to
+) const {
+    glm::ivec3 origin(this->min);
+    glm::ivec3 end = exclusive
+        ? glm::ivec3(ceil_int(max.x), ceil_int(max.y), ceil_int(max.z)) - 1
+        : glm::ivec3(floor_int(max.x), floor_int(max.y), floor_int(max.z));
+    from = glm::max(
+        glm::ivec3(floor_int(min.x), floor_int(min.y), floor_int(min.z)) -
+            origin,
+        glm::ivec3(0)
+    );
+    to = glm::min(end - origin, size - 1);
+    return from.x <= to.x && from.y <= to.y && from.z <= to.z;
+}
+
+void CollidersCache::index() {
+    size = glm::max(glm::ivec3(max) - glm::ivec3(min), glm::ivec3(0));
+    size_t volume = static_cast<size_t>(size.x) * size.y * size.z;
+    cellStarts.assign(volume + 1, 0);
+    boxesCells.resize(boxes.size() * 2);
+
+    // boxes are counted per voxel, then written at the voxels offsets
+    for (size_t i = 0; i < boxes.size(); i++) {
+        auto& from = boxesCells[i * 2];
+        auto& to = boxesCells[i * 2 + 1];
+        if (!cellsRange(boxes[i].a, boxes[i].b, true, from, to)) {
+            to = from - 1;
+            continue;
+        }
+        for (int y = from.y; y <= to.y; y++) {
+            for (int z = from.z; z <= to.z; z++) {
+                for (int x = from.x; x <= to.x; x++) {
+                    cellStarts[(y * size.z + z) * size.x + x + 1]++;
+                }
+            }
+        }
+    }
+    for (size_t cell = 0; cell < volume; cell++) {
+        cellStarts[cell + 1] += cellStarts[cell];
+    }
+    cellBoxes.resize(cellStarts[volume]);
+    for (size_t i = 0; i < boxes.size(); i++) {
+        const auto& from = boxesCells[i * 2];
+        const auto& to = boxesCells[i * 2 + 1];
+        for (int y = from.y; y <= to.y; y++) {
+            for (int z = from.z; z <= to.z; z++) {
+                for (int x = from.x; x <= to.x; x++) {
+                    size_t cell = (y * size.z + z) * size.x + x;
+                    cellBoxes[cellStarts[cell]++] = i;
+                }
+            }
+        }
+    }
+    // starts were moved to the voxels ends while writing
+    for (size_t cell = volume; cell > 0; cell--) {
+        cellStarts[cell] = cellStarts[cell - 1];
+    }
+    cellStarts[0] = 0;
+}
+
+const AABB* CollidersCache::find(
+    const glm::vec3& min, const glm::vec3& max, int axis, bool negative
+) const {
+    glm::ivec3 from, to;
+    if (!cellsRange(min, max, false, from, to)) {
+        return nullptr;
+    }
+    const AABB* found = nullptr;
+    for (int y = from.y; y <= to.y; y++) {
+        for (int z = from.z; z <= to.z; z++) {
+            for (int x = from.x; x <= to.x; x++) {
+                size_t cell = (y * size.z + z) * size.x + x;
+                for (uint i = cellStarts[cell]; i < cellStarts[cell + 1]; i++) {
+                    const auto& box = boxes[cellBoxes[i]];
+                    if (box.a.x > max.x || box.b.x <= min.x ||
+                        box.a.y > max.y || box.b.y <= min.y ||
+                        box.a.z > max.z || box.b.z <= min.z) {
+                        continue;
+                    }
+                    if (found == nullptr || 
+                        (negative ? box.b[axis] > found->b[axis] 
+                                  : box.a[axis] < found->a[axis])) {
+                        found = &box;
+                    }
+                }
+            }
+        }
+    }
+    return found;
+}
+
+/// @brief Check for colliders at y level under the hitbox horizontal face
+static bool has_floor(
+    const CollidersCache& colliders,
+    float x,
+    float y,
+    float z,
+    const glm::vec3& half,
+    float s
+) {
+    glm::vec3 min(x - half.x + E, y, z - half.z + E);
+    glm::vec3 max(0.0f, y, 0.0f);
+    if (!probe_end(min.x, half.x, s, max.x) || 
+        !probe_end(min.z, half.z, s, max.z)) {
+        return false;
+    }
+    return colliders.find(min, max, 1, true) != nullptr;
+}
+
+void PhysicsSolver::gatherColliders(
+    const Chunks* chunks,
+    const Hitbox& hitbox,
+    float delta,
+    CollidersCache& colliders
+) const {
+    const auto& half = hitbox.halfsize;
+    glm::vec3 reach = glm::abs(hitbox.velocity) * delta +
+                      glm::abs(gravity * hitbox.gravityScale) * delta * delta;
+    reach = glm::min(reach, glm::vec3(MAX_COLLIDERS_REACH)) + COLLIDERS_MARGIN;
+
+    colliders.min = glm::floor(hitbox.position - half - reach);
+    colliders.max = glm::floor(hitbox.position + half + reach) + 1.0f;
+    colliders.boxes.clear();
+    chunks->getObstacles(
+        glm::ivec3(colliders.min), glm::ivec3(colliders.max) - 1, 
+        colliders.boxes
+    );
+    colliders.index();
 }
 
 void PhysicsSolver::step(
-    Chunks* chunks, 
+    const Chunks* chunks, 
     Hitbox* hitbox, 
     float delta, 
     uint substeps, 
-    entityid_t entity
-) {
+    CollidersCache& colliders
+) const {
     float dt = delta / static_cast<float>(substeps);
     float linearDamping = hitbox->linearDamping;
     float s = 2.0f/BLOCK_AABB_GRID;
@@ -35,14 +203,21 @@ void PhysicsSolver::step(
     
     bool prevGrounded = hitbox->grounded;
     hitbox->grounded = false;
+    gatherColliders(chunks, *hitbox, delta, colliders);
     for (uint i = 0; i < substeps; i++) {
         float px = pos.x;
         float py = pos.y;
         float pz = pos.z;
+
+        glm::vec3 probes = half + PROBES_MARGIN + glm::abs(vel) * dt;
+        if (glm::any(glm::lessThan(pos - probes, colliders.min)) ||
+            glm::any(glm::greaterThan(pos + probes, colliders.max))) {
+            gatherColliders(chunks, *hitbox, delta, colliders);
+        }
         
         vel += gravity * dt * gravityScale;
         if (hitbox->type == BodyType::DYNAMIC) {
-            colisionCalc(chunks, hitbox, vel, pos, half, 
+            colisionCalc(colliders, hitbox, vel, pos, half, 
                          (prevGrounded && gravityScale > 0.0f) ? 0.5f : 0.0f);
         }
         vel.x *= glm::max(0.0f, 1.0f - dt * linearDamping);
@@ -58,44 +233,27 @@ void PhysicsSolver::step(
 
         if (hitbox->crouching && hitbox->grounded){
             float y = (pos.y-half.y-E);
-            hitbox->grounded = false;
-            for (int ix = 0; ix <= (half.x-E)*2/s; ix++) {
-                float x = (px-half.x+E) + ix * s;
-                for (int iz = 0; iz <= (half.z-E)*2/s; iz++){
-                    float z = (pos.z-half.z+E) + iz * s;
-                    if (chunks->isObstacleAt(x,y,z)){
-                        hitbox->grounded = true;
-                        break;
-                    }
-                }
-            }
-            if (!hitbox->grounded) {
+            if (!has_floor(colliders, px, y, pos.z, half, s)) {
                 pos.z = pz;
             }
-            hitbox->grounded = false;
-            for (int ix = 0; ix <= (half.x-E)*2/s; ix++) {
-                float x = (pos.x-half.x+E) + ix * s;
-                for (int iz = 0; iz <= (half.z-E)*2/s; iz++){
-                    float z = (pz-half.z+E) + iz * s;
-                    if (chunks->isObstacleAt(x,y,z)){
-                        hitbox->grounded = true;
-                        break;
-                    }
-                }
-            }
-            if (!hitbox->grounded) {
+            if (!has_floor(colliders, pos.x, y, pz, half, s)) {
                 pos.x = px;
             }
             hitbox->grounded = true;
         }
     }
+}
+
+void PhysicsSolver::checkSensors(
+    const Hitbox& hitbox, entityid_t entity, std::vector<SensorEvent>& events
+) {
     AABB aabb;
-    aabb.a = hitbox->position - hitbox->halfsize;
-    aabb.b = hitbox->position + hitbox->halfsize;
-    for (size_t i = 0; i < sensors.size(); i++) {
-        auto& sensor = *sensors[i];
+    aabb.a = hitbox.position - hitbox.halfsize;
+    aabb.b = hitbox.position + hitbox.halfsize;
+    sensors.query(aabb, [&](Sensor* sensorptr) {
+        auto& sensor = *sensorptr;
         if (sensor.entity == entity) {
-            continue;
+            return false;
         }
 
         bool triggered = false;
@@ -105,43 +263,66 @@ void PhysicsSolver::step(
                 break;
             case SensorType::RADIUS:
                 triggered = glm::distance2(
-                    hitbox->position, glm::vec3(sensor.calculated.radial))
+                    hitbox.position, glm::vec3(sensor.calculated.radial))
                      < sensor.calculated.radial.w;
                 break;
         }
         if (triggered) {
             if (sensor.prevEntered.find(entity) == sensor.prevEntered.end()) {
-                sensor.enterCallback(sensor.entity, sensor.index, entity);
+                events.push_back(SensorEvent {&sensor, entity});
             }
             sensor.nextEntered.insert(entity);
         }
-    }
+        return false;
+    });
 }
 
 static float calc_step_height(
-    Chunks* chunks, 
+    const CollidersCache& colliders,
     glm::vec3& pos, 
     const glm::vec3& half,
     float stepHeight,
     float s
 ) {
     if (stepHeight > 0.0f) {
-        for (int ix = 0; ix <= (half.x-E)*2/s; ix++) {
-            float x = (pos.x-half.x+E) + ix * s;
-            for (int iz = 0; iz <= (half.z-E)*2/s; iz++) {
-                float z = (pos.z-half.z+E) + iz * s;
-                if (chunks->isObstacleAt(x, pos.y+half.y+stepHeight, z)) {
-                    return 0.0f;
-                }
-            }
+        float y = pos.y + half.y + stepHeight;
+        if (has_floor(colliders, pos.x, y, pos.z, half, s)) {
+            return 0.0f;
         }
     }
     return stepHeight;
 }
 
+/// @brief Find collider at the hitbox face
+/// @param faceCoord face coordinate on nx axis
+/// @param negative select collider by the greatest max on nx axis
+/// (by the least min if false)
+template <int nx, int ny, int nz>
+static const AABB* find_face_collider(
+    const CollidersCache& colliders,
+    const glm::vec3& pos,
+    const glm::vec3& half,
+    float stepHeight,
+    float s,
+    float faceCoord,
+    bool negative
+) {
+    glm::vec3 offset(0.0f, stepHeight, 0.0f);
+    glm::vec3 min;
+    glm::vec3 max;
+    min[nx] = max[nx] = faceCoord;
+    min[ny] = (pos+offset)[ny]-half[ny]+E;
+    min[nz] = pos[nz]-half[nz]+E;
+    if (!probe_end(min[ny], (half-offset)[ny], s, max[ny]) ||
+        !probe_end(min[nz], half[nz], s, max[nz])) {
+        return nullptr;
+    }
+    return colliders.find(min, max, nx, negative);
+}
+
 template <int nx, int ny, int nz>
 static bool calc_collision_neg(
-    Chunks* chunks,
+    const CollidersCache& colliders,
     glm::vec3& pos,
     glm::vec3& vel,
     const glm::vec3& half,
@@ -151,30 +332,22 @@ static bool calc_collision_neg(
     if (vel[nx] >= 0.0f) {
         return false;
     }
-    glm::vec3 offset(0.0f, stepHeight, 0.0f);
-    for (int iy = 0; iy <= ((half-offset)[ny]-E)*2/s; iy++) {
-        glm::vec3 coord;
-        coord[ny] = ((pos+offset)[ny]-half[ny]+E) + iy * s;
-        for (int iz = 0; iz <= (half[nz]-E)*2/s; iz++){
-            coord[nz] = (pos[nz]-half[nz]+E) + iz * s;
-            coord[nx] = (pos[nx]-half[nx]-E);
-
-            if (const auto aabb = chunks->isObstacleAt(coord.x, coord.y, coord.z)) {
-                vel[nx] = 0.0f;
-                float newx = std::floor(coord[nx]) + aabb->max()[nx] + half[nx] + E;
-                if (std::abs(newx-pos[nx]) <= MAX_FIX) {
-                    pos[nx] = newx;
-                }
-                return true;
-            }
+    float faceCoord = pos[nx]-half[nx]-E;
+    if (const auto aabb = find_face_collider<nx, ny, nz>(
+            colliders, pos, half, stepHeight, s, faceCoord, true)) {
+        vel[nx] = 0.0f;
+        float newx = aabb->b[nx] + half[nx] + E;
+        if (std::abs(newx-pos[nx]) <= MAX_FIX) {
+            pos[nx] = newx;
         }
+        return true;
     }
     return false;
 }
 
 template <int nx, int ny, int nz>
 static void calc_collision_pos(
-    Chunks* chunks,
+    const CollidersCache& colliders,
     glm::vec3& pos,
     glm::vec3& vel,
     const glm::vec3& half,
@@ -184,81 +357,59 @@ static void calc_collision_pos(
     if (vel[nx] <= 0.0f) {
         return;
     }
-    glm::vec3 offset(0.0f, stepHeight, 0.0f);
-    for (int iy = 0; iy <= ((half-offset)[ny]-E)*2/s; iy++) {
-        glm::vec3 coord;
-        coord[ny] = ((pos+offset)[ny]-half[ny]+E) + iy * s;
-        for (int iz = 0; iz <= (half[nz]-E)*2/s; iz++) {
-            coord[nz] = (pos[nz]-half[nz]+E) + iz * s;
-            coord[nx] = (pos[nx]+half[nx]+E);
-            if (const auto aabb = chunks->isObstacleAt(coord.x, coord.y, coord.z)) {
-                vel[nx] = 0.0f;
-                float newx = std::floor(coord[nx]) - half[nx] + aabb->min()[nx] - E;
-                if (std::abs(newx-pos[nx]) <= MAX_FIX) {
-                    pos[nx] = newx;
-                }
-                return;
-            }
+    float faceCoord = pos[nx]+half[nx]+E;
+    if (const auto aabb = find_face_collider<nx, ny, nz>(
+            colliders, pos, half, stepHeight, s, faceCoord, false)) {
+        vel[nx] = 0.0f;
+        float newx = aabb->a[nx] - half[nx] - E;
+        if (std::abs(newx-pos[nx]) <= MAX_FIX) {
+            pos[nx] = newx;
         }
     }
 }
 
 void PhysicsSolver::colisionCalc(
-    Chunks* chunks, 
+    const CollidersCache& colliders,
     Hitbox* hitbox, 
     glm::vec3& vel, 
     glm::vec3& pos, 
     const glm::vec3 half,
     float stepHeight
-) {
-    // step size (smaller - more accurate, but slower)
+) const {
+    // probes step size is kept from per-sample probing for compatibility
     float s = 2.0f/BLOCK_AABB_GRID;
 
-    stepHeight = calc_step_height(chunks, pos, half, stepHeight, s);
+    stepHeight = calc_step_height(colliders, pos, half, stepHeight, s);
 
-    const AABB* aabb;
-    
-    calc_collision_neg<0, 1, 2>(chunks, pos, vel, half, stepHeight, s);
-    calc_collision_pos<0, 1, 2>(chunks, pos, vel, half, stepHeight, s);
+    calc_collision_neg<0, 1, 2>(colliders, pos, vel, half, stepHeight, s);
+    calc_collision_pos<0, 1, 2>(colliders, pos, vel, half, stepHeight, s);
 
-    calc_collision_neg<2, 1, 0>(chunks, pos, vel, half, stepHeight, s);
-    calc_collision_pos<2, 1, 0>(chunks, pos, vel, half, stepHeight, s);
+    calc_collision_neg<2, 1, 0>(colliders, pos, vel, half, stepHeight, s);
+    calc_collision_pos<2, 1, 0>(colliders, pos, vel, half, stepHeight, s);
 
-    if (calc_collision_neg<1, 0, 2>(chunks, pos, vel, half, stepHeight, s)) {
+    if (calc_collision_neg<1, 0, 2>(colliders, pos, vel, half, stepHeight, s)) {
         hitbox->grounded = true;
     }
 
     if (stepHeight > 0.0 && vel.y <= 0.0f){
-        for (int ix = 0; ix <= (half.x-E)*2/s; ix++) {
-            float x = (pos.x-half.x+E) + ix * s;
-            for (int iz = 0; iz <= (half.z-E)*2/s; iz++) {
-                float z = (pos.z-half.z+E) + iz * s;
-                float y = (pos.y-half.y+E);
-                if ((aabb = chunks->isObstacleAt(x,y,z))){
-                    vel.y = 0.0f;
-                    float newy = std::floor(y) + aabb->max().y + half.y;
-                    if (std::abs(newy-pos.y) <= MAX_FIX+stepHeight) {
-                        pos.y = newy;    
-                    }
-                    break;
-                }
+        float y = (pos.y-half.y+E);
+        if (const auto aabb = find_face_collider<1, 0, 2>(
+                colliders, pos, half, 0.0f, s, y, true)) {
+            vel.y = 0.0f;
+            float newy = aabb->b.y + half.y;
+            if (std::abs(newy-pos.y) <= MAX_FIX+stepHeight) {
+                pos.y = newy;    
             }
         }
     }
     if (vel.y > 0.0f){
-        for (int ix = 0; ix <= (half.x-E)*2/s; ix++) {
-            float x = (pos.x-half.x+E) + ix * s;
-            for (int iz = 0; iz <= (half.z-E)*2/s; iz++) {
-                float z = (pos.z-half.z+E) + iz * s;
-                float y = (pos.y+half.y+E);
-                if ((aabb = chunks->isObstacleAt(x,y,z))){
-                    vel.y = 0.0f;
-                    float newy = std::floor(y) - half.y + aabb->min().y - E;
-                    if (std::abs(newy-pos.y) <= MAX_FIX) {
-                        pos.y = newy;
-                    }
-                    break;
-                }
+        float y = (pos.y+half.y+E);
+        if (const auto aabb = find_face_collider<1, 0, 2>(
+                colliders, pos, half, 0.0f, s, y, false)) {
+            vel.y = 0.0f;
+            float newy = aabb->a.y - half.y - E;
+            if (std::abs(newy-pos.y) <= MAX_FIX) {
+                pos.y = newy;
             }
         }
     }
@@ -290,6 +441,26 @@ bool PhysicsSolver::isBlockInside(int x, int y, int z, Block* def, blockstate st
     return false;
 }
 
+void PhysicsSolver::setSensors(const std::vector<Sensor*>& sensors) {
+    this->sensors.clear();
+    for (auto sensor : sensors) {
+        switch (sensor->type) {
+            case SensorType::AABB:
+                this->sensors.update(sensor, sensor->calculated.aabb);
+                break;
+            case SensorType::RADIUS: {
+                glm::vec3 center(sensor->calculated.radial);
+                // calculated radial.w is a squared radius
+                glm::vec3 radius(std::sqrt(sensor->calculated.radial.w));
+                this->sensors.update(
+                    sensor, AABB(center - radius, center + radius)
+                );
+                break;
+            }
+        }
+    }
+}
+
 void PhysicsSolver::removeSensor(Sensor* sensor) {
-    sensors.erase(std::remove(sensors.begin(), sensors.end(), sensor), sensors.end());
+    sensors.remove(sensor);
 }
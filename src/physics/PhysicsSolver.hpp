@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Hitbox.hpp"
+#include "SpatialGrid.hpp"
 
 #include "typedefs.hpp"
 #include "voxels/voxel.hpp"
@@ -12,32 +13,101 @@ class Block;
 class Chunks;
 struct Sensor;
 
+/// @brief World-space obstacles gathered around a stepped hitbox, indexed
+/// by voxels of the gathered area. Each thread stepping bodies uses its
+/// own cache
+struct CollidersCache {
+    std::vector<AABB> boxes;
+    /// @brief Gathered area (voxel aligned), queries are limited to it
+    glm::vec3 min {};
+    glm::vec3 max {};
+
+    /// @brief Index boxes by voxels of the area.
+    /// Must be called after boxes or area change
+    void index();
+
+    /// @brief Find box overlapping the probe box (inclusive).
+    /// Boxes max is exclusive as in AABB::contains
+    /// @param axis axis used to select one of overlapping boxes
+    /// @param negative select box with the greatest max on the axis
+    /// (with the least min if false)
+    /// @return nullptr if not found
+    const AABB* find(
+        const glm::vec3& min, const glm::vec3& max, int axis, bool negative
+    ) const;
+private:
+    glm::ivec3 size {};
+    /// @brief Boxes indices by voxels: boxes of voxel i are
+    /// cellBoxes[cellStarts[i]] .. cellBoxes[cellStarts[i + 1] - 1]
+    std::vector<uint> cellStarts;
+    std::vector<uint> cellBoxes;
+    /// @brief Voxels range (from, to) of each box
+    std::vector<glm::ivec3> boxesCells;
+
+    /// @brief Get range of area voxels overlapped by the box
+    /// (max exclusive if exclusive is true)
+    /// @return false if the box is outside of the area
+    bool cellsRange(
+        const glm::vec3& min,
+        const glm::vec3& max,
+        bool exclusive,
+        glm::ivec3& from,
+        glm::ivec3& to
+    ) const;
+};
+
+/// @brief Sensor enter event buffered to be dispatched after physics step
+struct SensorEvent {
+    Sensor* sensor;
+    entityid_t entity;
+};
+
 class PhysicsSolver {
     glm::vec3 gravity;
-    std::vector<Sensor*> sensors;
+    /// @brief Broadphase for active sensors
+    SpatialGrid<Sensor*> sensors;
+
+    /// @brief Gather colliders once per step for all hitbox movement
+    void gatherColliders(
+        const Chunks* chunks,
+        const Hitbox& hitbox,
+        float delta,
+        CollidersCache& colliders
+    ) const;
 public:
     PhysicsSolver(glm::vec3 gravity);
+
+    /// @brief Integrate hitbox movement resolving collisions.
+    /// Thread-safe while chunks are not modified
     void step(
-        Chunks* chunks,
+        const Chunks* chunks,
         Hitbox* hitbox,
         float delta,
         uint substeps,
-        entityid_t entity
-    );
+        CollidersCache& colliders
+    ) const;
+
+    /// @brief Resolve collisions per axis against gathered colliders
     void colisionCalc(
-        Chunks* chunks,
+        const CollidersCache& colliders,
         Hitbox* hitbox,
         glm::vec3& vel,
         glm::vec3& pos,
         const glm::vec3 half,
         float stepHeight
+    ) const;
+
+    /// @brief Test hitbox against active sensors.
+    /// Enter events are written to events instead of calling callbacks
+    void checkSensors(
+        const Hitbox& hitbox,
+        entityid_t entity,
+        std::vector<SensorEvent>& events
     );
     bool isBlockInside(int x, int y, int z, Hitbox* hitbox);
     bool isBlockInside(int x, int y, int z, Block* def, blockstate state, Hitbox* hitbox);
 
-    void setSensors(std::vector<Sensor*> sensors) {
-        this->sensors = std::move(sensors);
-    }
+    void setSensors(const std::vector<Sensor*>& sensors);
 
     void removeSensor(Sensor* sensor);
 };
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "maths/aabb.hpp"
+
+/// @brief Uniform grid of infinite-height XZ columns used as a broadphase
+/// for spatial queries. An object is stored in every cell overlapped by its
+/// bounding box.
+/// @tparam T hashable object handle type
+template <class T>
+class SpatialGrid {
+    struct Range {
+        int x1, z1, x2, z2;
+
+        bool operator==(const Range& o) const {
+            return x1 == o.x1 && z1 == o.z1 && x2 == o.x2 && z2 == o.z2;
+        }
+    };
+    struct Entry {
+        T object;
+        Range range;
+    };
+    /// @brief Cells coordinates limit to keep infinite boxes valid
+    static inline constexpr float COORD_LIMIT = 1e9f;
+
+    float cellSize;
+    std::unordered_map<int64_t, std::vector<Entry>> cells;
+    std::unordered_map<T, Range> ranges;
+
+    static int64_t cellKey(int x, int z) {
+        return (static_cast<int64_t>(x) << 32) | static_cast<uint32_t>(z);
+    }
+
+    int toCell(float coord) const {
+        float cell = std::floor(coord / cellSize);
+        return static_cast<int>(std::clamp(cell, -COORD_LIMIT, COORD_LIMIT));
+    }
+
+    Range calcRange(const AABB& box) const {
+        glm::vec3 min = box.min();
+        glm::vec3 max = box.max();
+        return Range {
+            toCell(min.x), toCell(min.z), toCell(max.x), toCell(max.z)};
+    }
+
+    void insert(const T& object, const Range& range) {
+        for (int z = range.z1; z <= range.z2; z++) {
+            for (int x = range.x1; x <= range.x2; x++) {
+                cells[cellKey(x, z)].push_back(Entry {object, range});
+            }
+        }
+    }
+
+    void erase(const T& object, const Range& range) {
+        for (int z = range.z1; z <= range.z2; z++) {
+            for (int x = range.x1; x <= range.x2; x++) {
+                auto found = cells.find(cellKey(x, z));
+                if (found == cells.end()) {
+                    continue;
+                }
+                auto& entries = found->second;
+                for (size_t i = 0; i < entries.size(); i++) {
+                    if (entries[i].object == object) {
+                        entries[i] = std::move(entries.back());
+                        entries.pop_back();
+                        break;
+                    }
+                }
+                if (entries.empty()) {
+                    cells.erase(found);
+                }
+            }
+        }
+    }
+
+    /// @return true if callback requested to stop
+    template <class Func>
+    bool visitCell(
+        const std::vector<Entry>& entries,
+        int x,
+        int z,
+        const Range& query,
+        const Func& callback
+    ) const {
+        for (const auto& entry : entries) {
+            const auto& range = entry.range;
+            // object is reported from the first overlapping cell only
+            if (x != std::max(range.x1, query.x1) ||
+                z != std::max(range.z1, query.z1)) {
+                continue;
+            }
+            if (callback(entry.object)) {
+                return true;
+            }
+        }
+        return false;
+    }
+public:
+    SpatialGrid(float cellSize) : cellSize(cellSize) {
+    }
+
+    /// @brief Add object or update its bounding box
+    void update(const T& object, const AABB& box) {
+        Range range = calcRange(box);
+        auto found = ranges.find(object);
+        if (found != ranges.end()) {
+            if (found->second == range) {
+                return;
+            }
+            erase(object, found->second);
+            found->second = range;
+        } else {
+            ranges[object] = range;
+        }
+        insert(object, range);
+    }
+
+    void remove(const T& object) {
+        auto found = ranges.find(object);
+        if (found == ranges.end()) {
+            return;
+        }
+        erase(object, found->second);
+        ranges.erase(found);
+    }
+
+    void clear() {
+        cells.clear();
+        ranges.clear();
+    }
+
+    size_t size() const {
+        return ranges.size();
+    }
+
+    /// @brief Visit each object which bounding box cells overlap the box
+    /// cells. Objects are visited once. Exact test is caller's task.
+    /// @param callback bool(const T&) returning true to stop the query
+    /// @return true if stopped by callback
+    template <class Func>
+    bool query(const AABB& box, const Func& callback) const {
+        Range query = calcRange(box);
+        int64_t width = static_cast<int64_t>(query.x2) - query.x1 + 1;
+        int64_t depth = static_cast<int64_t>(query.z2) - query.z1 + 1;
+        if (width * depth > static_cast<int64_t>(cells.size())) {
+            for (const auto& [key, entries] : cells) {
+                int x = static_cast<int>(key >> 32);
+                int z = static_cast<int32_t>(key & 0xFFFFFFFF);
+                if (x < query.x1 || x > query.x2 ||
+                    z < query.z1 || z > query.z2) {
+                    continue;
+                }
+                if (visitCell(entries, x, z, query, callback)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        for (int z = query.z1; z <= query.z2; z++) {
+            for (int x = query.x1; x <= query.x2; x++) {
+                auto found = cells.find(cellKey(x, z));
+                if (found == cells.end()) {
+                    continue;
+                }
+                if (visitCell(found->second, x, z, query, callback)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+};
@@ -72,6 +72,16 @@ struct DebugSettings {
     FlagSetting doWriteLights {true};
 };
 
+struct ScriptingSettings {
+    /// @brief Max microseconds per frame that engine uses for incremental
+    /// Lua garbage collection steps (0 - automatic collection only)
+    IntegerSetting gcBudget {1000, 0, 8000};
+    /// @brief Lua garbage collection step size (kilobytes)
+    IntegerSetting gcStepSize {16, 1, 1024};
+    /// @brief Lua heap growth (percents) starting a new collection cycle
+    IntegerSetting gcPause {200, 100, 400};
+};
+
 struct UiSettings {
     StringSetting language {"auto"};
     IntegerSetting worldPreviewSize {64, 1, 512};
@@ -84,5 +94,6 @@ struct EngineSettings {
     CameraSettings camera;
     GraphicsSettings graphics;
     DebugSettings debug;
+    ScriptingSettings scripting;
     UiSettings ui;
 };
@@ -4,6 +4,8 @@
 #include <stdint.h>
 
 using scriptenv = std::shared_ptr<int>;
+/// @brief script function reference owning handle
+using scriptfunc = std::shared_ptr<int>;
 using observer_handler = std::shared_ptr<int>;
 
 /// @brief dynamic integer type (64 bit signed integer)
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "typedefs.hpp"
+
+namespace util {
+    /// @brief Persistent threads splitting a range of indices into contiguous
+    /// partitions processed in parallel with the calling thread.
+    /// Unlike ThreadPool, run() blocks until all partitions are done
+    class ParallelWorkers {
+        using partition_func = std::function<void(size_t, size_t, uint)>;
+
+        std::vector<std::thread> threads;
+        std::mutex mutex;
+        std::condition_variable startCondition;
+        std::condition_variable doneCondition;
+        const partition_func* func = nullptr;
+        size_t count = 0;
+        uint generation = 0;
+        uint running = 0;
+        bool working = true;
+        std::exception_ptr error;
+
+        size_t partitionBegin(uint index) const {
+            return count * index / (threads.size() + 1);
+        }
+
+        void process(uint index) {
+            try {
+                (*func)(partitionBegin(index), partitionBegin(index + 1), index);
+            } catch (...) {
+                std::lock_guard lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        }
+
+        void threadLoop(uint index) {
+            uint lastGeneration = 0;
+            while (true) {
+                {
+                    std::unique_lock lock(mutex);
+                    startCondition.wait(lock, [&] {
+                        return !working || generation != lastGeneration;
+                    });
+                    if (!working) {
+                        return;
+                    }
+                    lastGeneration = generation;
+                }
+                process(index);
+                {
+                    std::lock_guard lock(mutex);
+                    running--;
+                }
+                doneCondition.notify_one();
+            }
+        }
+    public:
+        /// @param workers number of additional threads
+        /// (hardware concurrency minus one if zero)
+        ParallelWorkers(uint workers = 0) {
+            if (workers == 0) {
+                uint concurrency = std::thread::hardware_concurrency();
+                workers = concurrency > 1 ? concurrency - 1 : 0;
+            }
+            for (uint i = 0; i < workers; i++) {
+                // calling thread takes index 0 partition
+                threads.emplace_back(&ParallelWorkers::threadLoop, this, i + 1);
+            }
+        }
+
+        ~ParallelWorkers() {
+            {
+                std::lock_guard lock(mutex);
+                working = false;
+            }
+            startCondition.notify_all();
+            for (auto& thread : threads) {
+                thread.join();
+            }
+        }
+
+        /// @brief Process [0, count) range partitions in parallel
+        /// @param count range size
+        /// @param callback function(begin, end, partitionIndex)
+        /// @throws first exception thrown by callback
+        void run(size_t count, const partition_func& callback) {
+            if (threads.empty() || count < 2) {
+                callback(0, count, 0);
+                return;
+            }
+            {
+                std::lock_guard lock(mutex);
+                this->func = &callback;
+                this->count = count;
+                running = threads.size();
+                error = nullptr;
+                generation++;
+            }
+            startCondition.notify_all();
+            process(0);
+            std::unique_lock lock(mutex);
+            doneCondition.wait(lock, [this] { return running == 0; });
+            func = nullptr;
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        /// @brief Max number of partitions (calling thread included)
+        uint getPartitionsCount() const {
+            return threads.size() + 1;
+        }
+    };
+}
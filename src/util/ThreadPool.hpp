@@ -76,7 +76,7 @@ namespace util {
                     {
                         std::lock_guard<std::mutex> lock(resultsMutex);
                         results.push(ThreadPoolResult<T, R> {
-                            job, variable, index, locked, result});
+                            job, variable, index, locked, std::move(result)});
                         if (!standaloneResults) {
                             locked = true;
                         }
@@ -136,7 +136,7 @@ namespace util {
             {
                 std::lock_guard<std::mutex> lock(resultsMutex);
                 while (!results.empty()) {
-                    ThreadPoolResult<T, R> entry = results.front();
+                    ThreadPoolResult<T, R> entry = std::move(results.front());
                     results.pop();
                     if (!standaloneResults) {
                         entry.locked = false;
@@ -163,7 +163,7 @@ namespace util {
             {
                 std::lock_guard<std::mutex> lock(resultsMutex);
                 while (!results.empty()) {
-                    ThreadPoolResult<T, R> entry = results.front();
+                    ThreadPoolResult<T, R> entry = std::move(results.front());
                     results.pop();
 
                     try {
@@ -116,8 +116,9 @@ void Block::cloneTo(Block& dst) {
     dst.modelExtraPoints = modelExtraPoints;
     dst.modelUVs = modelUVs;
     dst.material = material;
-    std::copy(&emission[0], &emission[3], dst.emission);
+    std::copy(&emission[0], &emission[4], dst.emission);
     dst.size = size;
+    dst.drawGroup = drawGroup;
     dst.model = model;
     dst.lightPassing = lightPassing;
     dst.skyLightPassing = skyLightPassing;
@@ -32,6 +32,19 @@ struct block_funcs_set {
     bool oninteract : 1;
     bool randupdate : 1;
     bool onblockstick : 1;
+    bool randupdatebatch : 1;
+};
+
+/// @brief Block script functions resolved on script load
+/// (nullptr if not defined)
+struct block_callbacks {
+    scriptfunc update;
+    scriptfunc randupdate;
+    scriptfunc onbroken;
+    scriptfunc onplaced;
+    scriptfunc oninteract;
+    scriptfunc onblockstick;
+    scriptfunc randupdatebatch;
 };
 
 struct CoordSystem {
@@ -204,6 +217,9 @@ public:
         /// @brief set of block callbacks flags
         block_funcs_set funcsset {};
 
+        /// @brief pre-resolved block callbacks
+        block_callbacks callbacks {};
+
         /// @brief picking item integer id
         itemid_t pickingItem = 0;
     } rt {};
@@ -96,6 +96,44 @@ const AABB* Chunks::isObstacleAt(float x, float y, float z) {
     return nullptr;
 }
 
+void Chunks::getObstacles(
+    const glm::ivec3& min, const glm::ivec3& max, std::vector<AABB>& dst
+) const {
+    int maxY = std::min(max.y, CHUNK_H - 1);
+    for (int y = min.y; y <= maxY; y++) {
+        for (int z = min.z; z <= max.z; z++) {
+            for (int x = min.x; x <= max.x; x++) {
+                glm::vec3 cell(x, y, z);
+                voxel* v = get(x, y, z);
+                if (v == nullptr) {
+                    dst.emplace_back(cell, cell + glm::vec3(1.0f));
+                    continue;
+                }
+                const auto& def = indices->blocks.require(v->id);
+                if (!def.obstacle) {
+                    continue;
+                }
+                glm::vec3 offset {};
+                if (v->state.segment) {
+                    glm::ivec3 point(x, y, z);
+                    offset = seekOrigin(point, def, v->state) - point;
+                }
+                const auto& boxes = def.rotatable 
+                    ? def.rt.hitboxes[v->state.rotation] 
+                    : def.hitboxes;
+                for (const auto& hitbox : boxes) {
+                    auto a = glm::max(hitbox.min() + offset, glm::vec3(0.0f));
+                    auto b = glm::min(hitbox.max() + offset, glm::vec3(1.0f));
+                    if (a.x >= b.x || a.y >= b.y || a.z >= b.z) {
+                        continue;
+                    }
+                    dst.emplace_back(cell + a, cell + b);
+                }
+            }
+        }
+    }
+}
+
 bool Chunks::isSolidBlock(int32_t x, int32_t y, int32_t z) {
     voxel* v = get(x, y, z);
     if (v == nullptr) return false;
@@ -174,7 +212,7 @@ Chunk* Chunks::getChunk(int x, int z) {
 
 glm::ivec3 Chunks::seekOrigin(
     glm::ivec3 pos, const Block& def, blockstate state
-) {
+) const {
     const auto& rotation = def.rotations.variants[state.rotation];
     auto segment = state.segment;
     while (true) {
@@ -72,7 +72,9 @@ public:
     /// @param def segment block definition
     /// @param state segment block state
     /// @return origin block position or `pos` if block is not extended
-    glm::ivec3 seekOrigin(glm::ivec3 pos, const Block& def, blockstate state);
+    glm::ivec3 seekOrigin(
+        glm::ivec3 pos, const Block& def, blockstate state
+    ) const;
 
     /// @brief Check if required zone is replaceable
     /// @param def definition of the block that requires a replaceable zone
@@ -101,6 +103,16 @@ public:
     glm::vec3 rayCastToObstacle(glm::vec3 start, glm::vec3 dir, float maxDist);
 
     const AABB* isObstacleAt(float x, float y, float z);
+
+    /// @brief Collect obstacle hitboxes of the blocks area in world space.
+    /// Hitboxes are clipped by their voxels to match isObstacleAt checks.
+    /// Missing voxels below the world top are full-block obstacles.
+    /// @param min area minimal block position
+    /// @param max area maximal block position (inclusive)
+    /// @param dst destination vector
+    void getObstacles(
+        const glm::ivec3& min, const glm::ivec3& max, std::vector<AABB>& dst
+    ) const;
     bool isSolidBlock(int32_t x, int32_t y, int32_t z);
     bool isReplaceableBlock(int32_t x, int32_t y, int32_t z);
     bool isObstacleBlock(int32_t x, int32_t y, int32_t z);
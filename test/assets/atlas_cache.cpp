@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+
+#include "assets/atlas_cache.hpp"
+#include "files/files.hpp"
+#include "graphics/core/Atlas.hpp"
+#include "graphics/core/ImageData.hpp"
+#include "graphics/core/Texture.hpp"
+
+namespace fs = std::filesystem;
+
+class AtlasCacheTest : public ::testing::Test {
+protected:
+    fs::path folder;
+    std::vector<fs::path> files;
+
+    void SetUp() override {
+        // unique per test and run to not race with parallel runs
+        auto test = ::testing::UnitTest::GetInstance()->current_test_info();
+        folder = fs::temp_directory_path() /
+                 fs::u8path(
+                     std::string("ve_atlas_cache_") + test->name() + "_" +
+                     std::to_string(std::random_device()())
+                 );
+        fs::remove_all(folder);
+        fs::create_directories(folder);
+        for (int i = 0; i < 3; i++) {
+            auto file = folder / fs::u8path(std::to_string(i) + ".png");
+            std::string content(100 + i, 'x');
+            files::write_string(file, content);
+            files.push_back(file);
+        }
+    }
+
+    void TearDown() override {
+        fs::remove_all(folder);
+    }
+};
+
+static uint64_t compute_key(
+    const std::vector<fs::path>& files,
+    uint extrusion = 2,
+    uint maxResolution = 0,
+    AtlasPacker packer = AtlasPacker::skyline
+) {
+    return atlas_cache::compute_key(files, extrusion, maxResolution, packer);
+}
+
+static std::unique_ptr<Atlas> create_atlas() {
+    AtlasBuilder builder;
+    for (uint i = 0; i < 12; i++) {
+        uint width = 8 + i * 3;
+        uint height = 16 - i;
+        auto image =
+            std::make_unique<ImageData>(ImageFormat::rgba8888, width, height);
+        ubyte* data = image->getData();
+        for (uint j = 0; j < width * height * 4; j++) {
+            data[j] = static_cast<ubyte>(j * 7 + i * 31);
+        }
+        builder.add("texture" + std::to_string(i), std::move(image));
+    }
+    return builder.build(2, false);
+}
+
+TEST_F(AtlasCacheTest, WriteRead) {
+    auto atlas = create_atlas();
+    auto key = compute_key(files);
+    auto file = folder / fs::u8path("blocks.atlas");
+    ASSERT_TRUE(atlas_cache::write(file, key, *atlas));
+
+    auto loaded = atlas_cache::read(file, key);
+    ASSERT_NE(loaded, nullptr);
+    auto image = atlas->getImage();
+    auto loadedImage = loaded->getImage();
+    ASSERT_EQ(loadedImage->getFormat(), image->getFormat());
+    ASSERT_EQ(loadedImage->getWidth(), image->getWidth());
+    ASSERT_EQ(loadedImage->getHeight(), image->getHeight());
+    EXPECT_EQ(
+        std::memcmp(
+            loadedImage->getData(),
+            image->getData(),
+            image->getWidth() * image->getHeight() * 4
+        ),
+        0
+    );
+    ASSERT_EQ(loaded->getRegions().size(), atlas->getRegions().size());
+    for (const auto& [name, region] : atlas->getRegions()) {
+        auto found = loaded->getIf(name);
+        ASSERT_TRUE(found.has_value());
+        EXPECT_EQ(found->u1, region.u1);
+        EXPECT_EQ(found->v1, region.v1);
+        EXPECT_EQ(found->u2, region.u2);
+        EXPECT_EQ(found->v2, region.v2);
+    }
+    EXPECT_EQ(loaded->getTexture(), nullptr);
+
+    EXPECT_EQ(atlas_cache::read(file, key + 1), nullptr);
+    EXPECT_EQ(atlas_cache::read(folder / fs::u8path("missing"), key), nullptr);
+}
+
+TEST_F(AtlasCacheTest, DamagedFile) {
+    auto atlas = create_atlas();
+    auto key = compute_key(files);
+    auto file = folder / fs::u8path("blocks.atlas");
+    ASSERT_TRUE(atlas_cache::write(file, key, *atlas));
+
+    auto bytes = files::read_bytes(file);
+    files::write_bytes(file, bytes.data(), bytes.size() - 16);
+    EXPECT_EQ(atlas_cache::read(file, key), nullptr);
+
+    bytes[bytes.size() / 2] ^= 0x5A;
+    files::write_bytes(file, bytes.data(), bytes.size());
+    EXPECT_EQ(atlas_cache::read(file, key), nullptr);
+}
+
+TEST_F(AtlasCacheTest, InvalidImageSize) {
+    auto atlas = create_atlas();
+    auto key = compute_key(files);
+    auto file = folder / fs::u8path("blocks.atlas");
+    ASSERT_TRUE(atlas_cache::write(file, key, *atlas));
+    auto bytes = files::read_bytes(file);
+
+    // image width and height follow magic, version, key and format
+    const size_t sizeOffset = 8 + 4 + 8 + 4;
+    auto write_size = [&](uint32_t width, uint32_t height) {
+        auto damaged = bytes;
+        for (int i = 0; i < 4; i++) {
+            damaged[sizeOffset + i] = (width >> (i * 8)) & 0xFF;
+            damaged[sizeOffset + 4 + i] = (height >> (i * 8)) & 0xFF;
+        }
+        files::write_bytes(file, damaged.data(), damaged.size());
+    };
+    write_size(0, 0);
+    EXPECT_EQ(atlas_cache::read(file, key), nullptr);
+    write_size(0xFFFFFFFF, 0xFFFFFFFF);
+    EXPECT_EQ(atlas_cache::read(file, key), nullptr);
+    write_size(Texture::MAX_RESOLUTION + 1, 16);
+    EXPECT_EQ(atlas_cache::read(file, key), nullptr);
+    // more than the compressed data could contain
+    write_size(Texture::MAX_RESOLUTION, Texture::MAX_RESOLUTION);
+    EXPECT_EQ(atlas_cache::read(file, key), nullptr);
+
+    write_size(atlas->getImage()->getWidth(), atlas->getImage()->getHeight());
+    EXPECT_NE(atlas_cache::read(file, key), nullptr);
+}
+
+TEST_F(AtlasCacheTest, KeyInvalidation) {
+    auto key = compute_key(files);
+    EXPECT_EQ(compute_key(files), key);
+    EXPECT_NE(compute_key(files, 1), key);
+    EXPECT_NE(compute_key(files, 2, 4096), key);
+    EXPECT_NE(compute_key(files, 2, 0, AtlasPacker::lmpacker), key);
+
+    auto reordered = files;
+    std::swap(reordered[0], reordered[1]);
+    EXPECT_NE(compute_key(reordered), key);
+
+    auto added = files;
+    added.push_back(folder / fs::u8path("3.png"));
+    files::write_string(added.back(), "new texture");
+    EXPECT_NE(compute_key(added), key);
+
+    auto time = fs::last_write_time(files[1]);
+    fs::last_write_time(files[1], time + std::chrono::seconds(10));
+    auto touchedKey = compute_key(files);
+    EXPECT_NE(touchedKey, key);
+
+    fs::last_write_time(files[1], time);
+    EXPECT_EQ(compute_key(files), key);
+
+    files::write_string(files[2], "modified");
+    fs::last_write_time(files[2], fs::last_write_time(files[0]));
+    EXPECT_NE(compute_key(files), key);
+}
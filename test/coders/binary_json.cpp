@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include "coders/binary_json.hpp"
+#include "coders/byte_utils.hpp"
+#include "coders/json.hpp"
+#include "data/dynamic.hpp"
+#include "../data/dynamic_equals.hpp"
+
+using namespace dynamic;
+
+static Map_sptr create_nested(int depth, int width) {
+    auto map = create_map();
+    map->put("depth", depth);
+    map->put("name", "level " + std::to_string(depth));
+    map->put("big", static_cast<int64_t>(depth * 10'000'000'000LL));
+    map->put("ratio", depth * 0.5);
+    map->put("flag", depth % 2 == 0);
+    auto& list = map->putList("items");
+    for (int i = 0; i < width; i++) {
+        list.put(static_cast<integer_t>(i * 1000 - 300));
+        list.put("item " + std::to_string(i));
+    }
+    if (depth > 0) {
+        map->put("child", create_nested(depth - 1, width));
+        list.put(create_nested(depth - 1, 1));
+    }
+    return map;
+}
+
+TEST(BinaryJson, NestedDocumentsLayout) {
+    auto list = create_list({static_cast<integer_t>(1), std::string("x")});
+    auto root = create_map({{"a", create_map({{"b", list}})}});
+
+    std::vector<ubyte> expected {
+        0x01, 26, 0, 0, 0, 'a', 0,
+        0x01, 18, 0, 0, 0, 'b', 0,
+        0x02, 0x03, 1, 0x08, 1, 0, 0, 0, 'x', 0x00,
+        0x00,
+        0x00,
+    };
+    EXPECT_EQ(json::to_binary(root.get()), expected);
+
+    ByteBuilder builder;
+    builder.put(0xFF);
+    json::write_binary(builder, root.get());
+    auto appended = builder.build();
+    EXPECT_EQ(appended.size(), expected.size() + 1);
+    EXPECT_TRUE(
+        std::equal(expected.begin(), expected.end(), appended.begin() + 1)
+    );
+}
+
+TEST(BinaryJson, RoundTrip) {
+    auto root = create_nested(8, 16);
+    for (bool compress : {false, true}) {
+        auto bytes = json::to_binary(root.get(), compress);
+        auto decoded = json::from_binary(bytes.data(), bytes.size());
+        EXPECT_TRUE(equals(root, decoded));
+    }
+}
+
+TEST(BinaryJson, Streaming) {
+    auto root = create_nested(10, 64);
+    auto expected = json::to_binary(root.get());
+    ASSERT_GT(expected.size(), 128 * 1024);
+
+    std::vector<ubyte> streamed;
+    size_t chunks = 0;
+    json::write_binary(root.get(), [&](const ubyte* data, size_t size) {
+        EXPECT_GT(size, 0);
+        EXPECT_LT(size, 128 * 1024);
+        streamed.insert(streamed.end(), data, data + size);
+        chunks++;
+    });
+    EXPECT_GT(chunks, 1);
+    EXPECT_EQ(streamed, expected);
+}
+
+TEST(BinaryJson, LazyView) {
+    auto root = create_nested(4, 8);
+    auto bytes = json::to_binary(root.get(), true);
+    json::BinaryDocument document(bytes.data(), bytes.size());
+    const auto& view = document.getRoot();
+
+    EXPECT_EQ(view.size(), root->size());
+    EXPECT_EQ(view.get("depth", 0), 4);
+    EXPECT_EQ(view.get("name", std::string()), "level 4");
+    EXPECT_EQ(view.get("ratio", 0.0), 2.0);
+    EXPECT_TRUE(view.get("flag", false));
+    EXPECT_FALSE(view.has("missing"));
+    EXPECT_EQ(view.get("missing", 7), 7);
+
+    auto child = view.map("child").map("child");
+    ASSERT_TRUE(child);
+    EXPECT_EQ(child.get("depth", 0), 2);
+    EXPECT_EQ(child.get("big", static_cast<integer_t>(0)), 20'000'000'000);
+
+    auto items = view.list("items");
+    ASSERT_TRUE(items);
+    EXPECT_EQ(items.size(), 17);
+    EXPECT_EQ(items.get(2).asInteger(), 700);
+    EXPECT_EQ(items.get(3).asString(), "item 1");
+    EXPECT_EQ(items.get(16).asMap().get("depth", 0), 3);
+    EXPECT_FALSE(items.get(17));
+    EXPECT_FALSE(view.map("items"));
+
+    EXPECT_TRUE(equals(view.toMap(), root));
+    EXPECT_TRUE(equals(items.toList(), root->list("items")));
+}
+
+TEST(BinaryJson, LazyViewTruncated) {
+    auto bytes = json::to_binary(create_nested(2, 4).get());
+    bytes.resize(bytes.size() / 2);
+    EXPECT_THROW(
+        json::BinaryDocument(bytes.data(), bytes.size()), std::runtime_error
+    );
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "coders/gzip.hpp"
+
+static std::vector<ubyte> create_data(size_t size) {
+    std::vector<ubyte> data(size);
+    ubyte next = rand();
+    for (size_t i = 0; i < size; i++) {
+        data[i] = next;
+        if (rand() % 7 == 0) {
+            next = rand();
+        }
+    }
+    return data;
+}
+
+TEST(GZIP, CompressDecompress) {
+    auto data = create_data(300'000);
+    for (int level : {gzip::DEFAULT_LEVEL, 0, gzip::BEST_SPEED,
+                      gzip::BEST_COMPRESSION}) {
+        auto compressed = gzip::compress(data.data(), data.size(), level);
+        EXPECT_EQ(compressed[0], gzip::MAGIC[0]);
+        EXPECT_EQ(compressed[1], gzip::MAGIC[1]);
+        auto decompressed =
+            gzip::decompress(compressed.data(), compressed.size());
+        EXPECT_EQ(decompressed, data);
+    }
+}
+
+TEST(GZIP, StreamingChunks) {
+    auto data = create_data(500'000);
+    std::vector<ubyte> compressed;
+    gzip::Encoder encoder([&](const ubyte* chunk, size_t size) {
+        compressed.insert(compressed.end(), chunk, chunk + size);
+    });
+    for (size_t offset = 0; offset < data.size(); offset += 1000) {
+        size_t size = std::min<size_t>(1000, data.size() - offset);
+        encoder.write(data.data() + offset, size);
+    }
+    encoder.finish();
+
+    std::vector<ubyte> decompressed;
+    size_t maxChunk = 0;
+    gzip::Decoder decoder([&](const ubyte* chunk, size_t size) {
+        maxChunk = std::max(maxChunk, size);
+        decompressed.insert(decompressed.end(), chunk, chunk + size);
+    });
+    for (size_t offset = 0; offset < compressed.size(); offset += 333) {
+        size_t size = std::min<size_t>(333, compressed.size() - offset);
+        decoder.write(compressed.data() + offset, size);
+    }
+    decoder.finish();
+
+    EXPECT_TRUE(decoder.isFinished());
+    EXPECT_EQ(decompressed, data);
+    EXPECT_LE(maxChunk, 64 * 1024);
+}
+
+TEST(GZIP, CorruptedData) {
+    auto data = create_data(100'000);
+    auto compressed = gzip::compress(data.data(), data.size());
+
+    auto truncated = compressed;
+    truncated.resize(truncated.size() / 2);
+    EXPECT_THROW(
+        gzip::decompress(truncated.data(), truncated.size()),
+        std::runtime_error
+    );
+
+    auto damaged = compressed;
+    for (size_t i = 20; i < damaged.size() - 8; i += 17) {
+        damaged[i] ^= 0x5A;
+    }
+    EXPECT_THROW(
+        gzip::decompress(damaged.data(), damaged.size()), std::runtime_error
+    );
+
+    auto wrongFooter = compressed;
+    wrongFooter[wrongFooter.size() - 1] = 0xFF;
+    EXPECT_THROW(
+        gzip::decompress(wrongFooter.data(), wrongFooter.size()),
+        std::runtime_error
+    );
+
+    EXPECT_THROW(gzip::decompress(compressed.data(), 4), std::runtime_error);
+}
@@ -0,0 +1,317 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <random>
+#include <string>
+
+#include "coders/json.hpp"
+#include "content/ContentLoader.hpp"
+#include "content/ContentPack.hpp"
+#include "content/content_cache.hpp"
+#include "data/dynamic.hpp"
+#include "files/files.hpp"
+#include "items/ItemDef.hpp"
+#include "objects/EntityDef.hpp"
+#include "voxels/Block.hpp"
+
+namespace fs = std::filesystem;
+
+class ContentCacheTest : public ::testing::Test {
+protected:
+    fs::path folder;
+
+    void SetUp() override {
+        // unique per test and run to not race with parallel runs
+        auto test = ::testing::UnitTest::GetInstance()->current_test_info();
+        folder = fs::temp_directory_path() /
+                 fs::u8path(
+                     std::string("ve_content_cache_") + test->name() + "_" +
+                     std::to_string(std::random_device()())
+                 );
+        fs::remove_all(folder);
+        fs::create_directories(folder);
+    }
+
+    void TearDown() override {
+        fs::remove_all(folder);
+    }
+};
+
+static void expect_equal(const AABB& a, const AABB& b) {
+    EXPECT_EQ(a.a, b.a);
+    EXPECT_EQ(a.b, b.b);
+}
+
+static void expect_equal(const Block& a, const Block& b) {
+    EXPECT_EQ(a.name, b.name);
+    EXPECT_EQ(a.caption, b.caption);
+    for (int i = 0; i < 6; i++) {
+        EXPECT_EQ(a.textureFaces[i], b.textureFaces[i]);
+    }
+    EXPECT_EQ(a.modelTextures, b.modelTextures);
+    ASSERT_EQ(a.modelBoxes.size(), b.modelBoxes.size());
+    for (size_t i = 0; i < a.modelBoxes.size(); i++) {
+        expect_equal(a.modelBoxes[i], b.modelBoxes[i]);
+    }
+    EXPECT_EQ(a.modelExtraPoints, b.modelExtraPoints);
+    ASSERT_EQ(a.modelUVs.size(), b.modelUVs.size());
+    for (size_t i = 0; i < a.modelUVs.size(); i++) {
+        EXPECT_EQ(a.modelUVs[i].u1, b.modelUVs[i].u1);
+        EXPECT_EQ(a.modelUVs[i].v1, b.modelUVs[i].v1);
+        EXPECT_EQ(a.modelUVs[i].u2, b.modelUVs[i].u2);
+        EXPECT_EQ(a.modelUVs[i].v2, b.modelUVs[i].v2);
+    }
+    EXPECT_EQ(a.material, b.material);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(a.emission[i], b.emission[i]);
+    }
+    EXPECT_EQ(a.size, b.size);
+    EXPECT_EQ(a.drawGroup, b.drawGroup);
+    EXPECT_EQ(a.model, b.model);
+    EXPECT_EQ(a.lightPassing, b.lightPassing);
+    EXPECT_EQ(a.skyLightPassing, b.skyLightPassing);
+    EXPECT_EQ(a.shadeless, b.shadeless);
+    EXPECT_EQ(a.ambientOcclusion, b.ambientOcclusion);
+    EXPECT_EQ(a.obstacle, b.obstacle);
+    EXPECT_EQ(a.selectable, b.selectable);
+    EXPECT_EQ(a.replaceable, b.replaceable);
+    EXPECT_EQ(a.breakable, b.breakable);
+    EXPECT_EQ(a.rotatable, b.rotatable);
+    EXPECT_EQ(a.grounded, b.grounded);
+    EXPECT_EQ(a.hidden, b.hidden);
+    ASSERT_EQ(a.hitboxes.size(), b.hitboxes.size());
+    for (size_t i = 0; i < a.hitboxes.size(); i++) {
+        expect_equal(a.hitboxes[i], b.hitboxes[i]);
+    }
+    EXPECT_EQ(a.rotations.name, b.rotations.name);
+    for (int i = 0; i < BlockRotProfile::MAX_COUNT; i++) {
+        const auto& variantA = a.rotations.variants[i];
+        const auto& variantB = b.rotations.variants[i];
+        EXPECT_EQ(variantA.axisX, variantB.axisX);
+        EXPECT_EQ(variantA.axisY, variantB.axisY);
+        EXPECT_EQ(variantA.axisZ, variantB.axisZ);
+        EXPECT_EQ(variantA.fix, variantB.fix);
+    }
+    EXPECT_EQ(a.pickingItem, b.pickingItem);
+    EXPECT_EQ(a.scriptName, b.scriptName);
+    EXPECT_EQ(a.uiLayout, b.uiLayout);
+    EXPECT_EQ(a.inventorySize, b.inventorySize);
+    EXPECT_EQ(a.tickInterval, b.tickInterval);
+}
+
+static void expect_equal(const ItemDef& a, const ItemDef& b) {
+    EXPECT_EQ(a.name, b.name);
+    EXPECT_EQ(a.caption, b.caption);
+    EXPECT_EQ(a.stackSize, b.stackSize);
+    EXPECT_EQ(a.generated, b.generated);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(a.emission[i], b.emission[i]);
+    }
+    EXPECT_EQ(a.iconType, b.iconType);
+    EXPECT_EQ(a.icon, b.icon);
+    EXPECT_EQ(a.placingBlock, b.placingBlock);
+    EXPECT_EQ(a.scriptName, b.scriptName);
+}
+
+static void expect_equal(const EntityDef& a, const EntityDef& b) {
+    EXPECT_EQ(a.name, b.name);
+    EXPECT_EQ(a.components, b.components);
+    EXPECT_EQ(a.bodyType, b.bodyType);
+    EXPECT_EQ(a.hitbox, b.hitbox);
+    ASSERT_EQ(a.boxSensors.size(), b.boxSensors.size());
+    for (size_t i = 0; i < a.boxSensors.size(); i++) {
+        EXPECT_EQ(a.boxSensors[i].first, b.boxSensors[i].first);
+        expect_equal(a.boxSensors[i].second, b.boxSensors[i].second);
+    }
+    EXPECT_EQ(a.radialSensors, b.radialSensors);
+    EXPECT_EQ(a.skeletonName, b.skeletonName);
+    EXPECT_EQ(a.blocking, b.blocking);
+    EXPECT_EQ(a.save.enabled, b.save.enabled);
+    EXPECT_EQ(a.save.skeleton.textures, b.save.skeleton.textures);
+    EXPECT_EQ(a.save.skeleton.pose, b.save.skeleton.pose);
+    EXPECT_EQ(a.save.body.velocity, b.save.body.velocity);
+    EXPECT_EQ(a.save.body.settings, b.save.body.settings);
+}
+
+template <class T>
+static std::unique_ptr<T> parse_def(
+    const std::string& name, const std::string& source, T* parent = nullptr
+) {
+    auto def = std::make_unique<T>(name);
+    if (parent) {
+        parent->cloneTo(*def);
+    }
+    auto root = json::parse(source);
+    if constexpr (std::is_same_v<T, Block>) {
+        ContentLoader::loadBlock(*def, name, *root);
+    } else if constexpr (std::is_same_v<T, ItemDef>) {
+        ContentLoader::loadItem(*def, name, *root);
+    } else {
+        ContentLoader::loadEntity(*def, name, *root);
+    }
+    return def;
+}
+
+static std::unique_ptr<content_cache::PackDefs> parse_defs() {
+    auto defs = std::make_unique<content_cache::PackDefs>();
+    defs->blocks.push_back(parse_def<Block>("test:lamp", R"({
+        "texture": "lamp",
+        "emission": [15, 14, 13],
+        "light-passing": true,
+        "draw-group": 5,
+        "material": "base:glass",
+        "rotation": "pipe",
+        "hitboxes": [[0, 0, 0, 1, 0.5, 1], [0.25, 0.5, 0.25, 0.5, 0.5, 0.5]],
+        "inventory-size": 9,
+        "tick-interval": 4,
+        "ui-layout": "test:lamp_layout",
+        "script-name": "lamp_script"
+    })"));
+    defs->blocks.push_back(parse_def<Block>("test:pane", R"({
+        "texture-faces": ["a", "b", "c", "d", "e", "f"],
+        "model": "custom",
+        "model-primitives": {
+            "aabbs": [[0, 0, 0.4, 1, 1, 0.2, "glass"]],
+            "tetragons": [[0, 0, 0.5, 1, 0, 0, 0, 1, 0, "frame"]]
+        },
+        "rotation": "pane",
+        "shadeless": true,
+        "ambient-occlusion": false,
+        "hidden": true
+    })"));
+    defs->blocks.push_back(parse_def<Block>("test:tall", R"({
+        "size": [1, 2, 1],
+        "grounded": true,
+        "replaceable": true,
+        "picking-item": "test:pick"
+    })"));
+    defs->blocks.push_back(parse_def<Block>(
+        "test:lamp_child",
+        R"({"parent": "test:lamp", "caption": "Child lamp"})",
+        defs->blocks[0].get()
+    ));
+
+    defs->items.push_back(parse_def<ItemDef>("test:stick", R"({
+        "icon-type": "sprite",
+        "icon": "items:stick",
+        "stack-size": 16,
+        "emission": [1, 2, 3],
+        "placing-block": "test:tall"
+    })"));
+    defs->items.push_back(parse_def<ItemDef>("test:hidden", R"({
+        "icon-type": "none",
+        "caption": "Hidden item"
+    })"));
+
+    defs->entities.push_back(parse_def<EntityDef>("test:drop", R"({
+        "components": ["base:drop", "test:glow"],
+        "hitbox": [0.2, 0.3, 0.4],
+        "body-type": "kinematic",
+        "sensors": [
+            ["aabb", -0.5, -0.5, -0.5, 0.5, 0.5, 0.5],
+            ["radius", 1.5]
+        ],
+        "save-skeleton-pose": true,
+        "save-body-velocity": false,
+        "skeleton-name": "test:drop_skeleton",
+        "blocking": false
+    })"));
+
+    auto material = std::make_unique<BlockMaterial>();
+    material->name = "test:metal";
+    material->stepsSound = "steps/metal";
+    material->breakSound = "break/metal";
+    defs->materials.push_back(std::move(material));
+
+    defs->resources[static_cast<size_t>(ResourceType::CAMERA)] = {
+        "test:first", "test:second"
+    };
+    return defs;
+}
+
+TEST_F(ContentCacheTest, CachedEqualsParsed) {
+    auto parsed = parse_defs();
+    auto file = folder / fs::u8path("test.content");
+    ASSERT_TRUE(content_cache::write(file, 42, *parsed));
+
+    auto cached = content_cache::read(file, 42);
+    ASSERT_NE(cached, nullptr);
+    ASSERT_EQ(cached->blocks.size(), parsed->blocks.size());
+    for (size_t i = 0; i < parsed->blocks.size(); i++) {
+        expect_equal(*cached->blocks[i], *parsed->blocks[i]);
+
+        // definitions are copied to the builder ones on cache hit
+        Block def(parsed->blocks[i]->name);
+        cached->blocks[i]->cloneTo(def);
+        expect_equal(def, *parsed->blocks[i]);
+    }
+    ASSERT_EQ(cached->items.size(), parsed->items.size());
+    for (size_t i = 0; i < parsed->items.size(); i++) {
+        expect_equal(*cached->items[i], *parsed->items[i]);
+
+        ItemDef def(parsed->items[i]->name);
+        cached->items[i]->cloneTo(def);
+        expect_equal(def, *parsed->items[i]);
+    }
+    ASSERT_EQ(cached->entities.size(), parsed->entities.size());
+    for (size_t i = 0; i < parsed->entities.size(); i++) {
+        expect_equal(*cached->entities[i], *parsed->entities[i]);
+
+        EntityDef def(parsed->entities[i]->name);
+        cached->entities[i]->cloneTo(def);
+        expect_equal(def, *parsed->entities[i]);
+    }
+    ASSERT_EQ(cached->materials.size(), 1);
+    EXPECT_EQ(cached->materials[0]->name, "test:metal");
+    EXPECT_EQ(cached->materials[0]->stepsSound, "steps/metal");
+    EXPECT_EQ(cached->materials[0]->placeSound, "");
+    EXPECT_EQ(cached->materials[0]->breakSound, "break/metal");
+    for (size_t i = 0; i < RESOURCE_TYPES_COUNT; i++) {
+        EXPECT_EQ(cached->resources[i], parsed->resources[i]);
+    }
+
+    EXPECT_EQ(content_cache::read(file, 43), nullptr);
+    EXPECT_EQ(content_cache::read(folder / fs::u8path("missing"), 42), nullptr);
+}
+
+TEST_F(ContentCacheTest, DamagedFile) {
+    auto file = folder / fs::u8path("test.content");
+    ASSERT_TRUE(content_cache::write(file, 42, *parse_defs()));
+
+    auto bytes = files::read_bytes(file);
+    files::write_bytes(file, bytes.data(), bytes.size() - 16);
+    EXPECT_EQ(content_cache::read(file, 42), nullptr);
+
+    bytes[bytes.size() / 2] ^= 0x5A;
+    files::write_bytes(file, bytes.data(), bytes.size());
+    EXPECT_EQ(content_cache::read(file, 42), nullptr);
+}
+
+TEST_F(ContentCacheTest, KeyInvalidation) {
+    ContentPack pack;
+    pack.id = "test";
+    pack.version = "1.0";
+    pack.folder = folder / fs::u8path("test");
+    fs::create_directories(pack.folder / fs::u8path("blocks"));
+    files::write_string(pack.getContentFile(), R"({"blocks": ["a"]})");
+    auto blockFile = pack.folder / fs::u8path("blocks/a.json");
+    files::write_string(blockFile, R"({"texture": "a"})");
+
+    auto key = content_cache::compute_key(pack, 0);
+    EXPECT_EQ(content_cache::compute_key(pack, 0), key);
+    EXPECT_NE(content_cache::compute_key(pack, 1), key);
+
+    pack.version = "1.1";
+    EXPECT_NE(content_cache::compute_key(pack, 0), key);
+    pack.version = "1.0";
+
+    files::write_string(blockFile, R"({"texture": "b"})");
+    EXPECT_NE(content_cache::compute_key(pack, 0), key);
+    files::write_string(blockFile, R"({"texture": "a"})");
+    EXPECT_EQ(content_cache::compute_key(pack, 0), key);
+
+    auto materialFile = pack.folder / fs::u8path("block_materials/a.json");
+    fs::create_directories(materialFile.parent_path());
+    files::write_string(materialFile, "{}");
+    EXPECT_NE(content_cache::compute_key(pack, 0), key);
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <stdexcept>
+
+#include "content/loading_order.hpp"
+
+// Sequential loading passes the resolved order must be equal to
+static std::vector<size_t> passes_order(
+    const std::vector<std::string>& names,
+    const std::vector<std::string>& parents,
+    std::set<std::string> registered
+) {
+    std::vector<size_t> order;
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < names.size(); i++) {
+        if (parents[i].empty() || registered.count(parents[i])) {
+            registered.insert(names[i]);
+            order.push_back(i);
+        } else {
+            pending.push_back(i);
+        }
+    }
+    bool progressMade = true;
+    while (!pending.empty() && progressMade) {
+        progressMade = false;
+        for (auto it = pending.begin(); it != pending.end();) {
+            if (registered.count(parents[*it])) {
+                registered.insert(names[*it]);
+                order.push_back(*it);
+                it = pending.erase(it);
+                progressMade = true;
+            } else {
+                ++it;
+            }
+        }
+    }
+    if (!pending.empty()) {
+        throw std::runtime_error("unresolved");
+    }
+    return order;
+}
+
+TEST(loading_order, SequentialPassesOrder) {
+    std::mt19937 random(7);
+    std::set<std::string> registered {"base:stone", "base:wood"};
+    auto exists = [&registered](const std::string& name) {
+        return registered.count(name) > 0;
+    };
+    for (int iteration = 0; iteration < 200; iteration++) {
+        size_t count = 1 + random() % 60;
+        std::vector<size_t> ids(count);
+        for (size_t i = 0; i < count; i++) {
+            ids[i] = i;
+        }
+        std::shuffle(ids.begin(), ids.end(), random);
+
+        // random forest: any definition may inherit one with lower id
+        std::vector<std::string> names(count);
+        std::vector<std::string> parents(count);
+        std::vector<size_t> positions(count);
+        for (size_t i = 0; i < count; i++) {
+            names[i] = "pack:def" + std::to_string(ids[i]);
+            positions[ids[i]] = i;
+        }
+        for (size_t i = 0; i < count; i++) {
+            switch (random() % 4) {
+                case 0:
+                    break;
+                case 1:
+                    parents[i] = random() % 2 ? "base:stone" : "base:wood";
+                    break;
+                default:
+                    if (ids[i] > 0) {
+                        size_t parentId = random() % ids[i];
+                        parents[i] = names[positions[parentId]];
+                    }
+                    break;
+            }
+        }
+        EXPECT_EQ(
+            resolve_loading_order(names, parents, exists),
+            passes_order(names, parents, registered)
+        );
+    }
+}
+
+TEST(loading_order, ParentFromAnotherPack) {
+    std::vector<std::string> names {"pack:a", "pack:b"};
+    std::vector<std::string> parents {"pack:b", "base:b"};
+    // parent registered by another pack overrides the same pack definition
+    auto order = resolve_loading_order(names, parents, [](const auto& name) {
+        return name == "base:b" || name == "pack:b";
+    });
+    EXPECT_EQ(order, (std::vector<size_t> {0, 1}));
+}
+
+TEST(loading_order, MissingParent) {
+    std::vector<std::string> names {"pack:a", "pack:b", "pack:c"};
+    std::vector<std::string> parents {"", "pack:c", "pack:missing"};
+    EXPECT_THROW(
+        resolve_loading_order(names, parents, [](const auto&) {
+            return false;
+        }),
+        std::runtime_error
+    );
+}
+
+TEST(loading_order, CyclicInheritance) {
+    std::vector<std::string> names {"pack:a", "pack:b", "pack:c", "pack:d"};
+    std::vector<std::string> parents {"", "pack:d", "pack:b", "pack:c"};
+    EXPECT_THROW(
+        resolve_loading_order(names, parents, [](const auto&) {
+            return false;
+        }),
+        std::runtime_error
+    );
+    parents = {"pack:a"};
+    names = {"pack:a"};
+    EXPECT_THROW(
+        resolve_loading_order(names, parents, [](const auto&) {
+            return false;
+        }),
+        std::runtime_error
+    );
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "coders/json.hpp"
+#include "data/dynamic.hpp"
+
+/// @brief Deep comparison of values (maps are compared regardless of
+/// the keys order)
+inline bool equals(const dynamic::Value& a, const dynamic::Value& b) {
+    if (a.index() != b.index()) {
+        return false;
+    }
+    if (auto map = std::get_if<dynamic::Map_sptr>(&a)) {
+        const auto& other = std::get<dynamic::Map_sptr>(b);
+        if ((*map)->size() != other->size()) {
+            return false;
+        }
+        for (const auto& [key, value] : (*map)->values) {
+            const auto& found = other->values.find(key);
+            if (found == other->values.end() ||
+                !equals(value, found->second)) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (auto list = std::get_if<dynamic::List_sptr>(&a)) {
+        const auto& other = std::get<dynamic::List_sptr>(b);
+        if ((*list)->size() != other->size()) {
+            return false;
+        }
+        for (size_t i = 0; i < (*list)->size(); i++) {
+            if (!equals((*list)->values[i], other->values[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+    return json::stringify(a, false, "") == json::stringify(b, false, "");
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "graphics/core/Atlas.hpp"
+#include "graphics/core/ImageData.hpp"
+#include "util/ParallelWorkers.hpp"
+
+static std::unique_ptr<Atlas> build_atlas(
+    util::ParallelWorkers* workers, AtlasPacker packer
+) {
+    AtlasBuilder builder;
+    builder.setPacker(packer);
+    for (uint i = 0; i < 100; i++) {
+        uint width = 4 + (i * 7) % 29;
+        uint height = 4 + (i * 13) % 23;
+        auto image =
+            std::make_unique<ImageData>(ImageFormat::rgba8888, width, height);
+        ubyte* data = image->getData();
+        for (uint j = 0; j < width * height * 4; j++) {
+            data[j] = static_cast<ubyte>(j * 5 + i * 17);
+        }
+        builder.add("texture" + std::to_string(i), std::move(image));
+    }
+    return builder.build(2, false, 0, workers);
+}
+
+static void check_deterministic(AtlasPacker packer) {
+    auto expected = build_atlas(nullptr, packer);
+    const auto& expectedImage = *expected->getImage();
+    size_t size = expectedImage.getWidth() * expectedImage.getHeight() * 4;
+
+    for (uint threads : {1, 2, 3, 7}) {
+        util::ParallelWorkers workers(threads);
+        auto atlas = build_atlas(&workers, packer);
+        const auto& image = *atlas->getImage();
+        ASSERT_EQ(image.getWidth(), expectedImage.getWidth());
+        ASSERT_EQ(image.getHeight(), expectedImage.getHeight());
+        EXPECT_EQ(
+            std::memcmp(image.getData(), expectedImage.getData(), size), 0
+        );
+        for (const auto& [name, region] : expected->getRegions()) {
+            const auto& other = atlas->get(name);
+            EXPECT_EQ(other.u1, region.u1);
+            EXPECT_EQ(other.v1, region.v1);
+            EXPECT_EQ(other.u2, region.u2);
+            EXPECT_EQ(other.v2, region.v2);
+        }
+    }
+}
+
+TEST(Atlas, ParallelBuildIsDeterministic) {
+    check_deterministic(AtlasPacker::lmpacker);
+    check_deterministic(AtlasPacker::skyline);
+}
+
+TEST(Atlas, SkylinePacking) {
+    AtlasBuilder builder;
+    builder.setPacker(AtlasPacker::skyline);
+    for (uint i = 0; i < 64; i++) {
+        builder.add(
+            "texture" + std::to_string(i),
+            std::make_unique<ImageData>(ImageFormat::rgba8888, 16, 16)
+        );
+    }
+    auto atlas = builder.build(2, false);
+    // 20x20 with extrusion: width 256 estimated from area, 12 per row
+    EXPECT_EQ(atlas->getImage()->getWidth(), 256);
+    EXPECT_EQ(atlas->getImage()->getHeight(), 128);
+    EXPECT_EQ(atlas->getRegions().size(), 64);
+    const auto& region = atlas->get("texture0");
+    EXPECT_FLOAT_EQ(region.getWidth(), 16.0f / 256);
+}
@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <random>
+
+#include "graphics/core/ImageData.hpp"
+
+// Per-pixel scalar versions of the kernels used as the reference
+
+static void blit_reference(ImageData& dst, const ImageData& src, int x, int y) {
+    uint dstcomps = dst.getFormat() == ImageFormat::rgba8888 ? 4 : 3;
+    uint srccomps = src.getFormat() == ImageFormat::rgba8888 ? 4 : 3;
+    for (int sy = 0; sy < static_cast<int>(src.getHeight()); sy++) {
+        for (int sx = 0; sx < static_cast<int>(src.getWidth()); sx++) {
+            int dx = sx + x;
+            int dy = sy + y;
+            if (dx < 0 || dy < 0 || dx >= static_cast<int>(dst.getWidth()) ||
+                dy >= static_cast<int>(dst.getHeight())) {
+                continue;
+            }
+            ubyte* d = dst.getData() + (dy * dst.getWidth() + dx) * dstcomps;
+            const ubyte* s =
+                src.getData() + (sy * src.getWidth() + sx) * srccomps;
+            for (uint c = 0; c < srccomps; c++) {
+                d[c] = s[c];
+            }
+            if (dstcomps == 4 && srccomps == 3) {
+                d[3] = 255;
+            }
+        }
+    }
+}
+
+static void extrude_reference(ImageData& image, int x, int y, int w, int h) {
+    int comps = image.getFormat() == ImageFormat::rgba8888 ? 4 : 3;
+    int width = image.getWidth();
+    int height = image.getHeight();
+    ubyte* data = image.getData();
+    auto copy = [=](int dx, int dy, int sx, int sy) {
+        if (dx < 0 || dy < 0 || dx >= width || dy >= height || sx < 0 ||
+            sy < 0 || sx >= width || sy >= height) {
+            return;
+        }
+        for (int c = 0; c < comps; c++) {
+            data[(dy * width + dx) * comps + c] =
+                data[(sy * width + sx) * comps + c];
+        }
+    };
+    int rx = x + w - 1;
+    int ry = y + h - 1;
+    copy(x - 1, y - 1, x, y);
+    copy(rx + 1, y - 1, rx, y);
+    copy(x - 1, ry + 1, x, ry);
+    copy(rx + 1, ry + 1, rx, ry);
+    for (int ey = y; ey <= ry; ey++) {
+        copy(x - 1, ey, x, ey);
+        copy(rx + 1, ey, rx, ey);
+    }
+    for (int ex = x; ex <= rx; ex++) {
+        copy(ex, y - 1, ex, y);
+        copy(ex, ry + 1, ex, ry);
+    }
+}
+
+static void fix_alpha_color_reference(ImageData& image) {
+    uint width = image.getWidth();
+    uint height = image.getHeight();
+    ubyte* data = image.getData();
+    for (uint ly = 0; ly < height - 1; ly++) {
+        for (uint lx = 0; lx < width - 1; lx++) {
+            if (data[(ly * width + lx) * 4 + 3]) {
+                for (int c = 0; c < 3; c++) {
+                    int val = data[(ly * width + lx) * 4 + c];
+                    if (data[(ly * width + lx + 1) * 4 + 3] == 0)
+                        data[(ly * width + lx + 1) * 4 + c] = val;
+                    if (data[((ly + 1) * width + lx) * 4 + 3] == 0)
+                        data[((ly + 1) * width + lx) * 4 + c] = val;
+                }
+            }
+        }
+    }
+}
+
+static std::unique_ptr<ImageData> create_image(
+    ImageFormat format, uint width, uint height, std::mt19937& random
+) {
+    auto image = std::make_unique<ImageData>(format, width, height);
+    uint comps = format == ImageFormat::rgba8888 ? 4 : 3;
+    for (uint i = 0; i < width * height * comps; i++) {
+        image->getData()[i] = random();
+    }
+    if (format == ImageFormat::rgba8888) {
+        // many transparent pixels for fixAlphaColor
+        for (uint i = 0; i < width * height; i++) {
+            if (random() % 3 == 0) {
+                image->getData()[i * 4 + 3] = 0;
+            }
+        }
+    }
+    return image;
+}
+
+static std::unique_ptr<ImageData> copy_of(const ImageData& image) {
+    return std::make_unique<ImageData>(
+        image.getFormat(), image.getWidth(), image.getHeight(), image.getData()
+    );
+}
+
+static bool equals(const ImageData& a, const ImageData& b) {
+    uint comps = a.getFormat() == ImageFormat::rgba8888 ? 4 : 3;
+    return a.getFormat() == b.getFormat() && a.getWidth() == b.getWidth() &&
+           a.getHeight() == b.getHeight() &&
+           std::memcmp(
+               a.getData(), b.getData(), a.getWidth() * a.getHeight() * comps
+           ) == 0;
+}
+
+TEST(ImageData, Blit) {
+    std::mt19937 random(1);
+    for (auto format : {ImageFormat::rgb888, ImageFormat::rgba8888}) {
+        auto canvas = create_image(ImageFormat::rgba8888, 67, 45, random);
+        auto expected = copy_of(*canvas);
+        auto image = create_image(format, 23, 17, random);
+        for (auto [x, y] : {std::pair {0, 0}, {5, 7}, {-4, 3}, {60, -9},
+                            {50, 40}, {-30, 0}, {100, 100}}) {
+            canvas->blit(image.get(), x, y);
+            blit_reference(*expected, *image, x, y);
+            EXPECT_TRUE(equals(*canvas, *expected)) << x << " " << y;
+        }
+    }
+}
+
+TEST(ImageData, Flip) {
+    std::mt19937 random(2);
+    for (auto format : {ImageFormat::rgb888, ImageFormat::rgba8888}) {
+        auto image = create_image(format, 31, 19, random);
+        auto original = copy_of(*image);
+        uint comps = format == ImageFormat::rgba8888 ? 4 : 3;
+        uint width = image->getWidth();
+        uint height = image->getHeight();
+
+        image->flipX();
+        for (uint y = 0; y < height; y++) {
+            for (uint x = 0; x < width; x++) {
+                EXPECT_EQ(
+                    std::memcmp(
+                        image->getData() + (y * width + x) * comps,
+                        original->getData() +
+                            (y * width + width - x - 1) * comps,
+                        comps
+                    ),
+                    0
+                );
+            }
+        }
+        image->flipX();
+        EXPECT_TRUE(equals(*image, *original));
+
+        image->flipY();
+        for (uint y = 0; y < height; y++) {
+            EXPECT_EQ(
+                std::memcmp(
+                    image->getData() + y * width * comps,
+                    original->getData() + (height - y - 1) * width * comps,
+                    width * comps
+                ),
+                0
+            );
+        }
+    }
+}
+
+TEST(ImageData, Extrude) {
+    std::mt19937 random(3);
+    auto image = create_image(ImageFormat::rgba8888, 40, 30, random);
+    auto expected = copy_of(*image);
+    for (auto [x, y, w, h] :
+         {std::tuple {5, 5, 10, 8}, {0, 0, 12, 12}, {30, 20, 10, 10},
+          {1, 1, 38, 28}, {-3, 4, 8, 30}, {35, -2, 10, 6}}) {
+        image->extrude(x, y, w, h);
+        extrude_reference(*expected, x, y, w, h);
+        EXPECT_TRUE(equals(*image, *expected)) << x << " " << y;
+    }
+}
+
+TEST(ImageData, FixAlphaColor) {
+    std::mt19937 random(4);
+    auto image = create_image(ImageFormat::rgba8888, 37, 29, random);
+    auto expected = copy_of(*image);
+    image->fixAlphaColor();
+    fix_alpha_color_reference(*expected);
+    EXPECT_TRUE(equals(*image, *expected));
+}
+
+TEST(ImageData, Downsample) {
+    std::mt19937 random(5);
+    for (auto [width, height] :
+         {std::pair {64u, 32u}, {17u, 9u}, {1u, 8u}, {5u, 1u}}) {
+        auto image = create_image(ImageFormat::rgba8888, width, height, random);
+        auto half = image->downsample();
+        ASSERT_EQ(half->getWidth(), std::max(width / 2, 1u));
+        ASSERT_EQ(half->getHeight(), std::max(height / 2, 1u));
+        for (uint y = 0; y < half->getHeight(); y++) {
+            for (uint x = 0; x < half->getWidth(); x++) {
+                for (uint c = 0; c < 4; c++) {
+                    uint sum = 0;
+                    for (uint i = 0; i < 4; i++) {
+                        uint sx = std::min(x * 2 + i % 2, width - 1);
+                        uint sy = std::min(y * 2 + i / 2, height - 1);
+                        sum += image->getData()[(sy * width + sx) * 4 + c];
+                    }
+                    EXPECT_EQ(
+                        half->getData()[(y * half->getWidth() + x) * 4 + c],
+                        (sum + 2) / 4
+                    );
+                }
+            }
+        }
+    }
+}
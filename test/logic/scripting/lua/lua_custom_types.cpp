@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include "logic/scripting/lua/lua_custom_types.hpp"
+#include "logic/scripting/lua/lua_util.hpp"
+
+class LuaCustomTypesTest : public ::testing::Test {
+protected:
+    lua::State* L = nullptr;
+
+    void SetUp() override {
+        L = luaL_newstate();
+        ASSERT_NE(L, nullptr);
+        lua::pop(L, luaopen_base(L));
+        lua::newusertype<lua::Bytearray, lua::Bytearray::createMetatable>(
+            L, "bytearray"
+        );
+        lua::newusertype<lua::Vector<3>, lua::Vector<3>::createMetatable>(
+            L, "__vec3"
+        );
+        lua::newusertype<lua::Matrix4, lua::Matrix4::createMetatable>(
+            L, "__mat4"
+        );
+    }
+
+    void TearDown() override {
+        lua_close(L);
+    }
+
+    /// @brief Run Lua chunk
+    /// @return error message or empty string
+    std::string run(const std::string& code) {
+        if (luaL_loadstring(L, code.c_str()) || lua_pcall(L, 0, 0, 0)) {
+            std::string message = lua::tostring(L, -1);
+            lua::pop(L);
+            return message;
+        }
+        return "";
+    }
+};
+
+TEST_F(LuaCustomTypesTest, BytearrayBounds) {
+    EXPECT_EQ(run(R"(
+        local bytes = bytearray({1, 2, 3})
+        assert(#bytes == 3)
+        assert(bytes[1] == 1 and bytes[3] == 3)
+        assert(bytes[0] == nil)
+        assert(bytes[#bytes + 1] == nil)
+        assert(bytes[-1] == nil)
+
+        local empty = bytearray(0)
+        assert(empty[1] == nil)
+
+        -- assigning next to the end appends
+        bytes[#bytes + 1] = 4
+        assert(#bytes == 4 and bytes[4] == 4)
+        bytes[#bytes + 2] = 6
+        assert(#bytes == 4)
+    )"), "");
+}
+
+TEST_F(LuaCustomTypesTest, BytearrayRemoveInsert) {
+    EXPECT_EQ(run(R"(
+        local bytes = bytearray({1, 2, 3})
+        -- out of range indices are ignored
+        bytes:remove(#bytes + 1)
+        bytes:remove(0)
+        assert(#bytes == 3)
+        bytes:remove(#bytes)
+        assert(#bytes == 2 and bytes[2] == 2 and bytes[3] == nil)
+        bytes:remove(1)
+        assert(#bytes == 1 and bytes[1] == 2)
+
+        bytes:insert(#bytes + 1, 3)
+        bytes:insert(1, 1)
+        bytes:insert(#bytes + 2, 5)
+        assert(tostring(bytes) == "bytearray[3]{1 2 3}")
+    )"), "");
+}
+
+TEST_F(LuaCustomTypesTest, ForeignUserdata) {
+    static int lightValue = 0;
+    ASSERT_EQ(run(R"(
+        proxy = newproxy(true)
+        stolen = newproxy(true)
+        -- metatable copy of a usertype
+        for k, v in pairs(__vec3) do
+            getmetatable(stolen)[k] = v
+        end
+        bytes = bytearray(16)
+    )"), "");
+    lua_pushlightuserdata(L, &lightValue);
+    lua::setglobal(L, "light");
+
+    for (auto name : {"proxy", "stolen", "bytes", "light"}) {
+        lua::requireglobal(L, name);
+        EXPECT_EQ(lua::touserdata<lua::Vector<3>>(L, -1), nullptr) << name;
+        EXPECT_EQ(lua::touserdata<lua::Matrix4>(L, -1), nullptr) << name;
+        EXPECT_THROW(lua::tovec<3>(L, -1), std::runtime_error) << name;
+        EXPECT_THROW(lua::tomat4(L, -1), std::runtime_error) << name;
+        lua::pop(L, lua::gettop(L));
+    }
+    for (auto name : {"proxy", "stolen", "light"}) {
+        lua::requireglobal(L, name);
+        EXPECT_EQ(lua::touserdata<lua::Userdata>(L, -1), nullptr) << name;
+        lua::pop(L);
+    }
+    lua::requireglobal(L, "bytes");
+    EXPECT_NE(lua::touserdata<lua::Bytearray>(L, -1), nullptr);
+    EXPECT_NE(lua::touserdata<lua::Userdata>(L, -1), nullptr);
+    lua::pop(L);
+
+    lua::newuserdata<lua::Vector<3>>(L, glm::vec3(1, 2, 3));
+    auto vector = lua::touserdata<lua::Vector<3>>(L, -1);
+    ASSERT_NE(vector, nullptr);
+    EXPECT_EQ(vector->data(), glm::vec3(1, 2, 3));
+    EXPECT_EQ(lua::touserdata<lua::Matrix4>(L, -1), nullptr);
+    lua::setglobal(L, "vector");
+
+    // metamethods called with foreign userdata
+    EXPECT_EQ(run(R"(
+        local meta = getmetatable(vector)
+        assert(meta.__index(vector, 2) == 2)
+        assert(meta.__index(proxy, 1) == nil)
+        assert(meta.__index(stolen, 1) == nil)
+        assert(meta.__index(bytes, 1) == nil)
+        assert(meta.__index(light, 1) == nil)
+        assert(stolen[1] == nil)
+        meta.__gc(proxy)
+        meta.__gc(light)
+    )"), "");
+}
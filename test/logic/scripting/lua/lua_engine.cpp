@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include "files/files.hpp"
+#include "logic/scripting/lua/lua_engine.hpp"
+
+class LuaEventsTest : public ::testing::Test {
+protected:
+    lua::State* L = nullptr;
+    int handlers = 0;
+    int nameCalls = 0;
+
+    void SetUp() override {
+        L = luaL_newstate();
+        ASSERT_NE(L, nullptr);
+        lua::pop(L, luaopen_base(L));
+        lua::pop(L, luaopen_table(L));
+        lua::pop(L, luaopen_string(L));
+        lua::createtable(L, 0, 0);
+        lua::setglobal(L, "pack");
+        ASSERT_EQ(run(files::read_string(RES_FOLDER "/scripts/events.lua")), "");
+
+        // registered by the block script as done by load_block_script
+        ASSERT_EQ(run(R"(
+            calls = {}
+            events.on("base:dirt.placed", function(x)
+                table.insert(calls, "script " .. x)
+                return true
+            end)
+        )"), "");
+        lua::requireglobal(L, "events");
+        lua::getfield(L, "handlers");
+        lua::getfield(L, "base:dirt.placed");
+        handlers = lua::ref(L);
+        lua::pop(L, 2);
+    }
+
+    void TearDown() override {
+        lua::unref(L, handlers);
+        lua_close(L);
+    }
+
+    /// @brief Run Lua chunk
+    /// @return error message or empty string
+    std::string run(const std::string& code) {
+        if (luaL_loadstring(L, code.c_str()) || lua_pcall(L, 0, 0, 0)) {
+            std::string message = lua::tostring(L, -1);
+            lua::pop(L);
+            return message;
+        }
+        return "";
+    }
+
+    bool emit(int x) {
+        return lua::emit_event(
+            L,
+            handlers,
+            [this]() {
+                nameCalls++;
+                return std::string("base:dirt.placed");
+            },
+            [x](lua::State* L) { return lua::pushinteger(L, x); }
+        );
+    }
+
+    /// @return calls made by handlers separated with comma
+    std::string calls() {
+        lua_settop(L, 0);
+        lua::requireglobal(L, "calls");
+        std::string result;
+        for (size_t i = 1; i <= lua::objlen(L, -1); i++) {
+            lua::rawgeti(L, i);
+            if (i > 1) {
+                result += ",";
+            }
+            result += lua::require_string(L, -1);
+            lua::pop(L);
+        }
+        lua::pop(L);
+        EXPECT_EQ(run("calls = {}"), "");
+        return result;
+    }
+};
+
+TEST_F(LuaEventsTest, OnlyHandlerIsCalledDirectly) {
+    EXPECT_TRUE(emit(1));
+    EXPECT_TRUE(emit(2));
+    EXPECT_EQ(calls(), "script 1,script 2");
+    EXPECT_EQ(nameCalls, 0);
+    EXPECT_EQ(lua::gettop(L), 0);
+}
+
+TEST_F(LuaEventsTest, HandlerReplacedByEventsOn) {
+    ASSERT_EQ(run(R"(
+        events.on("base:dirt.placed", function(x)
+            table.insert(calls, "pack " .. x)
+        end)
+    )"), "");
+    EXPECT_FALSE(emit(1));
+    EXPECT_EQ(calls(), "pack 1");
+}
+
+TEST_F(LuaEventsTest, SeveralHandlersEmitted) {
+    ASSERT_EQ(run(R"(
+        table.insert(events.handlers["base:dirt.placed"], function(x)
+            table.insert(calls, "added " .. x)
+        end)
+        events.handlers["base:dirt.placed"][1] = function(x)
+            table.insert(calls, "first " .. x)
+        end
+    )"), "");
+    EXPECT_FALSE(emit(3));
+    EXPECT_EQ(calls(), "first 3,added 3");
+    EXPECT_EQ(nameCalls, 1);
+    EXPECT_EQ(lua::gettop(L), 0);
+}
+
+TEST_F(LuaEventsTest, RemovedOnPackUnload) {
+    ASSERT_EQ(run(R"(pack.unload("base:"))"), "");
+    EXPECT_FALSE(emit(1));
+    EXPECT_EQ(calls(), "");
+
+    ASSERT_EQ(run(R"(
+        events.on("base:dirt.placed", function(x)
+            table.insert(calls, "reloaded " .. x)
+            return true
+        end)
+    )"), "");
+    EXPECT_TRUE(emit(2));
+    EXPECT_EQ(calls(), "reloaded 2");
+}
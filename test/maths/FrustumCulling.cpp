@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "maths/FrustumCulling.hpp"
+
+// Camera at the origin looking along -Z: |x| <= -z, |y| <= -z, z in [-100, -1]
+static Frustum create_frustum() {
+    glm::mat4 projection =
+        glm::perspective(glm::radians(90.0f), 1.0f, 1.0f, 100.0f);
+    glm::mat4 view = glm::lookAt(
+        glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0, 1, 0)
+    );
+    Frustum frustum;
+    frustum.update(projection * view);
+    return frustum;
+}
+
+// Classification of the box vertices by the clip space planes.
+// Vertices lying at a plane within rounding error make the box ambiguous
+static Frustum::Location locate_vertices(
+    const glm::mat4& projview,
+    const glm::vec3& minp,
+    const glm::vec3& maxp,
+    bool& ambiguous
+) {
+    ambiguous = false;
+    int insideVertices = 0;
+    for (int plane = 0; plane < 6; plane++) {
+        int behind = 0;
+        for (int i = 0; i < 8; i++) {
+            glm::vec3 vertex(
+                i & 1 ? maxp.x : minp.x,
+                i & 2 ? maxp.y : minp.y,
+                i & 4 ? maxp.z : minp.z
+            );
+            glm::vec4 clip = projview * glm::vec4(vertex, 1.0f);
+            float coord = clip[plane / 2] * (plane % 2 ? -1.0f : 1.0f);
+            if (std::abs(clip.w + coord) <= std::abs(clip.w) * 1e-5f) {
+                ambiguous = true;
+            }
+            if (clip.w + coord < 0.0f) {
+                behind++;
+            }
+        }
+        if (behind == 8) {
+            return Frustum::Location::outside;
+        }
+        insideVertices += 8 - behind;
+    }
+    return insideVertices == 6 * 8 ? Frustum::Location::inside
+                                   : Frustum::Location::intersects;
+}
+
+TEST(Frustum, LocateBox) {
+    auto frustum = create_frustum();
+    using Location = Frustum::Location;
+
+    auto locate = [&frustum](glm::vec3 minp, glm::vec3 maxp) {
+        return frustum.locateBox(minp, maxp);
+    };
+    EXPECT_EQ(locate({-1, -1, -10}, {1, 1, -5}), Location::inside);
+    EXPECT_EQ(locate({-40, -40, -90}, {40, 40, -50}), Location::inside);
+
+    // behind the camera, beside, above and beyond the far plane
+    EXPECT_EQ(locate({-1, -1, 1}, {1, 1, 3}), Location::outside);
+    EXPECT_EQ(locate({20, -1, -10}, {22, 1, -5}), Location::outside);
+    EXPECT_EQ(locate({-1, 60, -50}, {1, 70, -40}), Location::outside);
+    EXPECT_EQ(locate({-1, -1, -150}, {1, 1, -120}), Location::outside);
+
+    // crossing the near, a side and the far plane
+    EXPECT_EQ(
+        locate({-0.5f, -0.5f, -2}, {0.5f, 0.5f, 0}), Location::intersects
+    );
+    EXPECT_EQ(locate({-1, -1, -10}, {15, 1, -5}), Location::intersects);
+    EXPECT_EQ(locate({-1, -1, -120}, {1, 1, -90}), Location::intersects);
+    // frustum inside of the box
+    EXPECT_EQ(locate(glm::vec3(-200), glm::vec3(200)), Location::intersects);
+}
+
+TEST(Frustum, LocateBoxMatchesVertices) {
+    glm::mat4 projview =
+        glm::perspective(glm::radians(70.0f), 1.6f, 0.05f, 300.0f) *
+        glm::lookAt(
+            glm::vec3(3, 70, -5), glm::vec3(40, 50, 60), glm::vec3(0, 1, 0)
+        );
+    Frustum frustum;
+    frustum.update(projview);
+
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> position(-400.0f, 400.0f);
+    std::uniform_real_distribution<float> extent(0.5f, 64.0f);
+    for (int i = 0; i < 10000; i++) {
+        glm::vec3 minp(position(random), position(random), position(random));
+        glm::vec3 maxp =
+            minp + glm::vec3(extent(random), extent(random), extent(random));
+
+        auto location = frustum.locateBox(minp, maxp);
+        bool ambiguous;
+        auto expected = locate_vertices(projview, minp, maxp, ambiguous);
+        // exact per plane, conservative only near the frustum edges
+        if (!ambiguous) {
+            EXPECT_EQ(location, expected);
+        }
+        if (location == Frustum::Location::outside) {
+            EXPECT_FALSE(frustum.isBoxVisible(minp, maxp));
+        }
+    }
+}
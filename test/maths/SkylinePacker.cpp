@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+
+#include "maths/SkylinePacker.hpp"
+
+static bool overlaps(const rectangle& a, const rectangle& b, int margin) {
+    return a.x - margin < b.x + b.width + margin &&
+           b.x - margin < a.x + a.width + margin &&
+           a.y - margin < b.y + b.height + margin &&
+           b.y - margin < a.y + a.height + margin;
+}
+
+TEST(SkylinePacker, PlacesWithoutOverlaps) {
+    const int extension = 2;
+    std::vector<uint32_t> sizes;
+    for (uint32_t i = 0; i < 300; i++) {
+        sizes.push_back(4 + (i * 37) % 60);
+        sizes.push_back(4 + (i * 53) % 44);
+    }
+    SkylinePacker packer(sizes.data(), sizes.size());
+    uint32_t width = packer.estimateWidth(extension);
+    EXPECT_EQ(width & (width - 1), 0);
+    ASSERT_TRUE(packer.build(width, 4096, extension));
+
+    auto rects = packer.getResult();
+    ASSERT_EQ(rects.size(), sizes.size() / 2);
+    uint64_t area = 0;
+    for (size_t i = 0; i < rects.size(); i++) {
+        const auto& rect = rects[i];
+        EXPECT_EQ(rect.width, sizes[rect.idx * 2]);
+        EXPECT_EQ(rect.height, sizes[rect.idx * 2 + 1]);
+        EXPECT_GE(rect.x, extension);
+        EXPECT_GE(rect.y, extension);
+        EXPECT_LE(rect.x + rect.width + extension, width);
+        EXPECT_LE(rect.y + rect.height + extension, packer.getHeight());
+        for (size_t j = i + 1; j < rects.size(); j++) {
+            EXPECT_FALSE(overlaps(rect, rects[j], extension));
+        }
+        area += (rect.width + extension * 2) * (rect.height + extension * 2);
+    }
+    EXPECT_GE(static_cast<uint64_t>(width) * packer.getHeight(), area);
+}
+
+TEST(SkylinePacker, HeightLimit) {
+    uint32_t sizes[] {64, 64, 64, 64, 64, 64};
+    SkylinePacker packer(sizes, 6);
+    EXPECT_FALSE(packer.build(128, 64, 0));
+    EXPECT_FALSE(packer.build(64, 128, 0));
+    EXPECT_TRUE(packer.build(128, 128, 0));
+    EXPECT_EQ(packer.getHeight(), 128);
+    EXPECT_TRUE(packer.build(192, 64, 0));
+    EXPECT_EQ(packer.getHeight(), 64);
+}
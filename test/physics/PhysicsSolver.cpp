@@ -0,0 +1,281 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "physics/Hitbox.hpp"
+#include "physics/PhysicsSolver.hpp"
+#include "voxels/Block.hpp"
+
+static const glm::vec3 GRAVITY(0.0f, -22.6f, 0.0f);
+static const glm::vec3 HALFSIZE(0.3f, 0.9f, 0.3f);
+// Collision epsilon the hitbox is kept from colliders at
+static const float E = 0.03f;
+static const float STEP_HEIGHT = 0.5f;
+// Face probes sampling step
+static const float PROBE_STEP = 2.0f / BLOCK_AABB_GRID;
+// Hitbox center y standing on the floor
+static const float GROUND_Y = 1.0f + HALFSIZE.y + E;
+
+// Floor top at y = 1 for x, z in [-8, 8)
+static std::vector<AABB> create_floor() {
+    std::vector<AABB> colliders;
+    for (int z = -8; z < 8; z++) {
+        for (int x = -8; x < 8; x++) {
+            colliders.emplace_back(
+                glm::vec3(x, 0, z), glm::vec3(x + 1, 1, z + 1)
+            );
+        }
+    }
+    return colliders;
+}
+
+// Wall of full blocks at x in [bx, bx + 1) standing on the floor
+static void add_wall_x(std::vector<AABB>& colliders, int bx, int height) {
+    for (int y = 1; y <= height; y++) {
+        for (int z = -8; z < 8; z++) {
+            colliders.emplace_back(
+                glm::vec3(bx, y, z), glm::vec3(bx + 1, y + 1, z + 1)
+            );
+        }
+    }
+}
+
+static void add_wall_z(std::vector<AABB>& colliders, int bz, int height) {
+    for (int y = 1; y <= height; y++) {
+        for (int x = -8; x < 8; x++) {
+            colliders.emplace_back(
+                glm::vec3(x, y, bz), glm::vec3(x + 1, y + 1, bz + 1)
+            );
+        }
+    }
+}
+
+// Colliders indexed over their bounds
+static CollidersCache create_cache(const std::vector<AABB>& colliders) {
+    CollidersCache cache;
+    cache.boxes = colliders;
+    cache.min = glm::vec3(std::numeric_limits<float>::max());
+    cache.max = glm::vec3(std::numeric_limits<float>::lowest());
+    for (const auto& box : colliders) {
+        cache.min = glm::min(cache.min, glm::floor(box.a));
+        cache.max = glm::max(cache.max, glm::ceil(box.b));
+    }
+    cache.index();
+    return cache;
+}
+
+// Substeps loop of PhysicsSolver::step with fixed colliders.
+// Horizontal velocity is set every substep as by a walking player
+static void simulate(
+    const std::vector<AABB>& colliders,
+    Hitbox& hitbox,
+    glm::vec2 walk,
+    float seconds
+) {
+    PhysicsSolver solver(GRAVITY);
+    auto cache = create_cache(colliders);
+    const float dt = 1.0f / 240.0f;
+    glm::vec3& pos = hitbox.position;
+    glm::vec3& vel = hitbox.velocity;
+    for (float time = 0.0f; time < seconds; time += dt) {
+        bool prevGrounded = hitbox.grounded;
+        hitbox.grounded = false;
+        float py = pos.y;
+        if (walk.x != 0.0f || walk.y != 0.0f) {
+            vel.x = walk.x;
+            vel.z = walk.y;
+        }
+        vel += GRAVITY * dt;
+        solver.colisionCalc(
+            cache, &hitbox, vel, pos, hitbox.halfsize,
+            prevGrounded ? STEP_HEIGHT : 0.0f
+        );
+        pos += vel * dt + GRAVITY * dt * dt * 0.5f;
+        if (hitbox.grounded && pos.y < py) {
+            pos.y = py;
+        }
+    }
+}
+
+static Hitbox create_hitbox(glm::vec3 position) {
+    return Hitbox(BodyType::DYNAMIC, position, HALFSIZE);
+}
+
+TEST(PhysicsSolver, LandOnFloor) {
+    auto colliders = create_floor();
+    auto hitbox = create_hitbox({0.5f, 4.0f, 0.5f});
+    simulate(colliders, hitbox, {}, 2.0f);
+
+    EXPECT_TRUE(hitbox.grounded);
+    EXPECT_EQ(hitbox.velocity.y, 0.0f);
+    EXPECT_NEAR(hitbox.position.y, GROUND_Y, 1e-3f);
+    EXPECT_FLOAT_EQ(hitbox.position.x, 0.5f);
+    EXPECT_FLOAT_EQ(hitbox.position.z, 0.5f);
+}
+
+TEST(PhysicsSolver, HitCeiling) {
+    auto colliders = create_floor();
+    // ceiling bottom at y = 4
+    for (int z = -2; z < 2; z++) {
+        for (int x = -2; x < 2; x++) {
+            colliders.emplace_back(
+                glm::vec3(x, 4, z), glm::vec3(x + 1, 5, z + 1)
+            );
+        }
+    }
+    auto hitbox = create_hitbox({0.5f, GROUND_Y, 0.5f});
+    hitbox.grounded = true;
+    hitbox.velocity.y = 12.0f;
+    // would rise above 5 without the ceiling
+    simulate(colliders, hitbox, {}, 0.25f);
+
+    EXPECT_LE(hitbox.position.y + HALFSIZE.y, 4.0f);
+    EXPECT_LE(hitbox.velocity.y, 0.0f);
+    simulate(colliders, hitbox, {}, 1.0f);
+    EXPECT_TRUE(hitbox.grounded);
+    EXPECT_NEAR(hitbox.position.y, GROUND_Y, 1e-3f);
+}
+
+TEST(PhysicsSolver, SlideAlongWall) {
+    auto colliders = create_floor();
+    add_wall_x(colliders, 2, 2);
+    auto hitbox = create_hitbox({0.5f, GROUND_Y, -4.0f});
+    hitbox.grounded = true;
+    simulate(colliders, hitbox, {4.0f, 4.0f}, 1.0f);
+
+    // stopped by the wall, moved along it
+    EXPECT_NEAR(hitbox.position.x, 2.0f - HALFSIZE.x - E, 1e-4f);
+    EXPECT_NEAR(hitbox.position.z, 0.0f, 0.1f);
+    EXPECT_NEAR(hitbox.position.y, GROUND_Y, 1e-3f);
+    EXPECT_TRUE(hitbox.grounded);
+
+    // the same on the negative side. Probe at the wall max is outside of
+    // the wall, so the hitbox may be one substep movement away from it
+    hitbox = create_hitbox({4.5f, GROUND_Y, 4.0f});
+    hitbox.grounded = true;
+    simulate(colliders, hitbox, {-4.0f, -4.0f}, 1.0f);
+    EXPECT_NEAR(hitbox.position.x, 3.0f + HALFSIZE.x + E, 0.02f);
+    EXPECT_NEAR(hitbox.position.z, 0.0f, 0.1f);
+}
+
+TEST(PhysicsSolver, StepUp) {
+    auto colliders = create_floor();
+    // slab half a block high
+    for (int z = -8; z < 8; z++) {
+        colliders.emplace_back(
+            glm::vec3(2, 1, z), glm::vec3(3, 1.5f, z + 1)
+        );
+    }
+    auto hitbox = create_hitbox({0.5f, GROUND_Y, 0.5f});
+    hitbox.grounded = true;
+    simulate(colliders, hitbox, {2.0f, 0.0f}, 1.0f);
+
+    EXPECT_GT(hitbox.position.x, 2.0f);
+    EXPECT_NEAR(hitbox.position.y, GROUND_Y + 0.5f, 1e-3f);
+    EXPECT_TRUE(hitbox.grounded);
+
+    // full block is not stepped up
+    colliders = create_floor();
+    add_wall_x(colliders, 2, 1);
+    hitbox = create_hitbox({0.5f, GROUND_Y, 0.5f});
+    hitbox.grounded = true;
+    simulate(colliders, hitbox, {2.0f, 0.0f}, 1.0f);
+    EXPECT_NEAR(hitbox.position.x, 2.0f - HALFSIZE.x - E, 1e-4f);
+    EXPECT_NEAR(hitbox.position.y, GROUND_Y, 1e-3f);
+}
+
+TEST(PhysicsSolver, InnerCorner) {
+    auto colliders = create_floor();
+    add_wall_x(colliders, 2, 2);
+    add_wall_z(colliders, 2, 2);
+    auto hitbox = create_hitbox({-1.5f, GROUND_Y, -1.5f});
+    hitbox.grounded = true;
+    simulate(colliders, hitbox, {3.0f, 4.0f}, 2.0f);
+
+    EXPECT_NEAR(hitbox.position.x, 2.0f - HALFSIZE.x - E, 1e-4f);
+    EXPECT_NEAR(hitbox.position.z, 2.0f - HALFSIZE.z - E, 1e-4f);
+    EXPECT_NEAR(hitbox.position.y, GROUND_Y, 1e-3f);
+}
+
+TEST(PhysicsSolver, OuterCorner) {
+    auto colliders = create_floor();
+    // single pillar at [2, 3) x [2, 3)
+    for (int y = 1; y <= 2; y++) {
+        colliders.emplace_back(glm::vec3(2, y, 2), glm::vec3(3, y + 1, 3));
+    }
+    // passes by the pillar side touching its corner
+    auto hitbox = create_hitbox({2.0f - HALFSIZE.x, GROUND_Y, -2.0f});
+    hitbox.grounded = true;
+    simulate(colliders, hitbox, {0.0f, 4.0f}, 2.0f);
+    EXPECT_NEAR(hitbox.position.x, 2.0f - HALFSIZE.x, 1e-4f);
+    EXPECT_GT(hitbox.position.z, 4.0f);
+
+    // walks into the pillar corner diagonally and stops at it. Faces are
+    // probed by samples, so the corner may overlap by less than a step
+    hitbox = create_hitbox({0.5f, GROUND_Y, 0.5f});
+    hitbox.grounded = true;
+    simulate(colliders, hitbox, {3.0f, 3.0f}, 1.0f);
+    auto stopped = hitbox.position;
+    simulate(colliders, hitbox, {3.0f, 3.0f}, 1.0f);
+    EXPECT_EQ(hitbox.position, stopped);
+    EXPECT_LT(hitbox.position.x + HALFSIZE.x - 2.0f, PROBE_STEP);
+    EXPECT_LT(hitbox.position.z + HALFSIZE.z - 2.0f, PROBE_STEP);
+}
+
+TEST(PhysicsSolver, CollidersCacheFind) {
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> voxel(-6, 5);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    std::vector<AABB> colliders;
+    for (int i = 0; i < 300; i++) {
+        glm::vec3 origin(voxel(random), voxel(random), voxel(random));
+        glm::vec3 a(unit(random), unit(random), unit(random));
+        glm::vec3 b(unit(random), unit(random), unit(random));
+        // some of boxes go out of their voxels
+        float scale = i % 10 == 0 ? 2.5f : 1.0f;
+        colliders.emplace_back(
+            origin + glm::min(a, b), origin + glm::max(a, b) * scale
+        );
+    }
+    // whole voxels boxes bounds are probed exactly
+    colliders.emplace_back(glm::vec3(1, 1, 1), glm::vec3(2, 2, 2));
+    auto cache = create_cache(colliders);
+
+    std::uniform_real_distribution<float> coord(-6.0f, 6.0f);
+    std::uniform_real_distribution<float> extent(0.0f, 1.5f);
+    for (int i = 0; i < 20000; i++) {
+        glm::vec3 min(coord(random), coord(random), coord(random));
+        glm::vec3 max =
+            min + glm::vec3(extent(random), extent(random), extent(random));
+        if (i % 4 == 0) {
+            min = glm::floor(min);
+            max = glm::floor(max);
+        }
+        int axis = i % 3;
+        bool negative = i % 2 == 0;
+
+        const AABB* expected = nullptr;
+        for (const auto& box : colliders) {
+            if (box.a.x > max.x || box.b.x <= min.x ||
+                box.a.y > max.y || box.b.y <= min.y ||
+                box.a.z > max.z || box.b.z <= min.z) {
+                continue;
+            }
+            if (expected == nullptr ||
+                (negative ? box.b[axis] > expected->b[axis]
+                          : box.a[axis] < expected->a[axis])) {
+                expected = &box;
+            }
+        }
+        const AABB* found = cache.find(min, max, axis, negative);
+        ASSERT_EQ(found == nullptr, expected == nullptr) << i;
+        if (found && negative) {
+            // boxes with equal bounds may be selected in any order
+            EXPECT_EQ(found->b[axis], expected->b[axis]) << i;
+        } else if (found) {
+            EXPECT_EQ(found->a[axis], expected->a[axis]) << i;
+        }
+    }
+}
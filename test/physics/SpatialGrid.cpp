@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "physics/SpatialGrid.hpp"
+
+static std::set<int> query_all(const SpatialGrid<int>& grid, const AABB& box) {
+    std::set<int> found;
+    grid.query(box, [&](int object) {
+        EXPECT_TRUE(found.insert(object).second) << "reported twice";
+        return false;
+    });
+    return found;
+}
+
+TEST(SpatialGrid, QueryUpdateRemove) {
+    SpatialGrid<int> grid(16.0f);
+    grid.update(1, AABB(glm::vec3(1, 0, 1), glm::vec3(2, 2, 2)));
+    // overlaps four cells
+    grid.update(2, AABB(glm::vec3(15, 0, 15), glm::vec3(17, 2, 17)));
+    grid.update(3, AABB(glm::vec3(-40, 0, -40), glm::vec3(-39, 2, -39)));
+    EXPECT_EQ(grid.size(), 3);
+
+    auto found = query_all(grid, AABB(glm::vec3(0), glm::vec3(32)));
+    EXPECT_EQ(found, (std::set<int> {1, 2}));
+
+    found = query_all(grid, AABB(glm::vec3(20, 0, 20), glm::vec3(21)));
+    EXPECT_EQ(found, (std::set<int> {2}));
+
+    // infinite height and huge area
+    found = query_all(
+        grid, AABB(glm::vec3(-1e6f, -INFINITY, -1e6f), glm::vec3(1e6f, INFINITY, 1e6f))
+    );
+    EXPECT_EQ(found, (std::set<int> {1, 2, 3}));
+
+    grid.update(3, AABB(glm::vec3(5, 0, 5), glm::vec3(6, 2, 6)));
+    found = query_all(grid, AABB(glm::vec3(0), glm::vec3(8)));
+    EXPECT_EQ(found, (std::set<int> {1, 3}));
+
+    grid.remove(1);
+    found = query_all(grid, AABB(glm::vec3(0), glm::vec3(8)));
+    EXPECT_EQ(found, (std::set<int> {3}));
+    EXPECT_EQ(grid.size(), 2);
+}
+
+TEST(SpatialGrid, StopQuery) {
+    SpatialGrid<int> grid(16.0f);
+    for (int i = 0; i < 100; i++) {
+        grid.update(i, AABB(glm::vec3(i), glm::vec3(i + 1)));
+    }
+    int visited = 0;
+    bool stopped = grid.query(AABB(glm::vec3(0), glm::vec3(100)), [&](int) {
+        return ++visited == 10;
+    });
+    EXPECT_TRUE(stopped);
+    EXPECT_EQ(visited, 10);
+}
@@ -0,0 +1,113 @@
+#include "util/ParallelWorkers.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+
+TEST(ParallelWorkers, VisitsAllIndicesOnce) {
+    for (uint workers : {1, 3, 7}) {
+        util::ParallelWorkers pool(workers);
+        EXPECT_EQ(pool.getPartitionsCount(), workers + 1);
+        // less, equal and more indices than partitions
+        for (size_t count : {2, 3, 8, 1000, 12345}) {
+            auto visits = std::make_unique<std::atomic<int>[]>(count);
+            for (size_t i = 0; i < count; i++) {
+                visits[i] = 0;
+            }
+            std::atomic<uint> partitions = 0;
+            pool.run(count, [&](size_t begin, size_t end, uint partition) {
+                EXPECT_LE(begin, end);
+                EXPECT_LE(end, count);
+                EXPECT_LT(partition, pool.getPartitionsCount());
+                partitions++;
+                for (size_t i = begin; i < end; i++) {
+                    visits[i]++;
+                }
+            });
+            EXPECT_EQ(partitions, pool.getPartitionsCount());
+            for (size_t i = 0; i < count; i++) {
+                EXPECT_EQ(visits[i], 1) << "index " << i << " of " << count;
+            }
+        }
+    }
+}
+
+TEST(ParallelWorkers, ReusedForManyRuns) {
+    util::ParallelWorkers pool(3);
+    for (int run = 0; run < 1000; run++) {
+        std::atomic<size_t> sum = 0;
+        pool.run(100, [&](size_t begin, size_t end, uint) {
+            for (size_t i = begin; i < end; i++) {
+                sum += i;
+            }
+        });
+        ASSERT_EQ(sum, 99 * 100 / 2);
+    }
+}
+
+TEST(ParallelWorkers, RethrowsFirstException) {
+    util::ParallelWorkers pool(3);
+    // thrown by a worker thread
+    EXPECT_THROW(
+        pool.run(100, [](size_t begin, size_t end, uint) {
+            if (begin <= 50 && 50 < end) {
+                throw std::runtime_error("50");
+            }
+        }),
+        std::runtime_error
+    );
+    // by the calling thread
+    EXPECT_THROW(
+        pool.run(100, [](size_t, size_t, uint partition) {
+            if (partition == 0) {
+                throw std::invalid_argument("0");
+            }
+        }),
+        std::invalid_argument
+    );
+    // by all partitions, only one of them is rethrown
+    std::atomic<int> thrown = 0;
+    try {
+        pool.run(100, [&](size_t, size_t, uint partition) {
+            thrown++;
+            throw std::runtime_error(std::to_string(partition));
+        });
+        FAIL() << "exception expected";
+    } catch (const std::runtime_error& err) {
+        int partition = std::stoi(err.what());
+        EXPECT_GE(partition, 0);
+        EXPECT_LT(partition, 4);
+    }
+    // all partitions finished before rethrowing
+    EXPECT_EQ(thrown, 4);
+
+    // error is not kept for the next run
+    std::atomic<size_t> visited = 0;
+    pool.run(100, [&](size_t begin, size_t end, uint) {
+        visited += end - begin;
+    });
+    EXPECT_EQ(visited, 100);
+}
+
+TEST(ParallelWorkers, EmptyAndSingleItem) {
+    util::ParallelWorkers pool(3);
+    for (size_t count : {0, 1}) {
+        int calls = 0;
+        pool.run(count, [&](size_t begin, size_t end, uint partition) {
+            // processed by the calling thread
+            calls++;
+            EXPECT_EQ(begin, 0);
+            EXPECT_EQ(end, count);
+            EXPECT_EQ(partition, 0);
+        });
+        EXPECT_EQ(calls, 1);
+    }
+    EXPECT_THROW(
+        pool.run(1, [](size_t, size_t, uint) {
+            throw std::runtime_error("single");
+        }),
+        std::runtime_error
+    );
+}